@@ -211,6 +211,24 @@ TArrayBuffer::add (TDataElement * elems)
 
 }
 
+/**
+* WARNING : SYNCHRONIZED
+*/
+void
+TArrayBuffer::addRows (TDataElement * elems, int n)
+{
+  Visualization->lockPainting ();
+  for (int r = 0; r < n; r++)
+    {
+      for (int i = 0; i < colCount; i++)
+	{
+	  buff->add (elems[r * colCount + i]);
+	}
+    }
+  computeStatistics ();
+  Visualization->unlockPainting ();
+}
+
 int
 TArrayBuffer::getCurrentSize ()
 {
@@ -263,4 +281,111 @@ TArrayBuffer::getColCount ()
   return colCount;
 }
 
+//---------------------TRowFeed----------------------------
+
+
+TRowFeed::TRowFeed (TArrayBuffer * aTarget, int aCapacity,
+		    TFeedPolicy aPolicy):
+target (aTarget),
+policy (aPolicy),
+colCount (aTarget->getColCount ()),
+capacity (aCapacity),
+head (0),
+tail (0),
+decimation (1),
+skipped (0),
+offeredCount (0),
+deliveredCount (0)
+{
+  assert (aCapacity > 0);
+  rows = new TDataElement[capacity * colCount];
+  batch = new TDataElement[capacity * colCount];
+}
+
+TRowFeed::~TRowFeed ()
+{
+  delete[]rows;
+  delete[]batch;
+}
+
+void
+TRowFeed::put (const TDataElement * elems)
+{
+  offeredCount++;
+
+  if (policy == fpDecimate)
+    {
+      skipped++;
+      if (skipped < decimation)
+	return;
+      skipped = 0;
+
+      unsigned long fill =
+	head - __atomic_load_n (&tail, __ATOMIC_ACQUIRE);
+
+      if (fill >= capacity)
+	{
+	  decimation *= 2;
+	  return;
+	}
+      if ((fill < capacity / 4) && (decimation > 1))
+	decimation /= 2;
+    }
+
+  TDataElement *row = &rows[(head % capacity) * colCount];
+  for (int i = 0; i < colCount; i++)
+    {
+      row[i] = elems[i];
+    }
+
+  __atomic_store_n (&head, head + 1, __ATOMIC_RELEASE);
+}
+
+int
+TRowFeed::drain ()
+{
+  unsigned long h = __atomic_load_n (&head, __ATOMIC_ACQUIRE);
+  unsigned long t = tail;
+
+  // fpDropOldest: rows overwritten before we came here
+  if (h - t >= capacity)
+    t = h - capacity + 1;
+
+  unsigned long n = h - t;
+  if (n == 0)
+    return 0;
+
+  for (unsigned long r = 0; r < n; r++)
+    {
+      TDataElement *row = &rows[((t + r) % capacity) * colCount];
+      for (int i = 0; i < colCount; i++)
+	{
+	  batch[r * colCount + i] = row[i];
+	}
+    }
+
+  // fpDropOldest: rows overwritten while we were copying
+  unsigned long first = 0;
+  if (policy == fpDropOldest)
+    {
+      __atomic_thread_fence (__ATOMIC_ACQUIRE);
+      unsigned long h2 = __atomic_load_n (&head, __ATOMIC_RELAXED);
+      if (h2 - t >= capacity)
+	{
+	  first = h2 + 1 - capacity - t;
+	  if (first > n)
+	    first = n;
+	}
+    }
 
+  __atomic_store_n (&tail, h, __ATOMIC_RELEASE);
+
+  if (first < n)
+    {
+      target->addRows (&batch[first * colCount], n - first);
+      target->update ();
+      deliveredCount += n - first;
+    }
+
+  return n - first;
+}
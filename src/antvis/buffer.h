@@ -107,6 +107,10 @@ public:
   TDataElement *getNewestRow ();
 
   void add (TDataElement * elems);
+  /**
+   * adds n rows at once, the statistics are computed once per batch.
+   */
+  void addRows (TDataElement * elems, int n);
   int getRowCount ();
   int getColCount ();
   TDataElement *min ();
@@ -117,6 +121,74 @@ public:
 
 
 
+/**
+*   Policies of a TRowFeed for the case that the visualization does
+*   not keep pace with the simulation.
+*/
+enum TFeedPolicy
+{ fpDropOldest, fpDecimate };
+
+/**
+*   Lock-free single-producer/single-consumer ring of data rows between
+*   the simulation (producer) and the visualization (consumer).
+*
+*   put() never blocks. If the ring is full, either the oldest rows are
+*   overwritten (fpDropOldest), or only every n-th row is stored, where
+*   n is doubled each time the ring runs full and halved again when it
+*   has been drained below a quarter (fpDecimate).
+*
+*   drain() moves all available rows as one batch into the target
+*   TArrayBuffer. Overwritten rows are detected by re-reading the
+*   write position after copying (as a seqlock) and are skipped.
+*/
+class TRowFeed:public TObject
+{
+protected:
+  TArrayBuffer * target;
+  TFeedPolicy policy;
+  int colCount;
+  unsigned long capacity;
+  TDataElement *rows;
+  TDataElement *batch;
+
+  /** number of rows written, changed by the producer only */
+  unsigned long head;
+  /** number of rows read, changed by the consumer only */
+  unsigned long tail;
+
+  unsigned long decimation;
+  unsigned long skipped;
+
+  unsigned long offeredCount;
+  unsigned long deliveredCount;
+
+public:
+    TRowFeed (TArrayBuffer * aTarget, int aCapacity, TFeedPolicy aPolicy);
+    virtual ~ TRowFeed ();
+
+  /**
+   * called by the producer only
+   */
+  void put (const TDataElement * elems);
+
+  /**
+   * called by the consumer only
+   * @return number of rows moved into the target buffer
+   */
+  int drain ();
+
+  /** rows given to put() */
+  unsigned long getOfferedCount ()
+  {
+    return offeredCount;
+  }
+  /** rows moved into the target buffer */
+  unsigned long getDeliveredCount ()
+  {
+    return deliveredCount;
+  }
+};
+
 #endif
 
 
@@ -36,6 +36,7 @@
 #include "event.h"
 #include "threads.h"
 #include "text.h"
+#include "buffer.h"
 
 // VA: Sun Sep 21 22:36:56 CEST 2008
 // g++ (SUSE Linux) 4.3.1 20080507 (prerelease) [gcc-4_3-branch revision 135036]
@@ -168,6 +169,11 @@ globalIdleCallback ()
   if (!Visualization->isRunning ())
     return;
 
+  if (Visualization->drainFeed ())
+    {
+      Visualization->postIdleRedisplay ();
+    }
+
   if (Visualization->needRedisplay)
     {
       Visualization->postRedisplay ();
@@ -251,6 +257,7 @@ ANTI_ALIASING_GUI (true)
   guiRunning = 0;
   pauseWait = 0;
   painting = 0;
+  feed = 0;
   VisualizationThread = 0;
   
   this->inWaitForThread = false;
@@ -265,16 +272,34 @@ ANTI_ALIASING_GUI (true)
   out ("created");
 }
 
+// 'painting' does not exist without the visualization thread
 void
 TVisualization::lockPainting ()
 {
-  painting->lock ();
+  if (painting)
+    painting->lock ();
 }
 
 void
 TVisualization::unlockPainting ()
 {
-  painting->unlock ();
+  if (painting)
+    painting->unlock ();
+}
+
+void
+TVisualization::setFeed (TRowFeed * aFeed)
+{
+  feed = aFeed;
+}
+
+bool
+TVisualization::drainFeed ()
+{
+  if (feed == 0)
+    return false;
+
+  return (feed->drain () > 0);
 }
 
 void
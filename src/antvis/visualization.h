@@ -55,6 +55,7 @@ void localGUICallback (int param);
     to need this 'correct' forward declaration additionally. 
 */
 class TVisualizationThread;
+class TRowFeed;
 
 /**
  * A static class which manages all open windows and handles the interface to
@@ -83,6 +84,8 @@ private:
  
   bool inWaitForThread;
   
+  TRowFeed *feed;
+  
   int pause_ms;
   int data_rows_per_step;
   int data_rows_added;
@@ -168,6 +171,19 @@ public:
   bool isRunning ();
 
 
+  /**
+   * Sets the feed, which is drained into its buffer whenever the
+   * visualization is idle. Data is then added without synchronization
+   * with the simulation (see waitForVisualization()).
+   */
+  void setFeed (TRowFeed * aFeed);
+
+  /**
+   * Moves the rows of the feed into its buffer.
+   * Returns true if there were new rows.
+   */
+  bool drainFeed ();
+
   void lockPainting ();
 
   void unlockPainting ();
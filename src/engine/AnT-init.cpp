@@ -39,6 +39,8 @@
 #endif /* ANT_HAS_WIN_ENV */
 
 #include <fstream>
+#include <cstdlib> /*: 'getenv' */
+#include <unistd.h> /*: 'access' */
 
 
 /** forward class declaration: */
@@ -60,6 +62,22 @@ void createParseTreesForAnTClient (ANPClient* aClient);
 extern
 void destroyANPClient (ANPClient* aClient /*: new allocated */);
 
+/** forward class declaration: */
+class ANPRelay;
+
+extern
+ANPRelay* /*: new allocated */
+createANPRelay ( const char* serverAddrOrName,
+		 long port,
+		 long relayPort,
+		 long numUpstreamScanPoints );
+
+extern
+void runANPRelay (ANPRelay* aRelay);
+
+extern
+void destroyANPRelay (ANPRelay* aRelay /*: new allocated */);
+
 #include "methods/output/IOStreamFactory.hpp"
 
 #include "methods/output/NetIOStreamFactory.hpp"
@@ -78,6 +96,8 @@ void destroyANPClient (ANPClient* aClient /*: new allocated */);
 IOStreamFactory *ioStreamFactory = NULL;
 // extern
 ANPClient *anpClient = NULL;
+// extern
+ANPRelay *anpRelay = NULL;
 
 /* this function pointer gets initialized when loading the system */
 // extern
@@ -141,6 +161,27 @@ AnT::getGlobalKeysCfgFullPathName ()
 }
 
 
+// static
+string
+AnT::getGlobalKeysCacheFullPathName ()
+{
+  /* the parsed specification file is cached next to it, or in the
+     home directory, if the installation is not writable: */
+  string result = get__ANT_TOPDIR () + "/share/AnT";
+
+  if (access (result.c_str (), W_OK) == 0) {
+    return result + "/GlobalKeys.cfg.cache";
+  }
+
+  const char* home = getenv ("HOME");
+  if (home != NULL) {
+    return string (home) + "/.AnT-GlobalKeys.cfg.cache";
+  }
+
+  return ""; /*: no cache */
+}
+
+
 // static
 map<string, unsigned int>&
 AnT::stateVariableNames ()
@@ -190,6 +231,15 @@ AnT::parsedEquationsOfMotion ()
   return result;
 }
 
+// static
+MathEvalOptimizer&
+AnT::equationsOfMotionOptimizer ()
+{
+  static MathEvalOptimizer result;
+
+  return result;
+}
+
 // static
 string&
 AnT::systemFileName ()
@@ -249,12 +299,26 @@ string& AnT::serverHostName ()
 
 // static
 long AnT::serverPort = DEFAULT_SERVER_PORT;
+// static
+long AnT::relayPort = DEFAULT_SERVER_PORT;
+
+// static
+bool AnT::isCompressingResults = true;
+// static
+bool AnT::isStoringCompressed = false;
 
 // static   
 long AnT::numScanPoints = 50;
 // static   
 long AnT::nominalTime = 0;
 
+// static
+long AnT::shardIndex = 0;
+// static
+long AnT::numberOfShards = 1;
+// static
+bool AnT::isBlockSharding = false;
+
 // static
 systemFunctionTreatment_t
 AnT::systemFunctionTreatment = UNDEFINED;
@@ -278,10 +342,18 @@ AnT::setDefaults ()
 
   AnT::serverHostName () = getStandardHostname();
   AnT::serverPort = DEFAULT_SERVER_PORT;
+  AnT::relayPort = DEFAULT_SERVER_PORT;
+
+  AnT::isCompressingResults = true;
+  AnT::isStoringCompressed = false;
 
   AnT::numScanPoints = 50;
   AnT::nominalTime = 0;
 
+  AnT::shardIndex = 0;
+  AnT::numberOfShards = 1;
+  AnT::isBlockSharding = false;
+
   assert (AnT::systemFunctionTreatment == UNDEFINED);
 }
 
@@ -392,8 +464,13 @@ void printUsage (const char* arg0)
        << " [{-m | -M | --mode} <runmode>]"
        << " [{-s | -S | --server} <server name>]"
        << " [{-p | -P | --port} <portnumber>]"
+       << " [--relay-port <portnumber>]"
+       << " [--compression {gzip | none}]"
+       << " [--store-compressed]"
        << " [{-n | -N | --points} <scanpoints>]"
        << " [{-t | -T | --time} <seconds>]"
+       << " [--shard <i>/<K>]"
+       << " [--shard-split {strided | block}]"
        << " [{-v | -V | --version}]"
        << " [{-v | -V | --log}]"
        << " [{-h | -H | --help}]"
@@ -410,22 +487,44 @@ void printUsage (const char* arg0)
        << "    complete path and filename of the initialization file"<< endl
        << "{-m | -M | --mode} <runmode>" << endl
        << "    where runmode is one of 'standalone', " << endl
-       << "    'server' or 'client'. Default is 'standalone'."<< endl
+       << "    'server', 'client' or 'relay'. Default is 'standalone'."<< endl
+       << "    A relay serves the clients of its node and fetches" << endl
+       << "    the scanpoints for them from the server." << endl
        << "{-s | -S | --server} <server name>" << endl
-       << "    for runmodes 'server' and 'client' only." << endl
+       << "    for runmodes 'server', 'client' and 'relay' only." << endl
        << "    Default is the standard hostname of the current system." << endl
        << "{-p | -P | --port} <portnumber>" << endl
-       << "    for runmodes 'server' and 'client' only."<< endl
+       << "    for runmodes 'server', 'client' and 'relay' only."<< endl
        << "    The default port is " << DEFAULT_SERVER_PORT << "." << endl
+       << "--relay-port <portnumber>" << endl
+       << "    for runmode 'relay' only. The port the clients" << endl
+       << "    of the node connect to, the relay runs on the" << endl
+       << "    standard hostname. The default port is "
+       << DEFAULT_SERVER_PORT << "." << endl
+       << "--compression {gzip | none}" << endl
+       << "    for runmodes 'server' and 'client' only. Transport" << endl
+       << "    the results gzipped, if the server and the client" << endl
+       << "    support it (default), or as they are." << endl
+       << "--store-compressed" << endl
+       << "    for runmode 'server' only. Write the results gzipped" << endl
+       << "    without decompression, to the files '<file>.gz'." << endl
        << "{-n | -N | --points} <scanpoints>" << endl
-       << "    for runmode 'client' only." << endl
-       << "    The number of scanpoints the client" << endl
+       << "    for runmodes 'client' and 'relay' only." << endl
+       << "    The number of scanpoints the client (relay)" << endl
        << "    should fetch from the server. Default is 50." << endl
        << "{-t | -T | --time} <seconds>" << endl
        << "    for runmode 'client' only. The (approximate) number" << endl
        << "    of seconds the client should be busy before asking" << endl
        << "    for new scan points from the server. " << endl
        << "    This option overrides the '-n' option." << endl
+       << "--shard <i>/<K>" << endl
+       << "    for runmode 'standalone' only. Simulate only the" << endl
+       << "    i-th of K shards of the scan points (0 <= i < K)," << endl
+       << "    the output file names are tagged with the shard." << endl
+       << "    The outputs are merged by 'AnT-merge-shards'." << endl
+       << "--shard-split {strided | block}" << endl
+       << "    every K-th scan point (default) or a contiguous" << endl
+       << "    block of scan points for each shard." << endl
        << "{-v | -V | --version}" << endl
        << "{-l | -L | --log} write the log-file '"
        << TRANSITIONS_LOG_FILE_NAME 
@@ -491,7 +590,9 @@ void createParseTrees ()
 	   << Error::Exit;
     }
 
-    AnT::specRoot = createParseTree (specStream);
+    AnT::specRoot
+      = createCachedParseTree ( AnT::getGlobalKeysCfgFullPathName (),
+				AnT::getGlobalKeysCacheFullPathName () );
     AnT::iniRoot = createParseTree (iniStream);
   }
 }
@@ -586,7 +687,8 @@ void parseCommandLine (int argc, const char** argv)
 	    
       if ( (AnT::runmode () != "standalone")
 	   && (AnT::runmode () != "server")
-	   && (AnT::runmode () != "client") ) {
+	   && (AnT::runmode () != "client")
+	   && (AnT::runmode () != "relay") ) {
 	cerr << "Invalid runmode supplied!" << endl;
 	printUsageAndExit (argv [0]);
       }
@@ -612,6 +714,34 @@ void parseCommandLine (int argc, const char** argv)
       continue;
     }
 
+    // port number for the clients of a relay:
+    if (curr_arg == "--relay-port") {
+      AnT::relayPort
+	= atol (checkopt<'r'> (argc, argv, argv_i, true));
+      continue;
+    }
+
+    // transport of the results (for server or client):
+    if (curr_arg == "--compression") {
+      const string compression = checkopt<'z'> (argc, argv, argv_i, true);
+
+      if (compression == "none") {
+	AnT::isCompressingResults = false;
+      } else if (compression != "gzip") {
+	cerr << "Invalid compression '" << compression << "' supplied!"
+	     << endl;
+	printUsageAndExit (argv [0]);
+      }
+      continue;
+    }
+
+    // results of the server stored compressed:
+    if (curr_arg == "--store-compressed") {
+      checkopt<'g'> (argc, argv, argv_i);
+      AnT::isStoringCompressed = true;
+      continue;
+    }
+
     // time a client should work before fetching scanpoints:
     if ( (curr_arg == "--time")
 	 || (curr_arg == "-t")
@@ -632,6 +762,38 @@ void parseCommandLine (int argc, const char** argv)
       continue;
     }
 
+    // shard of a sharded standalone scan:
+    if (curr_arg == "--shard") {
+      const string shard = checkopt<'k'> (argc, argv, argv_i, true);
+      string::size_type slash = shard.find ('/');
+
+      if (slash != string::npos) {
+	AnT::shardIndex = atol ((shard.substr (0, slash)).c_str ());
+	AnT::numberOfShards = atol ((shard.substr (slash + 1)).c_str ());
+      }
+
+      if ( (slash == string::npos)
+	   || (AnT::numberOfShards < 1)
+	   || (AnT::shardIndex < 0)
+	   || (AnT::shardIndex >= AnT::numberOfShards) ) {
+	cerr << "Invalid shard '" << shard << "' supplied!" << endl;
+	printUsageAndExit (argv [0]);
+      }
+      continue;
+    }
+
+    if (curr_arg == "--shard-split") {
+      const string split = checkopt<'b'> (argc, argv, argv_i, true);
+
+      if (split == "block") {
+	AnT::isBlockSharding = true;
+      } else if (split != "strided") {
+	cerr << "Invalid shard split '" << split << "' supplied!" << endl;
+	printUsageAndExit (argv [0]);
+      }
+      continue;
+    }
+
     /* hidden option, for compiling system functions: */
     if (curr_arg == "--installation-prefix") {
 #if 0 /* commented out */
@@ -675,6 +837,20 @@ void parseCommandLine (int argc, const char** argv)
     }
   } /* for */
 
+  if ( (AnT::numberOfShards > 1)
+       && (AnT::runmode () != "standalone") ) {
+    cerr << "The option '--shard' is only for the runmode 'standalone'."
+	 << endl;
+    printUsageAndExit (argv [0]);
+  }
+
+  if ( AnT::isStoringCompressed
+       && (AnT::runmode () != "server") ) {
+    cerr << "The option '--store-compressed' is only for the runmode 'server'."
+	 << endl;
+    printUsageAndExit (argv [0]);
+  }
+
   if ((AnT::systemFileName ()).empty ()) {
     cerr << endl
 	 << "WARNING: the name of the dynamical system is missing.\n"
@@ -701,6 +877,15 @@ void initSystem ()
   }
 #endif
 
+#if ! ANT_HAS_LIBZ
+  // compressed results are not possible
+  if (AnT::isStoringCompressed) {
+    cerr << "AnT didn't detect zlib on your system," << endl
+	 << "so the results can not be stored compressed..."
+	 << Error::Exit;
+  }
+#endif
+
   AnT::systemName () = AnT::systemFileName ();
 
   /* make the name of the system library by removing of the leading
@@ -721,7 +906,8 @@ void initSystem ()
   }
 
   // make the name of the configuration file if not given:
-  if (AnT::runmode () != "client") {
+  if ( (AnT::runmode () != "client")
+       && (AnT::runmode () != "relay") ) {
     if (AnT::configFileName () == "") {
       /* default: if nothing is given, then it will be assumed, that
 	 the ini-file has the same name as the shared object containing
@@ -785,6 +971,45 @@ void initSimulator ()
 	.push_back (new MathEvalParser (ithEquationOfMotion));
  }
 
+  if (! (AnT::parsedEquationsOfMotion ()).empty ()) {
+    /* also for the symbolic jacobian of 'ParsedLinearization': */
+    MathEval::setUnsafeSimplification
+      ( dynSysConfiguration.getBool ("UNSAFE_MATH_OPTIMIZATIONS_KEY") );
+  }
+
+  if ( (! (AnT::parsedEquationsOfMotion ()).empty ())
+       && dynSysConfiguration.getBool ("OPTIMIZE_EQUATIONS_OF_MOTION_KEY") ) {
+    vector<MathEval::Node*> expressions;
+    set<string> stateNames;
+
+    for ( vector<MathEvalParser*>::iterator iter
+	    = (AnT::parsedEquationsOfMotion ()).begin ();
+	  iter != (AnT::parsedEquationsOfMotion ()).end ();
+	  ++iter ) {
+      expressions.push_back ((*iter)->getRootNode ());
+    }
+    for ( map<string, unsigned int>::iterator stateIter
+	    = (AnT::stateVariableNames ()).begin ();
+	  stateIter != (AnT::stateVariableNames ()).end ();
+	  ++stateIter ) {
+      stateNames.insert (stateIter->first);
+    }
+
+    MathEvalOptimizer& optimizer = AnT::equationsOfMotionOptimizer ();
+    optimizer.optimize (expressions, stateNames);
+
+    for (unsigned int i = 0; i < expressions.size (); ++i) {
+      (AnT::parsedEquationsOfMotion ())[i]
+	->setEvaluationRoot (optimizer.getExpression (i));
+    }
+
+    debugMsg1 ( "equations of motion optimized: "
+		<< optimizer.getOperationsBefore ()
+		<< " operations per evaluation before, "
+		<< optimizer.getOperationsAfter ()
+		<< " after." );
+  }
+
   /* Connecting must be done before initializing the simulator (due to
      Poincare sections), but after the simulator was created, because
      the user could add its own method plugins (in
@@ -844,6 +1069,7 @@ public:
 
     delete ioStreamFactory;
     destroyANPClient (anpClient);
+    destroyANPRelay (anpRelay);
 
     delete AnT::simulator;
 
@@ -891,11 +1117,27 @@ AnT::run (bool call_createParseTrees)
   initSystem ();
 
   try {
+    if (AnT::runmode () == "relay") {
+      /* the relay only passes the texts of the configuration, the
+	 scanpoints and the results: */
+      assert (anpRelay == NULL);
+      anpRelay
+	= createANPRelay ( (AnT::serverHostName ()).c_str (),
+			   AnT::serverPort,
+			   AnT::relayPort,
+			   AnT::numScanPoints );
+      runANPRelay (anpRelay);
+
+      cout << "relay successfully completed." << endl;
+      throw NormalExit ();
+    }
+
     // make stream factory - used for output of methods
     if (AnT::runmode () == "client") {
       ioStreamFactory = new NetIOStreamFactory ();
     } else {
-      ioStreamFactory = new LocalIOStreamFactory ();
+      ioStreamFactory = new LocalIOStreamFactory (AnT::shardIndex,
+						  AnT::numberOfShards);
     }
 
     if (call_createParseTrees) {
@@ -43,6 +43,7 @@ using std::string;
 #include "simulators/AbstractSimulator.hpp"
 #include "../utils/config/Configuration.hpp"
 #include "../utils/matheval/MathEvalParser.hpp"
+#include "../utils/matheval/MathEvalOptimizer.hpp"
 #include <map>
 using std::map;
 #include <vector>
@@ -56,6 +57,9 @@ extern IOStreamFactory *ioStreamFactory;
 class ANPClient; /* forward declaration */
 extern ANPClient *anpClient;
 
+class ANPRelay; /* forward declaration */
+extern ANPRelay *anpRelay;
+
 typedef void ConnectSystemFuncType ();
 /* this function pointer gets initialized when loading the system */
 extern ConnectSystemFuncType* connectSystemPtr;
@@ -67,10 +71,16 @@ public:
 
   static vector<MathEvalParser*>& parsedEquationsOfMotion ();
 
+  /** common subexpressions and hoisted parameter expressions of the
+      parsed equations of motion */
+  static MathEvalOptimizer& equationsOfMotionOptimizer ();
+
   static string get__ANT_TOPDIR ();
 
   static string getGlobalKeysCfgFullPathName ();
 
+  static string getGlobalKeysCacheFullPathName ();
+
   static string& systemFileName ();
 
   static string& systemName ();
@@ -93,9 +103,26 @@ public:
 
   static   long serverPort;
 
+  /** the port of a relay for the clients of its node */
+  static   long relayPort;
+
+  /** network runs: transport the results gzipped, if possible
+      (option '--compression') */
+  static   bool isCompressingResults;
+
+  /** server: write the gzipped results without decompression
+      (option '--store-compressed') */
+  static   bool isStoringCompressed;
+
   static   long numScanPoints;
   static   long nominalTime;
 
+  /** sharded standalone scan: shard 'shardIndex' of 'numberOfShards',
+      split into blocks or strided (option '--shard') */
+  static   long shardIndex;
+  static   long numberOfShards;
+  static   bool isBlockSharding;
+
 public:
   static void setDefaults ();
 
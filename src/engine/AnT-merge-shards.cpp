@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+/*
+ * Merge of the output files of a sharded scan ('AnT --shard i/K')
+ * into one file in the canonical scan order. In the shard files, the
+ * output of each scan point is preceded by a marker line with the
+ * number of the scan point. The shards are merged in a streaming
+ * fashion (k-way merge by the point numbers), hence the memory needed
+ * does not depend on the size of the files. The header is taken from
+ * the first shard, the markers are removed.
+ *
+ * @note all shard files are open at the same time, for thousands of
+ * shards the limit of open files ('ulimit -n') may have to be raised.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "methods/output/LocalIOStreamFactory.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::ifstream;
+using std::ofstream;
+using std::string;
+using std::vector;
+
+struct Shard
+{
+  string fileName;
+  ifstream* in;
+
+  /** number of the scan point, whose lines are read next */
+  long point;
+};
+
+/** reverse order for 'priority_queue': the smallest point on top */
+struct LaterPoint
+{
+  bool operator() (const Shard* s1, const Shard* s2) const
+  {
+    return s1->point > s2->point;
+  }
+};
+
+static const string marker (SCAN_POINT_MARKER);
+
+static bool
+isMarker (const string& line)
+{
+  return (line.compare (0, marker.size (), marker) == 0);
+}
+
+/**
+ * copy the lines of the shard up to the next marker to 'out' (if not
+ * NULL) and read the number of the next point.
+ * @return false at the end of the shard
+ */
+static bool
+copyLines (Shard& shard, ostream* out)
+{
+  string line;
+
+  while (std::getline (*(shard.in), line))
+  {
+    if (isMarker (line))
+    {
+      shard.point = atol (line.c_str () + marker.size ());
+      return true;
+    }
+
+    if (out != NULL)
+    {
+      (*out) << line << '\n';
+    }
+  }
+
+  return false;
+}
+
+static void
+printUsage (const char* arg0)
+{
+  cout << "usage: " << arg0 << " <output file> <shard file> ..." << endl
+       << "       " << arg0 << " <output file> <number of shards>" << endl
+       << endl
+       << "Merge the output files of a sharded scan ('AnT --shard i/K')"
+       << endl
+       << "into the output file in the canonical scan order. In the second"
+       << endl
+       << "form, the shard files are the tagged names of the output file,"
+       << endl
+       << "e.g. 'period.shard-0-of-8.tna', ..., 'period.shard-7-of-8.tna'."
+       << endl;
+}
+
+int main (int argc, const char** argv)
+{
+  if (argc < 3)
+  {
+    printUsage (argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  const string outFileName (argv[1]);
+  vector<string> shardFileNames;
+
+  char* end = NULL;
+  long numberOfShards = strtol (argv[2], &end, 10);
+
+  if ( (argc == 3) && (*end == '\0') && (numberOfShards > 0) )
+  {
+    for (long i = 0; i < numberOfShards; ++i)
+    {
+      shardFileNames.push_back
+	( LocalIOStreamFactory::getShardFileName (outFileName,
+						  i,
+						  numberOfShards) );
+    }
+  }
+  else
+  {
+    for (int i = 2; i < argc; ++i)
+    {
+      shardFileNames.push_back (argv[i]);
+    }
+  }
+
+  vector<Shard> shards (shardFileNames.size ());
+  for (unsigned int i = 0; i < shards.size (); ++i)
+  {
+    shards[i].fileName = shardFileNames[i];
+    shards[i].in = new ifstream (shardFileNames[i].c_str ());
+
+    if (! *(shards[i].in))
+    {
+      cerr << "Sorry, cannot open the shard file '"
+	   << shardFileNames[i]
+	   << "'."
+	   << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  ofstream out (outFileName.c_str ());
+  if (! out)
+  {
+    cerr << "Sorry, cannot open the output file '"
+	 << outFileName
+	 << "'."
+	 << endl;
+    return EXIT_FAILURE;
+  }
+
+  std::priority_queue<Shard*, vector<Shard*>, LaterPoint> queue;
+
+  /* the header: lines before the first marker, from the first shard
+     only */
+  for (unsigned int i = 0; i < shards.size (); ++i)
+  {
+    if (copyLines (shards[i], (i == 0) ? &out : NULL))
+    {
+      queue.push (&(shards[i]));
+    }
+  }
+
+  long numberOfPoints = 0;
+  while (! queue.empty ())
+  {
+    Shard* shard = queue.top ();
+    queue.pop ();
+
+    ++numberOfPoints;
+
+    if (copyLines (*shard, &out))
+    {
+      queue.push (shard);
+    }
+  }
+
+  for (unsigned int i = 0; i < shards.size (); ++i)
+  {
+    delete shards[i].in;
+  }
+
+  cout << numberOfPoints
+       << " scan points of "
+       << shards.size ()
+       << " shards merged into '"
+       << outFileName
+       << "'."
+       << endl;
+
+  return EXIT_SUCCESS;
+}
@@ -55,6 +55,8 @@
 #include "proxies/FDE_Proxy.hpp"
 #include "proxies/PDE_1d_Proxy.hpp"
 
+#include "utils/DualNumber.hpp"
+
 #include "SpatialDiffOperators.hpp"
 #include "methods/spatial/SpatialEvaluator.hpp"
 #include "methods/conditions/ConditionsChecker.hpp"
@@ -725,4 +725,47 @@ DiffNMethod_1d<spatialStateIndex>& D (int n);
 template<> 
 DiffNMethod_1d<0>& D<0> (int n);
 
+
+/**
+ * Stencil kernels for the structure-of-arrays path (see LatticeState).
+ * The component arrays 'u' must provide halo cells on both sides
+ * (at least one for D0 and D00, two for D000), so that the loops run
+ * over all 'n' cells without any boundary checks and can be
+ * vectorized by the compiler. The boundary policies are not applied
+ * (see the kernels for a LatticeState).
+ */
+inline void latticeD0_1d ( const real_t* __restrict__ u,
+			   real_t* __restrict__ result,
+			   int n,
+			   real_t deltaX )
+{
+  const real_t factor = 1.0 / (2 * deltaX);
+
+  for (int j = 0; j < n; ++j)
+    result[j] = (u[j + 1] - u[j - 1]) * factor;
+}
+
+inline void latticeD00_1d ( const real_t* __restrict__ u,
+			    real_t* __restrict__ result,
+			    int n,
+			    real_t deltaX )
+{
+  const real_t factor = 1.0 / (deltaX * deltaX);
+
+  for (int j = 0; j < n; ++j)
+    result[j] = (u[j + 1] - 2 * u[j] + u[j - 1]) * factor;
+}
+
+inline void latticeD000_1d ( const real_t* __restrict__ u,
+			     real_t* __restrict__ result,
+			     int n,
+			     real_t deltaX )
+{
+  const real_t factor = 1.0 / (2 * deltaX * deltaX * deltaX);
+
+  for (int j = 0; j < n; ++j)
+    result[j] = ( u[j + 2] - 2 * u[j + 1]
+		  + 2 * u[j - 1] - u[j - 2] ) * factor;
+}
+
 #endif
@@ -46,6 +46,17 @@ void AttractorDescription::addCriterion (AbstractCriterion* crit) {
   criteria.push_back (crit);
 }
 
+void AttractorDescription::getKey (AttractorKey& key) const {
+  // descriptions with different numbers of criteria are never equal
+  key.exact.push_back (criteria.size ());
+
+  for (attr_citer_t iter = criteria.begin ();
+       iter != criteria.end ();
+       ++iter) {
+    (*iter)->appendKey (key);
+  }
+}
+
 bool AttractorDescription::operator== (const AttractorDescription& other) const {
   // different attractor types have different criteria!
   //assert (criteria.size () == other.criteria.size ());
@@ -107,23 +118,70 @@ Snapshot::~Snapshot () {
 
 void Snapshot::clear () {
   snapshot.clear ();
+  registry.clear ();
 }
 
-bool Snapshot::addAttractor (AttractorDescription* attr) {
-  assert (attr != NULL);
-  
-  for (snap_iter_t iter = snapshot.begin ();
-       iter != snapshot.end ();
+bool Snapshot::findAttractor (const AttractorDescription& attr,
+			      const AttractorKey& key) const {
+  registry_t::const_iterator group = registry.find (key.exact);
+
+  if (group == registry.end ()) {
+    return false;
+  }
+
+  const Bins& bins = group->second;
+
+  // unbinned descriptions may match anything in their group
+  for (snap_citer_t iter = bins.unbinned.begin ();
+       iter != bins.unbinned.end ();
        ++iter) {
-    
-    if (*attr == **iter) {
-      // equivalent attractor found, discard the new one
-      delete attr;
-      return false;
+    if (attr == **iter) {
+      return true;
     }
   }
-  
+
+  std::multimap<long, AttractorDescription*>::const_iterator first
+    = bins.binned.begin ();
+  std::multimap<long, AttractorDescription*>::const_iterator last
+    = bins.binned.end ();
+
+  if (key.binned) {
+    // equal descriptions lie at most one bin apart
+    first = bins.binned.lower_bound (key.bin - 1);
+    last = bins.binned.upper_bound (key.bin + 1);
+  }
+
+  for (; first != last; ++first) {
+    if (attr == *(first->second)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool Snapshot::addAttractor (AttractorDescription* attr) {
+  assert (attr != NULL);
+
+  AttractorKey key;
+  attr->getKey (key);
+
+  if (findAttractor (*attr, key)) {
+    // equivalent attractor found, discard the new one
+    delete attr;
+    return false;
+  }
+
   snapshot.push_back (attr);
+
+  Bins& bins = registry[key.exact];
+
+  if (key.binned) {
+    bins.binned.insert (std::make_pair (key.bin, attr));
+  } else {
+    bins.unbinned.push_back (attr);
+  }
+
   return true;
 }
 
@@ -223,6 +281,14 @@ TypeCriterion::operator== (const AbstractCriterion& other) const
   return false;
 }
 
+template <typename StateType>
+void
+AttractorMinMax<StateType>::
+TypeCriterion::appendKey (AttractorKey& key) const
+{
+  key.exact.push_back (type);
+}
+
 template <typename StateType>
 ostream&
 AttractorMinMax<StateType>::
@@ -274,6 +340,34 @@ MinMaxCriterion::operator== (const AbstractCriterion& other) const
   return false;
 }
 
+template <typename StateType>
+void
+AttractorMinMax<StateType>::
+MinMaxCriterion::appendKey (AttractorKey& key) const
+{
+  key.exact.push_back (min.getTotalSize ());
+  key.exact.push_back (max.getTotalSize ());
+
+  if (key.binOffered || (min.getTotalSize () == 0)) {
+    return;
+  }
+
+  key.binOffered = true;
+
+  if (! (e > 0)) {
+    return;
+  }
+
+  // bins twice as wide as the precision, so values within the
+  // precision end up in neighbouring bins despite rounding
+  real_t q = floor (min[0] / (2 * e));
+
+  if (fabs (q) < 1e15) {
+    key.binned = true;
+    key.bin = (long) q;
+  }
+}
+
 template <typename StateType>
 ostream&
 AttractorMinMax<StateType>::
@@ -2,12 +2,32 @@
 #define ATTRACTORTRACKING_HPP
 
 #include <list>
+#include <map>
+#include <vector>
 
 #include "../../utils/arrays/CyclicArray.hpp"
 #include "../../utils/config/Indentation.hpp"
 
 #include "../simulators/AbstractSimulator.hpp"
 
+/**
+ * Lookup key of an attractor description in a snapshot registry.
+ * Two descriptions can only be equal if their exact parts are equal
+ * and, if both are binned, their bins differ by at most one.
+ * Only the first criterion offering a bin decides it, if it cannot
+ * quantize its values the description stays unbinned.
+ * @see Snapshot, AbstractCriterion::appendKey
+ */
+class AttractorKey {
+public:
+  std::vector<long> exact;
+  bool binOffered;
+  bool binned;
+  long bin;
+
+  AttractorKey () : binOffered (false), binned (false), bin (0) {}
+};
+
 /**
  * This abstract class is the base class for all types of
  * attractor description criteria.
@@ -43,6 +63,13 @@ public:
   virtual bool operator== (const AbstractCriterion& other) const = 0;
   bool operator!= (const AbstractCriterion& other) const { return !(*this == other); }
 
+  /**
+   * Contributes to the registry key of the owning description.
+   * Criteria must only add what operator== needs to hold, the
+   * default adds nothing and hence never filters candidates.
+   */
+  virtual void appendKey (AttractorKey& key) const {}
+
   virtual ostream& inspect (ostream& s, Indentation& indentation) const;
 };
 
@@ -73,6 +100,8 @@ public:
   ~AttractorDescription ();
 
   void addCriterion (AbstractCriterion* crit);
+
+  void getKey (AttractorKey& key) const;
   
   bool operator== (const AttractorDescription& other) const;
   bool operator!= (const AttractorDescription& other) const { return !(*this == other); }
@@ -86,8 +115,10 @@ typedef snap_t::const_iterator snap_citer_t;
 
 /**
  * This class bundles all attractor descriptions found at a specific
- * checkpoint.
- * @see AttractorDescription
+ * checkpoint. Besides the list in order of discovery, the descriptions
+ * are indexed by their quantized criteria, so a new attractor is only
+ * compared against the few known ones sharing its neighbourhood.
+ * @see AttractorDescription, AttractorKey
  */
 class Snapshot {
 public:    
@@ -95,6 +126,20 @@ public:
   snap_iter_t currentAttractorIter;
 
 private:
+  class Bins {
+  public:
+    std::multimap<long, AttractorDescription*> binned;
+    snap_t unbinned;
+  };
+
+  typedef std::map<std::vector<long>, Bins> registry_t;
+
+  registry_t registry;
+
+  bool findAttractor (const AttractorDescription& attr,
+		      const AttractorKey& key) const;
+
+
   // disable copy constructor and assignment operator
   Snapshot (const Snapshot& other);
   Snapshot& operator= (const Snapshot& other);
@@ -159,6 +204,7 @@ private:
 
     AbstractCriterion* clone () const;
     bool operator== (const AbstractCriterion& other) const;
+    void appendKey (AttractorKey& key) const;
     ostream& inspect (ostream& s, Indentation& indentation) const;
   };
 
@@ -174,6 +220,7 @@ private:
 
     AbstractCriterion* clone () const;
     bool operator== (const AbstractCriterion& other) const;
+    void appendKey (AttractorKey& key) const;
     ostream& inspect (ostream& s, Indentation& indentation) const;
   };
 
@@ -0,0 +1,371 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#include "AdaptiveScan.hpp"
+#include "AnT-init.hpp" // AnT::simulator
+#include "methods/output/IOStreamFactory.hpp"
+#include "methods/period/PeriodCalculator.hpp"
+#include "methods/lyapunov/LyapunovExponentsCalculator.hpp"
+#include "methods/bandcounter/BandCounter.hpp"
+
+AdaptiveScanItemSequence::AdaptiveScanItemSequence (IterData* iterData)
+  : ScanItemSequence (iterData),
+    criterion (PERIOD),
+    maxDepth (0),
+    lyapunovTolerance (0.0),
+    cellsFile (NULL),
+    method (NULL),
+    numberOfCells (0)
+{}
+
+AdaptiveScanItemSequence::~AdaptiveScanItemSequence ()
+{}
+
+void
+AdaptiveScanItemSequence::initialize (Configuration& scanDescription)
+{
+  ScanItemSequence::initialize (scanDescription);
+
+  if (scanMode < 1)
+  {
+    cerr << "The adaptive scan needs at least one scan item."
+	 << endl << Error::Exit;
+  }
+
+  Configuration refinementDescription
+    = scanDescription.getSubConfiguration ("REFINEMENT_KEY");
+
+  if (refinementDescription.checkForEnumValue ("CRITERION_KEY",
+					       "PERIOD_CRITERION_KEY"))
+  {
+    criterion = PERIOD;
+  }
+  else if (refinementDescription.checkForEnumValue
+	   ("CRITERION_KEY", "LYAPUNOV_SIGN_CRITERION_KEY"))
+  {
+    criterion = LYAPUNOV_SIGN;
+  }
+  else if (refinementDescription.checkForEnumValue
+	   ("CRITERION_KEY", "BAND_COUNT_CRITERION_KEY"))
+  {
+    criterion = BAND_COUNT;
+  }
+  else
+  {
+    cerr << "An unrecognized setting '"
+	 << refinementDescription.getEnum ("CRITERION_KEY")
+	 << "' found at the key '"
+	 << refinementDescription.getOriginalKey ("CRITERION_KEY")
+	 << "'."
+	 << endl << Error::Exit;
+  }
+
+  maxDepth = refinementDescription.getInteger ("REFINEMENT_DEPTH_KEY");
+  if ((maxDepth < 0) || (maxDepth > 30))
+  {
+    cerr << "The setting of the field '"
+	 << refinementDescription.getOriginalKey ("REFINEMENT_DEPTH_KEY")
+	 << "' is " << maxDepth
+	 << ". Only values between 0 and 30 are enabled here."
+	 << endl << Error::Exit;
+  }
+
+  lyapunovTolerance
+    = refinementDescription.getReal ("LYAPUNOV_TOLERANCE_KEY");
+  if (lyapunovTolerance < 0.0)
+  {
+    cerr << "The setting of the field '"
+	 << refinementDescription.getOriginalKey ("LYAPUNOV_TOLERANCE_KEY")
+	 << "' is " << lyapunovTolerance
+	 << ". Only non-negative values are enabled here."
+	 << endl << Error::Exit;
+  }
+
+  cellsFileName = refinementDescription.getString ("CELLS_FILE_KEY");
+
+  items.clear ();
+  for (seq_t::iterator i = sequence.begin ();
+       i != sequence.end (); ++i)
+  {
+    IndexableScanItem* item = dynamic_cast<IndexableScanItem*> (*i);
+
+    if (item == NULL)
+    {
+      cerr << "The adaptive scan supports indexable scan items only."
+	   << endl << Error::Exit;
+    }
+
+    item->refine (1L << maxDepth);
+    items.push_back (item);
+  }
+
+  createCoarseCells ();
+}
+
+void
+AdaptiveScanItemSequence::createCoarseCells ()
+{
+  cells.clear ();
+  results.clear ();
+  numberOfCells = 0;
+
+  long coarseSize = 1L << maxDepth;
+  int d = items.size ();
+
+  Cell cell;
+  cell.origin.assign (d, 0);
+  cell.size = coarseSize;
+
+  currentPoint = cell.origin;
+
+  /* all origins of the coarse grid, the first item runs fastest
+     (as in the nested items scan): */
+  while (true)
+  {
+    cells.push_back (cell);
+
+    int k = 0;
+    for (; k < d; ++k)
+    {
+      cell.origin[k] += coarseSize;
+      if (cell.origin[k] < items[k]->getNumPoints () - 1)
+	break;
+      cell.origin[k] = 0;
+    }
+
+    if (k == d)
+      break;
+  }
+}
+
+bool
+AdaptiveScanItemSequence::nextPoint ()
+{
+  int d = items.size ();
+
+  while (! cells.empty ())
+  {
+    const Cell& cell = cells.front ();
+
+    long value = 0;
+    bool isUniform = true;
+
+    for (long corner = 0; corner < (1L << d); ++corner)
+    {
+      Point p = cell.origin;
+      for (int k = 0; k < d; ++k)
+      {
+	if ((corner >> k) & 1)
+	  p[k] += cell.size;
+      }
+
+      map<Point, long>::const_iterator r = results.find (p);
+      if (r == results.end ())
+      {
+	/* not evaluated yet: */
+	currentPoint = p;
+	for (int k = 0; k < d; ++k)
+	  items[k]->setCurrentIndex (p[k]);
+
+	return true;
+      }
+
+      if (corner == 0)
+	value = r->second;
+      else if (r->second != value)
+	isUniform = false;
+    }
+
+    if (isUniform || (cell.size == 1))
+    {
+      writeCell (cell, value, isUniform);
+    }
+    else
+    {
+      long size = cell.size / 2;
+      for (long child = 0; child < (1L << d); ++child)
+      {
+	Cell c;
+	c.origin = cell.origin;
+	c.size = size;
+	for (int k = 0; k < d; ++k)
+	{
+	  if ((child >> k) & 1)
+	    c.origin[k] += size;
+	}
+
+	cells.push_back (c);
+      }
+    }
+
+    cells.pop_front ();
+  }
+
+  return false;
+}
+
+long
+AdaptiveScanItemSequence::getResult ()
+{
+  if (method == NULL)
+  {
+    MethodsData* methodsData = (AnT::simulator)->getMethodsData ();
+    assert (methodsData != NULL);
+
+    for (MethodsData::map_t::iterator i = methodsData->data.begin ();
+	 (method == NULL) && (i != methodsData->data.end ()); ++i)
+    {
+      switch (criterion)
+      {
+      case PERIOD:
+	method = dynamic_cast<PeriodCalculator*> (*i);
+	break;
+      case LYAPUNOV_SIGN:
+	method = dynamic_cast<LyapunovExponentsCalculator*> (*i);
+	break;
+      case BAND_COUNT:
+	method = dynamic_cast<BandCounter*> (*i);
+	break;
+      }
+    }
+
+    if (method == NULL)
+    {
+      cerr << "The criterion of the adaptive scan needs the "
+	   << ( (criterion == PERIOD) ? "period analysis" :
+		(criterion == LYAPUNOV_SIGN) ? "lyapunov exponents analysis" :
+		"band counter" )
+	   << " to be active."
+	   << endl << Error::Exit;
+    }
+  }
+
+  switch (criterion)
+  {
+  case PERIOD:
+    return static_cast<PeriodCalculator*> (method)->T;
+  case LYAPUNOV_SIGN:
+    {
+      const Array<real_t>& exponents
+	= static_cast<LyapunovExponentsCalculator*> (method)->exponents;
+
+      real_t leading = exponents[0];
+      for (int i = 1; i < exponents.getTotalSize (); ++i)
+      {
+	if (exponents[i] > leading)
+	  leading = exponents[i];
+      }
+
+      // numerically estimated exponents are never exactly zero
+      if (fabs (leading) < lyapunovTolerance)
+	return 0;
+
+      return (leading > 0.0) ? 1 : -1;
+    }
+  case BAND_COUNT:
+    return static_cast<BandCounter*> (method)->getBandCount ();
+  }
+
+  assert (false);
+  return 0;
+}
+
+void
+AdaptiveScanItemSequence::writeCell (const Cell& cell,
+				     long value,
+				     bool isUniform)
+{
+  if (cellsFile == NULL)
+  {
+    cellsFile = ioStreamFactory->getOStream (cellsFileName, this);
+  }
+
+  /* the scan values are obtained by setting the items, the current
+     scan point is set again by 'nextPoint': */
+  for (unsigned int k = 0; k < items.size (); ++k)
+  {
+    items[k]->setCurrentIndex (cell.origin[k]);
+    items[k]->set ();
+    *(items[k]) >> *cellsFile;
+    *cellsFile << " ";
+
+    items[k]->setCurrentIndex (cell.origin[k] + cell.size);
+    items[k]->set ();
+    *(items[k]) >> *cellsFile;
+    *cellsFile << " ";
+  }
+
+  *cellsFile << value
+	     << " "
+	     << (isUniform ? 1 : 0)
+	     << endl;
+
+  ++numberOfCells;
+}
+
+// virtual
+void
+AdaptiveScanItemSequence::standaloneScanNext ()
+{
+  if (firstCall)
+  {
+    firstCall = false;
+  }
+  else
+  {
+    results[currentPoint] = getResult ();
+  }
+
+  if (nextPoint ())
+  {
+    set ();
+    return;
+  }
+
+  finalFlag = true;
+
+  long numberOfPoints = 1;
+  for (unsigned int k = 0; k < items.size (); ++k)
+    numberOfPoints *= items[k]->getNumPoints ();
+
+  cout << "adaptive scan: "
+       << results.size ()
+       << " of "
+       << numberOfPoints
+       << " scan points evaluated, "
+       << numberOfCells
+       << " cells written."
+       << endl;
+}
+
+// virtual
+void
+AdaptiveScanItemSequence::reset ()
+{
+  ScanItemSequence::reset ();
+
+  createCoarseCells ();
+}
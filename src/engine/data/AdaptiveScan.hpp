@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#ifndef ADAPTIVE_SCAN_HPP
+#define ADAPTIVE_SCAN_HPP
+
+#include <list>
+#include <map>
+#include <vector>
+using std::list;
+using std::map;
+using std::vector;
+
+#include "ScanData.hpp"
+
+class InvestigationMethod;
+
+/**
+ * Adaptive refinement scan (scan type 'adaptive'). The scan starts
+ * with the coarse grid given by the scan items and refines only the
+ * cells, whose corners disagree in the chosen criterion:
+ * <UL>
+ * <LI> the period found by the period analysis, </LI>
+ * <LI> the sign of the leading lyapunov exponent (zero within a
+ *      tolerance), </LI>
+ * <LI> the number of bands found by the band counter. </LI>
+ * </UL>
+ * The cells are bisected in each scan direction (intervals, quadtree,
+ * octree, etc.) up to the maximal refinement depth \f$ L \f$, hence
+ * a scan item with \f$ N \f$ points gets the effective resolution
+ * \f$ (N-1) 2^L + 1 \f$. Each scan point is simulated once, the
+ * investigation methods write their results in the order of
+ * evaluation. The resulting cells are written to an extra file with
+ * their geometry (the scan values at the lower and upper corner for
+ * each item), the criterion at the lower corner and a flag, whether
+ * all corners agree.
+ *
+ * @note structures smaller than a coarse cell and not touching any of
+ * its corners can not be found.
+ * @note only the scan items 'real_linear', 'real_logarithmic' and
+ * 'real_linear_2d' can be refined. Only the standalone run mode is
+ * supported.
+ */
+class AdaptiveScanItemSequence : public ScanItemSequence
+{
+private:
+  enum Criterion {PERIOD, LYAPUNOV_SIGN, BAND_COUNT};
+
+  /** indices of a point of the finest grid, one for each item */
+  typedef vector<long> Point;
+
+  /**
+   * a cell of the finest grid with the corners
+   * \f$ origin + size \cdot (b_1, \ldots, b_d),\; b_i \in \{0,1\} \f$
+   */
+  struct Cell
+  {
+    Point origin;
+    long size;
+  };
+
+  Criterion criterion;
+  long maxDepth;
+  /** lyapunov exponents with absolute values below are counted as zero */
+  real_t lyapunovTolerance;
+  string cellsFileName;
+  ostream* cellsFile;
+
+  /** the method, which provides the criterion, found at the first use */
+  InvestigationMethod* method;
+
+  vector<IndexableScanItem*> items;
+
+  /** cells to be processed (breadth first) */
+  list<Cell> cells;
+
+  /** criterion at the points evaluated so far */
+  map<Point, long> results;
+
+  Point currentPoint;
+  long numberOfCells;
+
+  /** build the coarse cells, clear all results */
+  void createCoarseCells ();
+
+  /**
+   * process the cells until a corner without result is found and
+   * set the scan items to it.
+   * @return false, if all cells are processed
+   */
+  bool nextPoint ();
+
+  /** the criterion for the current scan point */
+  long getResult ();
+
+  void writeCell (const Cell& cell, long value, bool isUniform);
+
+public:
+  AdaptiveScanItemSequence (IterData* iterData);
+
+  virtual void initialize (Configuration& scanDescription);
+
+  virtual void standaloneScanNext ();
+
+  virtual void reset ();
+
+  virtual ~AdaptiveScanItemSequence ();
+}; /* class AdaptiveScanItemSequence */
+
+#endif
@@ -0,0 +1,191 @@
+/* 
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ * 
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ * 
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#include <cmath>
+
+#include "DelayHistory.hpp"
+#include "../utils/debug/Error.hpp"
+
+DelayHistory::
+DelayHistory (int aStateSpaceDim,
+	      real_t aStepSize,
+	      real_t aMaxDelay)
+  : stepSize (aStepSize),
+    newest (0),
+    size (0),
+    stageOffset (0.0)
+{
+  if (stepSize <= 0.0)
+    cerr << "DelayHistory: the step size must be positive."
+	 << endl << Error::Exit;
+
+  // ages 0 .. ceil (maxDelay/h) + 1 are needed for the stages
+  // within the current step:
+  int capacity = (int) ceil (aMaxDelay / stepSize - 1.0e-9) + 2;
+
+  states.alloc (capacity);
+  leftSlopes.alloc (capacity);
+  rightSlopes.alloc (capacity);
+
+  for (int i = 0; i < capacity; ++i)
+    {
+      states[i].alloc (aStateSpaceDim);
+      leftSlopes[i].alloc (aStateSpaceDim);
+      rightSlopes[i].alloc (aStateSpaceDim);
+    }
+}
+
+int
+DelayHistory::
+getCapacity () const
+{
+  return states.getTotalSize ();
+}
+
+void
+DelayHistory::
+clear ()
+{
+  newest = 0;
+  size = 0;
+  stageOffset = 0.0;
+}
+
+int
+DelayHistory::
+indexOfAge (int age) const
+{
+  int capacity = getCapacity ();
+
+  return (newest - age + capacity) % capacity;
+}
+
+void
+DelayHistory::
+addState (const Array<real_t>& state,
+	  const Array<real_t>& slope)
+{
+  if (size > 0)
+    newest = (newest + 1) % getCapacity ();
+
+  if (size < getCapacity ())
+    ++size;
+
+  states[newest] = state;
+  leftSlopes[newest] = slope;
+  rightSlopes[newest] = slope;
+}
+
+void
+DelayHistory::
+addOldState (const Array<real_t>& state,
+	     const Array<real_t>& slope)
+{
+  if (size == getCapacity ())
+    return;
+
+  int i = indexOfAge (size);
+  ++size;
+
+  states[i] = state;
+  leftSlopes[i] = slope;
+  rightSlopes[i] = slope;
+}
+
+void
+DelayHistory::
+setNewestSlope (const Array<real_t>& slope)
+{
+  leftSlopes[newest] = slope;
+  rightSlopes[newest] = slope;
+}
+
+void
+DelayHistory::
+setNewestRightSlope (const Array<real_t>& slope)
+{
+  rightSlopes[newest] = slope;
+}
+
+void
+DelayHistory::
+setStageOffset (real_t anOffset)
+{
+  stageOffset = anOffset;
+}
+
+void
+DelayHistory::
+getState (real_t delay, Array<real_t>& delayState) const
+{
+  assert (size > 0);
+
+  // age of the requested time in steps, counted from the newest point:
+  real_t age = (delay - stageOffset) / stepSize;
+
+  int rightAge;
+  real_t sigma; // position within [left, right], in [0, 1]
+
+  if (age <= 0.0)
+    {
+      // delay shorter than the stage offset: extrapolation
+      if (size < 2)
+	{
+	  delayState = states[newest];
+	  return;
+	}
+
+      rightAge = 0;
+      sigma = 1.0 - age;
+    }
+  else
+    {
+      rightAge = (int) floor (age);
+      sigma = 1.0 - (age - rightAge);
+
+      if (rightAge + 1 >= size)
+	{
+	  delayState = states[indexOfAge (size - 1)];
+	  return;
+	}
+    }
+
+  const Array<real_t>& yL = states[indexOfAge (rightAge + 1)];
+  const Array<real_t>& fL = rightSlopes[indexOfAge (rightAge + 1)];
+  const Array<real_t>& yR = states[indexOfAge (rightAge)];
+  const Array<real_t>& fR = leftSlopes[indexOfAge (rightAge)];
+
+  real_t s2 = sigma * sigma;
+  real_t s3 = s2 * sigma;
+
+  real_t h00 = 2 * s3 - 3 * s2 + 1;
+  real_t h10 = (s3 - 2 * s2 + sigma) * stepSize;
+  real_t h01 = -2 * s3 + 3 * s2;
+  real_t h11 = (s3 - s2) * stepSize;
+
+  for (long i = 0; i < delayState.getTotalSize (); ++i)
+    delayState[i] = h00 * yL[i] + h10 * fL[i] + h01 * yR[i] + h11 * fR[i];
+}
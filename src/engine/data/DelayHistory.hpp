@@ -0,0 +1,123 @@
+/* 
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ * 
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ * 
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#ifndef DELAY_HISTORY_HPP
+#define DELAY_HISTORY_HPP
+
+#include "utils/GlobalConstants.hpp"
+#include "../utils/arrays/Array.hpp"
+
+/**
+ * Dense-output history of a DDE. For each grid point
+ * \f$t_n - k h\f$ (k = 0, 1, ...) the state and the derivatives at
+ * the left and the right side are saved, so that the solution can be
+ * evaluated at arbitrary times by piecewise cubic Hermite
+ * interpolation. The interpolation error is of the order
+ * \f$O(h^4)\f$, i.e. it does not spoil a fourth order integration
+ * method, and the delays need not be multiples of the step size.
+ *
+ * The capacity is bounded by the maximal delay: only the points
+ * needed for delays up to 'maxDelay' are kept.
+ *
+ * The system functions see the history relative to the time of the
+ * current state (the 'stage offset' is set by the integrator for
+ * each stage), hence 'getState (tau, y)' yields \f$\vec y(t-\tau)\f$.
+ * Multiple and state-dependent delays are possible this way.
+ *
+ * @see DDE_Proxy::HistorySystemFunction, DDE_DenseRK44
+ */
+class DelayHistory
+{
+private:
+  real_t stepSize;
+
+  /** states, left and right derivatives (cyclic buffers) */
+  Array<Array<real_t> > states;
+  Array<Array<real_t> > leftSlopes;
+  Array<Array<real_t> > rightSlopes;
+
+  /** index of the newest point in the cyclic buffers */
+  int newest;
+
+  /** number of valid points */
+  int size;
+
+  /** time of the current stage minus the time of the newest point */
+  real_t stageOffset;
+
+  int indexOfAge (int age) const;
+
+public:
+  /**
+   * @param aStateSpaceDim dimension of the states
+   * @param aStepSize integration step size
+   * @param aMaxDelay maximal delay, which will be requested
+   */
+  DelayHistory (int aStateSpaceDim,
+		real_t aStepSize,
+		real_t aMaxDelay);
+
+  /**
+   * the maximal number of points kept
+   */
+  int getCapacity () const;
+
+  /**
+   * remove all points (e.g. at the begin of a new iteration run)
+   */
+  void clear ();
+
+  /**
+   * add a new point one step after the newest one. The slope is
+   * used as the left and right derivative; the latter can be
+   * corrected by 'setNewestRightSlope'.
+   */
+  void addState (const Array<real_t>& state,
+		 const Array<real_t>& slope);
+
+  /**
+   * add a new point one step before the oldest one (used for
+   * filling in the initial function).
+   */
+  void addOldState (const Array<real_t>& state,
+		    const Array<real_t>& slope);
+
+  void setNewestSlope (const Array<real_t>& slope);
+
+  void setNewestRightSlope (const Array<real_t>& slope);
+
+  void setStageOffset (real_t anOffset);
+
+  /**
+   * evaluate the history at the time \f$t - delay\f$, where \f$t\f$
+   * is the time of the current stage. Before the oldest point the
+   * history is continued constantly, after the newest one the last
+   * Hermite polynomial is extrapolated.
+   */
+  void getState (real_t delay, Array<real_t>& delayState) const;
+};
+
+#endif
@@ -507,7 +507,8 @@ DDE_Data
 			initializer,
 			numberOfIterations,
 			aDt),
-  tau (aTau)
+  tau (aTau),
+  maxDelay (aTau)
 {
   tauIndex = - (initialStates.getTotalSize () - 1);
 }
@@ -390,6 +390,13 @@ class DDE_Data : public ContinuousDynSysData
    */
   long tauIndex;
 
+  /** maximal delay, which may be requested from the dense-output
+   * history (see DelayHistory). Equal to 'tau' for systems with a
+   * single constant delay. With dense output the system memory
+   * length is given by 'maxDelay', 'tauIndex' by 'tau'.
+   */
+  ContinuousTimeType maxDelay;
+
   /**
    * 
    * @param aName name of the system
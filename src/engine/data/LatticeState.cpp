@@ -0,0 +1,210 @@
+/* 
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ * 
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ * 
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#include "LatticeState.hpp"
+
+LatticeState::
+LatticeState (int aNumberOfCells, int aCellDim, int aHalo)
+  : numberOfCells (aNumberOfCells),
+    cellDim (aCellDim),
+    halo (aHalo),
+    stride (aNumberOfCells + 2 * aHalo),
+    contents (NULL),
+    minPolicy (INVALID),
+    maxPolicy (INVALID),
+    minValue (0.0),
+    maxValue (0.0)
+{
+  if (halo > numberOfCells)
+    cerr << "LatticeState: the halo width (" << halo
+	 << ") can not be larger than the number of cells ("
+	 << numberOfCells << ")."
+	 << endl << Error::Exit;
+
+  // round up to a multiple of four values, so that each component
+  // begins at a well-aligned address, if 'contents' is aligned:
+  stride = ((stride + 3) / 4) * 4;
+
+  contents = new real_t[cellDim * stride];
+
+  for (int k = 0; k < cellDim * stride; ++k)
+    contents[k] = 0.0;
+}
+
+LatticeState::
+~LatticeState ()
+{
+  delete [] contents;
+}
+
+void
+LatticeState::
+scatter (const Array<real_t>& cellularState)
+{
+  assert (cellularState.getTotalSize () == numberOfCells * cellDim);
+
+  for (int i = 0; i < cellDim; ++i)
+    {
+      real_t* component = (*this)[i];
+
+      for (int j = 0; j < numberOfCells; ++j)
+	component[j] = cellularState[j * cellDim + i];
+    }
+}
+
+void
+LatticeState::
+gather (Array<real_t>& cellularState) const
+{
+  assert (cellularState.getTotalSize () == numberOfCells * cellDim);
+
+  for (int i = 0; i < cellDim; ++i)
+    {
+      const real_t* component = (*this)[i];
+
+      for (int j = 0; j < numberOfCells; ++j)
+	cellularState[j * cellDim + i] = component[j];
+    }
+}
+
+void
+LatticeState::
+fillHalo ( BoundaryPolicyEnum aMinPolicy,
+	   BoundaryPolicyEnum aMaxPolicy,
+	   real_t aMinValue,
+	   real_t aMaxValue )
+{
+  int N = numberOfCells;
+
+  minPolicy = aMinPolicy;
+  maxPolicy = aMaxPolicy;
+  minValue = aMinValue;
+  maxValue = aMaxValue;
+
+  for (int i = 0; i < cellDim; ++i)
+    {
+      real_t* u = (*this)[i];
+
+      for (int k = 1; k <= halo; ++k)
+	{
+	  switch (minPolicy)
+	    {
+	    case CYCLIC:
+	      u[-k] = u[N - k];
+	      break;
+	    case FLUXLESS:
+	      u[-k] = u[k - 1];
+	      break;
+	    case INTERPOLATED:
+	      u[-k] = u[0] - k * (u[1] - u[0]);
+	      break;
+	    case CONSTANT:
+	      u[-k] = minValue;
+	      break;
+	    default:
+	      cerr << "LatticeState: the boundary policy must be set!"
+		   << endl << Error::Exit;
+	    }
+
+	  switch (maxPolicy)
+	    {
+	    case CYCLIC:
+	      u[N - 1 + k] = u[k - 1];
+	      break;
+	    case FLUXLESS:
+	      u[N - 1 + k] = u[N - k];
+	      break;
+	    case INTERPOLATED:
+	      u[N - 1 + k] = u[N - 1] + k * (u[N - 1] - u[N - 2]);
+	      break;
+	    case CONSTANT:
+	      u[N - 1 + k] = maxValue;
+	      break;
+	    default:
+	      cerr << "LatticeState: the boundary policy must be set!"
+		   << endl << Error::Exit;
+	    }
+	}
+    }
+}
+
+void
+LatticeState::
+applyBoundaryPolicy ( real_t* result,
+		      int leftOffset,
+		      int rightOffset ) const
+{
+  int N = numberOfCells;
+  int minValidIndex = leftOffset;
+  int maxValidIndex = N - 1 - rightOffset;
+
+  assert (minValidIndex <= maxValidIndex);
+
+  real_t minValidResult = result[minValidIndex];
+  real_t maxValidResult = result[maxValidIndex];
+
+  for (int j = 0; j < minValidIndex; ++j)
+    {
+      switch (minPolicy)
+	{
+	case CYCLIC:
+	  break;
+	case FLUXLESS:
+	  result[j] = 0.0;
+	  break;
+	case INTERPOLATED:
+	  result[j] = minValidResult;
+	  break;
+	case CONSTANT:
+	  result[j] = minValue;
+	  break;
+	default:
+	  cerr << "LatticeState: the boundary policy must be set!"
+	       << endl << Error::Exit;
+	}
+    }
+
+  for (int j = maxValidIndex + 1; j < N; ++j)
+    {
+      switch (maxPolicy)
+	{
+	case CYCLIC:
+	  break;
+	case FLUXLESS:
+	  result[j] = 0.0;
+	  break;
+	case INTERPOLATED:
+	  result[j] = maxValidResult;
+	  break;
+	case CONSTANT:
+	  result[j] = maxValue;
+	  break;
+	default:
+	  cerr << "LatticeState: the boundary policy must be set!"
+	       << endl << Error::Exit;
+	}
+    }
+}
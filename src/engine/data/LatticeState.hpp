@@ -0,0 +1,172 @@
+/* 
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ * 
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ * 
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#ifndef LATTICE_STATE_HPP
+#define LATTICE_STATE_HPP
+
+#include "utils/GlobalConstants.hpp"
+#include "../utils/arrays/Array.hpp"
+#include "../SpatialDiffOperators.hpp"
+
+/**
+ * Structure-of-arrays representation of the state of a spatially
+ * extended system (CML, PDE) with 'numberOfCells' cells of dimension
+ * 'cellDim'. In contrast to CellularState, where the cells are stored
+ * one after another (cell-major), each component is stored
+ * contiguously over all cells here. Each component array is extended
+ * by 'halo' cells on both sides, so that stencils can be applied to
+ * all cells without boundary checks within the inner loop:
+ *
+ * (*this)[i][j] is the component 'i' of the cell 'j', where 'j'
+ * ranges from -halo to numberOfCells-1+halo.
+ *
+ * The halo cells are set by 'fillHalo' according to a boundary
+ * policy:
+ * <UL>
+ * <LI> CYCLIC: periodic continuation of the lattice </LI>
+ * <LI> FLUXLESS: mirrored at the boundary </LI>
+ * <LI> INTERPOLATED: linear extrapolation of the boundary cells </LI>
+ * <LI> CONSTANT: the given constant values </LI>
+ * </UL>
+ *
+ * Stencils applied to the halo cells directly do not give the
+ * derivatives of the per-cell operators (see DiffMethod_1d, e.g.
+ * CONSTANT yields the constant value itself as derivative at the
+ * boundary cells). The kernels 'latticeD0_1d' etc. taking a
+ * LatticeState reproduce them by 'applyBoundaryPolicy'.
+ *
+ * @see CML_Proxy::LatticeSystemFunction,
+ * PDE_1d_Proxy::LatticeSystemFunction
+ */
+class LatticeState
+{
+public:
+  const int numberOfCells;
+  const int cellDim;
+  const int halo;
+
+private:
+  /** distance between the component arrays */
+  int stride;
+
+  /** all component arrays inclusive halo cells */
+  real_t* contents;
+
+  /** the boundary policies of the last 'fillHalo' */
+  BoundaryPolicyEnum minPolicy;
+  BoundaryPolicyEnum maxPolicy;
+  real_t minValue;
+  real_t maxValue;
+
+  /** Not implemented (don't copy such objects). */
+  LatticeState (const LatticeState&);
+  LatticeState& operator= (const LatticeState&);
+
+public:
+  LatticeState (int aNumberOfCells, int aCellDim, int aHalo);
+
+  ~LatticeState ();
+
+  /**
+   * @return pointer to the cell zero of the given component
+   */
+  inline real_t* operator[] (int component)
+  {
+    return contents + component * stride + halo;
+  }
+
+  inline const real_t* operator[] (int component) const
+  {
+    return contents + component * stride + halo;
+  }
+
+  /**
+   * copy a cell-major state (see CellularState) into the inner cells
+   */
+  void scatter (const Array<real_t>& cellularState);
+
+  /**
+   * copy the inner cells into a cell-major state (see CellularState)
+   */
+  void gather (Array<real_t>& cellularState) const;
+
+  /**
+   * set the halo cells of all components according to the given
+   * boundary policies. The values are used by the policy CONSTANT
+   * only.
+   */
+  void fillHalo ( BoundaryPolicyEnum aMinPolicy,
+		  BoundaryPolicyEnum aMaxPolicy,
+		  real_t aMinValue = 0.0,
+		  real_t aMaxValue = 0.0 );
+
+  /**
+   * overwrite the derivative 'result' at the cells, where a stencil
+   * with the given offsets reaches into the halo, in the same way
+   * as the per-cell operators do (see BoundaryPolicy): zero for
+   * FLUXLESS, the constant value for CONSTANT, the derivative at
+   * the nearest inner cell for INTERPOLATED. For CYCLIC the halo
+   * cells are the cells of the other side, hence 'result' is kept.
+   */
+  void applyBoundaryPolicy ( real_t* result,
+			     int leftOffset,
+			     int rightOffset ) const;
+};
+
+
+/**
+ * Stencil kernels for the component 'component' of a lattice state,
+ * the halo cells must be filled. The boundary cells are handled as
+ * by the per-cell operators D<0>, D<0,0> and D<0,0,0>.
+ */
+inline void latticeD0_1d ( const LatticeState& u,
+			   int component,
+			   real_t* result,
+			   real_t deltaX )
+{
+  latticeD0_1d (u[component], result, u.numberOfCells, deltaX);
+  u.applyBoundaryPolicy (result, 1, 1);
+}
+
+inline void latticeD00_1d ( const LatticeState& u,
+			    int component,
+			    real_t* result,
+			    real_t deltaX )
+{
+  latticeD00_1d (u[component], result, u.numberOfCells, deltaX);
+  u.applyBoundaryPolicy (result, 1, 1);
+}
+
+inline void latticeD000_1d ( const LatticeState& u,
+			     int component,
+			     real_t* result,
+			     real_t deltaX )
+{
+  latticeD000_1d (u[component], result, u.numberOfCells, deltaX);
+  u.applyBoundaryPolicy (result, 2, 2);
+}
+
+#endif
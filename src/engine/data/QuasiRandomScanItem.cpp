@@ -0,0 +1,528 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#include "QuasiRandomScanItem.hpp"
+#include "data/ScannableObjects.hpp"
+#include "utils/noise/NoiseGenerator.hpp"
+#include "../utils/strconv/StringConverter.hpp"
+
+/* all integer arithmetic below is done modulo 2^32, 'unsigned int'
+   is assumed to have 32 bits. */
+
+/**
+ * primitive polynomials and initial direction numbers for the
+ * objects 2, ..., 16 of the Sobol sequence (Joe and Kuo, 2008):
+ * degree s, coefficients a, initial numbers m_1, ..., m_s.
+ * The first object uses the van der Corput sequence.
+ */
+static const int maxSobolObjects = 16;
+
+static const struct
+{
+  int s;
+  unsigned int a;
+  unsigned int m[6];
+} sobolInit[maxSobolObjects - 1] =
+  {
+    {1,  0, {1}},
+    {2,  1, {1, 3}},
+    {3,  1, {1, 3, 1}},
+    {3,  2, {1, 1, 1}},
+    {4,  1, {1, 1, 3, 3}},
+    {4,  4, {1, 3, 5, 13}},
+    {5,  2, {1, 1, 5, 5, 17}},
+    {5,  4, {1, 1, 5, 5, 5}},
+    {5,  7, {1, 1, 7, 11, 19}},
+    {5, 11, {1, 1, 5, 1, 1}},
+    {5, 13, {1, 1, 1, 3, 11}},
+    {5, 14, {1, 3, 5, 5, 31}},
+    {6,  1, {1, 3, 3, 9, 7, 49}},
+    {6, 13, {1, 1, 1, 15, 21, 21}},
+    {6, 16, {1, 3, 1, 13, 27, 49}}
+  };
+
+static unsigned int
+reverseBits (unsigned int x)
+{
+  x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+  x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+  x = ((x >> 4) & 0x0f0f0f0fu) | ((x & 0x0f0f0f0fu) << 4);
+  x = ((x >> 8) & 0x00ff00ffu) | ((x & 0x00ff00ffu) << 8);
+  return (x >> 16) | (x << 16);
+}
+
+static unsigned int
+hash (unsigned int x)
+{
+  x ^= x >> 16;
+  x *= 0x7feb352du;
+  x ^= x >> 15;
+  x *= 0x846ca68bu;
+  x ^= x >> 16;
+  return x;
+}
+
+/**
+ * Owen scrambling of the bits of x: each bit is flipped depending on
+ * a hash of all higher bits (Laine and Karras, Burley 2020).
+ */
+static unsigned int
+owenScramble (unsigned int x, unsigned int seed)
+{
+  x = reverseBits (x);
+
+  x += seed;
+  x ^= x * 0x6c50b47cu;
+  x ^= x * 0xb82f1e52u;
+  x ^= x * 0xc7afe638u;
+  x ^= x * 0x8d22f6e6u;
+
+  return reverseBits (x);
+}
+
+/**
+ * the image of i under a random permutation of {0, ..., l-1} given
+ * by the seed p, without storing the permutation (Kensler 2013).
+ */
+static unsigned int
+permute (unsigned int i, unsigned int l, unsigned int p)
+{
+  assert (l > 0);
+
+  unsigned int w = l - 1;
+  w |= w >> 1;
+  w |= w >> 2;
+  w |= w >> 4;
+  w |= w >> 8;
+  w |= w >> 16;
+
+  do
+  {
+    i ^= p;
+    i *= 0xe170893du;
+    i ^= p >> 16;
+    i ^= (i & w) >> 4;
+    i ^= p >> 8;
+    i *= 0x0929eb3fu;
+    i ^= p >> 23;
+    i ^= (i & w) >> 1;
+    i *= 1 | p >> 27;
+    i *= 0x6935fa69u;
+    i ^= (i & w) >> 11;
+    i *= 0x74dcb303u;
+    i ^= (i & w) >> 2;
+    i *= 0x9e501cc3u;
+    i ^= (i & w) >> 2;
+    i *= 0xc860a3dfu;
+    i &= w;
+    i ^= i >> 5;
+  } while (i >= l);
+
+  return (i + p) % l;
+}
+
+static const real_t two32 = 4294967296.0;
+
+
+QuasiRandomScanItem::
+QuasiRandomScanItem (Configuration& itemDescription)
+{
+  initialize (itemDescription);
+
+  reset ();
+}
+
+// virtual
+void
+QuasiRandomScanItem::
+initialize (Configuration& itemDescription)
+{
+  if (itemDescription.checkForEnumValue ("ITEM_TYPE_KEY", "SOBOL_KEY"))
+  {
+    sequenceType = SOBOL;
+  }
+  else if (itemDescription.checkForEnumValue ("ITEM_TYPE_KEY", "HALTON_KEY"))
+  {
+    sequenceType = HALTON;
+  }
+  else
+  {
+    assert (itemDescription.checkForEnumValue ("ITEM_TYPE_KEY",
+					       "LATIN_HYPERCUBE_KEY"));
+    sequenceType = LATIN_HYPERCUBE;
+  }
+
+  numPoints = itemDescription.getLong ("POINTS_KEY");
+  firstPoint = itemDescription.getLong ("FIRST_POINT_KEY");
+  isScrambled = itemDescription.getBool ("SCRAMBLING_KEY");
+  unsigned long seed = itemDescription.getLong ("SEED_KEY");
+
+  // parse the given configuration:
+  int numberOfSubitems = 0;
+  while (1)
+  {
+    string tmpStr =  string("SUBITEM")
+      + "[" + toString (numberOfSubitems) + "]";
+
+    if (! itemDescription.checkForKey (tmpStr))
+    {
+      break;
+    }
+
+    ++ numberOfSubitems;
+  }
+
+  if (numberOfSubitems <= 0)
+  {
+    cerr << "No subitem found! The quasi-random scan item "
+	 << "can not be constructed."
+	 << endl << Error::Exit;
+  }
+
+  // alloc the local arrays
+  objects.alloc (numberOfSubitems);
+  minValues.alloc (numberOfSubitems);
+  maxValues.alloc (numberOfSubitems);
+  currentValues.alloc (numberOfSubitems);
+
+  for (int j = 0; j < numberOfSubitems; ++j)
+  {
+    string tmpStr =  string("SUBITEM") + "[" + toString (j) + "]";
+
+    Configuration subitemDescription
+      = itemDescription.getSubConfiguration (tmpStr);
+
+    string objKey = subitemDescription.getString ("OBJECT_KEY");
+
+    objects[j] = scannableObjects.get<real_t> (objKey);
+
+    minValues[j] = subitemDescription.getReal ("MIN_KEY");
+    maxValues[j] = subitemDescription.getReal ("MAX_KEY");
+  }
+
+  seeds.resize (numberOfSubitems);
+  for (int j = 0; j < numberOfSubitems; ++j)
+  {
+    seeds[j] = hash (hash ((unsigned int) seed) + j);
+  }
+
+  this->check ();
+
+  if (sequenceType == SOBOL)
+  {
+    initSobol ();
+  }
+  else if (sequenceType == HALTON)
+  {
+    initHalton (seed);
+  }
+}
+
+void
+QuasiRandomScanItem::initSobol ()
+{
+  directions.resize (objects.getTotalSize ());
+
+  for (int j = 0; j < objects.getTotalSize (); ++j)
+  {
+    vector<unsigned int>& v = directions[j];
+    v.resize (32);
+
+    if (j == 0)
+    {
+      for (int k = 0; k < 32; ++k)
+	v[k] = 1u << (31 - k);
+
+      continue;
+    }
+
+    int s = sobolInit[j - 1].s;
+    unsigned int a = sobolInit[j - 1].a;
+
+    for (int k = 0; k < s; ++k)
+    {
+      v[k] = sobolInit[j - 1].m[k] << (31 - k);
+    }
+
+    for (int k = s; k < 32; ++k)
+    {
+      v[k] = v[k - s] ^ (v[k - s] >> s);
+
+      for (int l = 1; l < s; ++l)
+      {
+	if ((a >> (s - 1 - l)) & 1)
+	  v[k] ^= v[k - l];
+      }
+    }
+  }
+}
+
+void
+QuasiRandomScanItem::initHalton (unsigned long seed)
+{
+  int numberOfObjects = objects.getTotalSize ();
+
+  bases.clear ();
+  for (unsigned int p = 2; (int) bases.size () < numberOfObjects; ++p)
+  {
+    bool isPrime = true;
+    for (unsigned int k = 0; isPrime && (k < bases.size ()); ++k)
+    {
+      isPrime = (p % bases[k] != 0);
+    }
+
+    if (isPrime)
+      bases.push_back (p);
+  }
+
+  RandomNumberGenerator randomNumberGenerator ((long) seed);
+
+  permutations.resize (numberOfObjects);
+  for (int j = 0; j < numberOfObjects; ++j)
+  {
+    vector<unsigned int>& sigma = permutations[j];
+    sigma.resize (bases[j]);
+
+    for (unsigned int d = 0; d < bases[j]; ++d)
+      sigma[d] = d;
+
+    if (! isScrambled)
+      continue;
+
+    /* shuffle the non-zero digits, the zero digit is kept, so that
+       the radical inverse remains a finite sum: */
+    for (unsigned int d = bases[j] - 1; d > 1; --d)
+    {
+      unsigned int k = 1 + (unsigned int)
+	(randomNumberGenerator.ran1 () * d);
+      if (k > d)
+	k = d;
+
+      unsigned int tmp = sigma[d];
+      sigma[d] = sigma[k];
+      sigma[k] = tmp;
+    }
+  }
+}
+
+real_t
+QuasiRandomScanItem::sobol (unsigned long n, int i) const
+{
+  const vector<unsigned int>& v = directions[i];
+
+  unsigned int x = 0;
+  for (int k = 0; n != 0; ++k, n >>= 1)
+  {
+    if (n & 1)
+      x ^= v[k];
+  }
+
+  if (isScrambled)
+  {
+    return (owenScramble (x, seeds[i]) + 0.5) / two32;
+  }
+
+  return x / two32;
+}
+
+real_t
+QuasiRandomScanItem::halton (unsigned long n, int i) const
+{
+  const unsigned int b = bases[i];
+  const vector<unsigned int>& sigma = permutations[i];
+
+  real_t result = 0.0;
+  real_t f = 1.0 / b;
+
+  while (n > 0)
+  {
+    result += sigma[n % b] * f;
+    n /= b;
+    f /= b;
+  }
+
+  return result;
+}
+
+real_t
+QuasiRandomScanItem::latinHypercube (unsigned long n, int i) const
+{
+  unsigned int stratum = permute (n, numPoints, seeds[i]);
+
+  real_t offset = 0.5;
+  if (isScrambled)
+  {
+    offset = hash (seeds[i] ^ hash (n)) / two32;
+  }
+
+  return (stratum + offset) / numPoints;
+}
+
+// virtual
+void
+QuasiRandomScanItem::calc ()
+{
+  unsigned long n = firstPoint + index;
+
+  for (int i = 0; i < objects.getTotalSize (); ++i)
+  {
+    real_t u = 0.0;
+
+    switch (sequenceType)
+    {
+    case SOBOL:
+      u = sobol (n, i);
+      break;
+    case HALTON:
+      u = halton (n, i);
+      break;
+    case LATIN_HYPERCUBE:
+      u = latinHypercube (n, i);
+      break;
+    }
+
+    currentValues[i] = minValues[i] + u * (maxValues[i] - minValues[i]);
+  }
+}
+
+// virtual
+void
+QuasiRandomScanItem::
+operator>> (ostream& os) const
+{
+  os << *(objects[0]);
+
+  for (int i = 1; i < objects.getTotalSize (); ++i)
+  {
+    os << " "
+       << *(objects[i]);
+  }
+}
+
+// virtual
+void
+QuasiRandomScanItem::
+set ()
+{
+  for (int i = 0; i < objects.getTotalSize (); ++i)
+  {
+    *(objects[i]) = currentValues[i];
+  }
+}
+
+// virtual
+void
+QuasiRandomScanItem::
+get (ostream& os)
+{
+  for (int i = 0; i < objects.getTotalSize (); ++i)
+  {
+    os << currentValues[i] << endl;
+  }
+
+  os << index << endl;
+}
+
+// virtual
+void
+QuasiRandomScanItem::
+set (istream& is)
+{
+  for (int i = 0; i < objects.getTotalSize (); ++i)
+  {
+    is >> currentValues[i];
+  }
+
+  is >> index;
+
+  set ();
+}
+
+// virtual
+void
+QuasiRandomScanItem::
+reset (void)
+{
+  index = 0;
+
+  calc ();
+}
+
+// virtual
+bool
+QuasiRandomScanItem::
+check ()
+{
+  IndexableScanItem::check ();
+
+  if (firstPoint < 0)
+  {
+    cerr << "The first point of a quasi-random scan item can not be "
+	 << "negative. Current setting "
+	 << firstPoint
+	 << " not accepted."
+	 << endl << Error::Exit;
+  }
+
+  if ((sequenceType == LATIN_HYPERCUBE) && (firstPoint != 0))
+  {
+    cerr << "A latin hypercube can not be extended: "
+	 << "the first point must be 0."
+	 << endl << Error::Exit;
+  }
+
+  /* the end of the sequence must be an unsigned int, too
+     (e.g. the number of strata of a latin hypercube): */
+  if ((firstPoint + numPoints) > 0xffffffffL)
+  {
+    cerr << "Only less than 2^32 points of a quasi-random sequence "
+	 << "are supported."
+	 << endl << Error::Exit;
+  }
+
+  if ((sequenceType == SOBOL)
+      && (objects.getTotalSize () > maxSobolObjects))
+  {
+    cerr << "The Sobol sequence is supported for at most "
+	 << maxSobolObjects
+	 << " objects, "
+	 << objects.getTotalSize ()
+	 << " given."
+	 << endl << Error::Exit;
+  }
+
+  for (int i = 0; i < objects.getTotalSize (); ++i)
+  {
+    if (minValues[i] == maxValues[i])
+      cerr << "Minimal and maximal values of a scan item can not be equal. "
+	   << "Current setting of both values "
+	   << minValues[i]
+	   << " not accepted."
+	   << endl << Error::Exit;
+  }
+
+  return true;
+}
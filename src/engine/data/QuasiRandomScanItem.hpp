@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#ifndef QUASI_RANDOM_SCAN_ITEM_HPP
+#define QUASI_RANDOM_SCAN_ITEM_HPP
+
+#include <vector>
+using std::vector;
+
+#include "ScanData.hpp"
+
+/**
+ * Scan over a box in the space of several real objects by a point
+ * set, which fills the box evenly without a tensor-product grid:
+ * <UL>
+ * <LI> 'sobol': Sobol sequence (direction numbers of Joe and Kuo, up
+ *      to 16 objects), optionally with a hash-based Owen scrambling, </LI>
+ * <LI> 'halton': Halton sequence (the i-th prime as base of the i-th
+ *      object), optionally with random digit permutations, </LI>
+ * <LI> 'latin_hypercube': each object is divided into N strata, each
+ *      stratum is hit once. The strata are randomly permuted, the
+ *      points are jittered in the strata or (without scrambling)
+ *      centered. </LI>
+ * </UL>
+ * The n-th point is computed directly from n, hence the item is
+ * indexable (network runs, positioning by index) like all others.
+ * The user specifies the objects with their intervals as subitems,
+ * the number of points N and the first point number \f$ n_0 \f$;
+ * the points \f$ n_0, \ldots, n_0 + N - 1 \f$ are scanned. A Sobol or
+ * Halton set can be refined progressively: a run with
+ * \f$ n_0 = N \f$ adds the next N points to the points of a run with
+ * \f$ n_0 = 0 \f$ (the same seed given). A latin hypercube depends on
+ * N and can not be extended this way.
+ *
+ * @warning at the current stage, all objects are assumed to be real.
+ */
+class QuasiRandomScanItem
+  : public IndexableScanItem
+{
+private:
+  enum Sequence {SOBOL, HALTON, LATIN_HYPERCUBE};
+
+  Sequence sequenceType;
+
+  /** number of the point scanned at index 0 */
+  long firstPoint;
+
+  bool isScrambled;
+
+  /** pointers to objects to be varied */
+  Array<real_t*> objects;
+
+  /** intervals of the objects */
+  Array<real_t> minValues;
+  Array<real_t> maxValues;
+
+  /** current values of all scan objects */
+  Array<real_t> currentValues;
+
+  /** Sobol: 32 direction numbers for each object */
+  vector< vector<unsigned int> > directions;
+
+  /** Halton: bases and digit permutations for each object */
+  vector<unsigned int> bases;
+  vector< vector<unsigned int> > permutations;
+
+  /** seeds of the scrambling and the latin hypercube for each object */
+  vector<unsigned int> seeds;
+
+  void initSobol ();
+  void initHalton (unsigned long seed);
+
+  /** coordinate of the point n in the unit interval, for object i */
+  real_t sobol (unsigned long n, int i) const;
+  real_t halton (unsigned long n, int i) const;
+  real_t latinHypercube (unsigned long n, int i) const;
+
+public:
+  QuasiRandomScanItem (Configuration& itemDescription);
+
+  virtual void operator>> (ostream& os) const;
+  virtual void set ();
+
+  virtual void get (ostream& os);
+  virtual void set (istream& is);
+
+  virtual void reset (void);
+  virtual bool check ();
+
+  virtual void initialize (Configuration& itemDescription);
+  virtual void calc ();
+};
+
+#endif
@@ -24,12 +24,17 @@
  *
  */
 
+#include <vector>
+
 #include "config.h"
+#include "AnT-init.hpp"
 #include "data/ScannableObjects.hpp"
 #include "methods/output/IOStreamFactory.hpp"
 #include "network/ANPClient.hpp"
 #include "network/ANPServer.hpp"
 #include "ScanData.hpp"
+#include "AdaptiveScan.hpp"
+#include "QuasiRandomScanItem.hpp"
 #include "../utils/strconv/StringConverter.hpp"
 #include "utils/datareader/ExternalDataTypes.hpp"
 
@@ -81,6 +86,16 @@ ScanData::create (Configuration& scanDescription,
     }
     seq = new CAScanItemSequence (iterData);
   }
+  else if (scanDescription.checkForEnumValue ("SCAN_TYPE_KEY",
+					      "ADAPTIVE_SCAN_KEY"))
+  {
+    if ((aRunMode == SERVER) || (aRunMode == CLIENT))
+    {
+      cerr << "Only STANDALONE run mode supported for the adaptive "
+	   << "scan." << endl << Error::Exit;
+    }
+    seq = new AdaptiveScanItemSequence (iterData);
+  }
   else
   {
     cerr << "Unsupported scan type."
@@ -118,6 +133,28 @@ ScanData::create (Configuration& scanDescription,
 	 << endl
 	 << Error::Exit;
   }
+
+  // sharded standalone scan (see '--shard'):
+  if ( (AnT::numberOfShards > 1) && (seq->runMode == STANDALONE) )
+  {
+    if (! scanDescription.checkForEnumValue ("SCAN_TYPE_KEY",
+					     "NESTED_ITEMS_KEY"))
+    {
+      cerr << "Only the scan type 'nested_items' can be sharded."
+	   << endl << Error::Exit;
+    }
+
+    if (seq->scanMode == 0)
+    {
+      cerr << "A single run can not be sharded, "
+	   << "the option '--shard' is only for scan runs."
+	   << endl << Error::Exit;
+    }
+
+    seq->setShard (AnT::shardIndex,
+		   AnT::numberOfShards,
+		   AnT::isBlockSharding);
+  }
     
   return seq;
   debugMsg1("ScanData: created.");
@@ -133,9 +170,36 @@ ostream& operator<< (ostream& os, const ScanData& scanData)
 
 ScanItemSequence::ScanItemSequence (IterData* iterData)
   : ScanData (iterData),
-    firstCall (true)
+    firstCall (true),
+    pointNumber (0),
+    shardIndex (0),
+    numberOfShards (1),
+    isBlockSharding (false),
+    blockBegin (0),
+    blockEnd (0)
 {}
 
+void
+ScanItemSequence::setShard (long anIndex, long aNumber, bool blockSharding)
+{
+  assert ((0 <= anIndex) && (anIndex < aNumber));
+
+  shardIndex = anIndex;
+  numberOfShards = aNumber;
+  isBlockSharding = blockSharding;
+}
+
+bool
+ScanItemSequence::isForeignPoint ()
+{
+  if (isBlockSharding)
+  {
+    return (pointNumber < blockBegin);
+  }
+
+  return (pointNumber % numberOfShards != shardIndex);
+}
+
 //virtual 
 void 
 ScanItemSequence::operator>> (ostream& os) const
@@ -156,13 +220,40 @@ ScanItemSequence::standaloneScanNext ()
   if (firstCall) {
     // don't increment yet on the first call of this method
     firstCall = false;
-    set ();
-
-    return;
+    pointNumber = 0;
+
+    if (isBlockSharding) {
+      long numberOfPoints = 1;
+      for (seq_t::iterator i = sequence.begin ();
+	   i != sequence.end (); ++i)
+      {
+	numberOfPoints *= (*i)->getNumPoints ();
+      }
+
+      blockBegin = (numberOfPoints * shardIndex) / numberOfShards;
+      blockEnd = (numberOfPoints * (shardIndex + 1)) / numberOfShards;
+    }
+  } else {
+    // go to the next scanpoint, see if it is even valid
+    finalFlag = inc (); 
+    ++pointNumber;
   }
 
-  // go to the next scanpoint, see if it is even valid
-  finalFlag = inc (); 
+  if (numberOfShards > 1) {
+    // sharded scan: skip the scan points of the other shards
+    while ( (! finalFlag) && isForeignPoint () ) {
+      finalFlag = inc ();
+      ++pointNumber;
+    }
+
+    if (isBlockSharding && (pointNumber >= blockEnd)) {
+      finalFlag = true;
+    }
+
+    if (! finalFlag) {
+      ioStreamFactory->beginScanPoint (pointNumber);
+    }
+  }
 
   set ();
 }
@@ -226,6 +317,7 @@ void ScanItemSequence::reset ()
 {
   firstCall = true;
   finalFlag = false;
+  pointNumber = 0;
 
   for (seq_t::iterator i = sequence.begin ();
        i != sequence.end (); ++i)
@@ -389,6 +481,13 @@ AbstractScanItem::getItem (Configuration& scanDescription,
   { 
     return new FromFileScanItem (itemDescription);
   }
+  if ( itemDescription.checkForEnumValue ("ITEM_TYPE_KEY", "SOBOL_KEY")
+       || itemDescription.checkForEnumValue ("ITEM_TYPE_KEY", "HALTON_KEY")
+       || itemDescription.checkForEnumValue
+       ("ITEM_TYPE_KEY", "LATIN_HYPERCUBE_KEY") )
+  {
+    return new QuasiRandomScanItem (itemDescription);
+  }
   cerr << "An unrecognized setting '" 
        << itemDescription.getEnum ("ITEM_TYPE_KEY")
        << "' found at the key '"       
@@ -472,6 +571,14 @@ IndexableScanItem::check ()
   return true;
 }
 
+// virtual
+void
+IndexableScanItem::refine (long factor)
+{
+  cerr << "This kind of scan items can not be refined."
+       << endl << Error::Exit;
+}
+
 /* ***************************************************** */
 // virtual 
 template<typename ITEM_TYPE>
@@ -604,6 +711,15 @@ RealLinearScanItem::calc ()
   currentValue = minValue + index * step; 
 }
 
+// virtual
+void
+RealLinearScanItem::refine (long factor)
+{
+  index *= factor;
+  numPoints = (numPoints - 1) * factor + 1;
+  step = (maxValue - minValue) / (numPoints - 1);
+}
+
 /* ***************************************************** */
 RealLogarithmicScanItem::
 RealLogarithmicScanItem (Configuration& itemDescription) : 
@@ -637,6 +753,15 @@ RealLogarithmicScanItem::calc ()
   currentValue = exp (log(minValue) + index * step); 
 }
 
+// virtual
+void
+RealLogarithmicScanItem::refine (long factor)
+{
+  index *= factor;
+  numPoints = (numPoints - 1) * factor + 1;
+  step = (log(maxValue) - log(minValue)) / (numPoints - 1);
+}
+
 /* ***************************************************** */
 IntegerLinearScanItem::
 IntegerLinearScanItem (Configuration& itemDescription) :
@@ -804,6 +929,16 @@ TwoDimensionalRealLinearScanItem::calc ()
   currentValue2 = minValue2 + index * step2; 
 }
 
+// virtual
+void
+TwoDimensionalRealLinearScanItem::refine (long factor)
+{
+  index *= factor;
+  numPoints = (numPoints - 1) * factor + 1;
+  step1 = (maxValue1 - minValue1) / (numPoints - 1);
+  step2 = (maxValue2 - minValue2) / (numPoints - 1);
+}
+
 //virtual 
 void 
 TwoDimensionalRealLinearScanItem::
@@ -1007,47 +1142,11 @@ FromFileScanItem::
 reset (void)
 {
   index = 0;
-  
-  if (externalDataReader != NULL)
-  {
-    delete externalDataReader;
-  }
-
-  // reopen the file
-  externalDataReader = new ExternalDataReader ();
-  initExternalDataReader (fileName, numberOfColumns);
 
-  for (int i = 0; i < objects.getTotalSize (); ++i)
+  if (numPoints > 0)
   {
-    externalDataReader->addParameter (dataColumns[i], 
-				      ExternalDataTypes::ptFloat);
-  }
-
-  // read the first row:
-
-  // IT SEEMS TO BE A BUG of the externalDataReader, but without this
-  // call of 'existsData ()' it does not work correctly. The getFloatParam
-  // returns then 0 instead of the values from the file. Very strange!
-  if (! externalDataReader->existsData ())
-  {
-    return;
-  }
-
-  for (int i = 0; i < objects.getTotalSize (); ++i)
-  {
-    currentValues[i] 
-      = externalDataReader->getFloatParam (i+1); 
-
-#if DEBUG__FROM_FILE_SCAN_ITEM
-    cout << "currentValues["
-	 << i
-	 << "] = "
-	 <<  currentValues[i]
-	 << endl;
-#endif
+    calc ();
   }
-
-  externalDataReader->next(); // go to the next row
 }
 
 // virtual 
@@ -1060,12 +1159,48 @@ check ()
 
 void  
 FromFileScanItem::
-initExternalDataReader (string fileName, int numberOfColumns)
+loadValues ()
 {
   assert (numberOfColumns > 0);
-  externalDataReader->init (fileName.c_str (), numberOfColumns);
-  externalDataReader->errorOnEmptyRow = false;
-  externalDataReader->throwExceptionOnBadRow = true; //termination on error
+
+  ExternalDataReader externalDataReader;
+
+  // the rows are parsed in place, only the used columns are kept
+  externalDataReader.init (fileName.c_str (), 
+			   numberOfColumns, 
+			   ExternalDataTypes::ifMappedAscii);
+  externalDataReader.errorOnEmptyRow = false;
+  externalDataReader.throwExceptionOnBadRow = true; //termination on error
+
+  int numberOfObjects = objects.getTotalSize ();
+
+  for (int i = 0; i < numberOfObjects; ++i)
+  {
+    externalDataReader.addParameter (dataColumns[i], 
+				     ExternalDataTypes::ptFloat);
+  }
+
+  std::vector<real_t> rows;
+
+  while (externalDataReader.existsData ())
+  {
+    for (int i = 0; i < numberOfObjects; ++i)
+    {
+      rows.push_back (externalDataReader.getFloatParam (i+1));
+    }
+
+    externalDataReader.next ();
+  }
+
+  numPoints = rows.size () / numberOfObjects;
+  //: number of lines counted;
+
+  values.alloc (rows.size ());
+
+  for (int k = 0; k < values.getTotalSize (); ++k)
+  {
+    values[k] = rows[k];
+  }
 }
 
 
@@ -1110,38 +1245,6 @@ initialize (Configuration& itemDescription)
 	 << endl << Error::Exit;
   }
 
-  // check the data file and count the number of lines
-  externalDataReader = new ExternalDataReader ();
-  initExternalDataReader (fileName, numberOfColumns);
-
-  // dummy
-  externalDataReader->addParameter (1, ExternalDataTypes::ptFloat); 
-
-#if DEBUG__FROM_FILE_SCAN_ITEM
-  cout << "count the lines... "
-       << endl;
-#endif
-
-  real_t dummy;
-  long numberOfLines = 0;
-  while (externalDataReader->existsData ())
-  {
-    dummy = externalDataReader->getFloatParam (1);
-    ++numberOfLines;
-    externalDataReader->next ();
-  }
-
-  delete externalDataReader;
-  externalDataReader = NULL;
-
-  numPoints = numberOfLines;
-  //: number of lines counted;
-#if DEBUG__FROM_FILE_SCAN_ITEM
-  cout << "number of lines: "
-       << numPoints
-       << endl;
-#endif
-
   // parse the given configuration:
   int numberOfSubitems = 0;
   while (1)
@@ -1194,24 +1297,26 @@ initialize (Configuration& itemDescription)
 	 << dataColumns
 	 << endl;
 #endif
+
+  // read the data file
+  loadValues ();
+
+#if DEBUG__FROM_FILE_SCAN_ITEM
+  cout << "number of lines: "
+       << numPoints
+       << endl;
+#endif
 }
 
 // virtual 
 void
 FromFileScanItem::calc ()
 {
-  if (! externalDataReader->existsData ())
-  {
-    return;
-  }
+  int numberOfObjects = objects.getTotalSize ();
 
-  // read the next row:
-  for (int i = 0; i < objects.getTotalSize (); ++i)
+  for (int i = 0; i < numberOfObjects; ++i)
   {
-    currentValues[i] = 
-      externalDataReader->getFloatParam (i+1); 
+    currentValues[i] = values[index * numberOfObjects + i];
   }
-
-  externalDataReader->next (); // go to the next row
 }
 
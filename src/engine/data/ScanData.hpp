@@ -181,9 +181,39 @@ protected:
   bool inc ();
   void set ();
 
+  /**
+   * number of the current scan point in the canonical scan order
+   * (first item fastest), counted in 'standaloneScanNext'.
+   */
+  long pointNumber;
+
+  /**
+   * sharded standalone scan: the shard 'shardIndex' of
+   * 'numberOfShards' simulates only the points with
+   * pointNumber % numberOfShards == shardIndex, or, if
+   * 'isBlockSharding', the shardIndex-th of numberOfShards
+   * contiguous blocks of points. No sharding for one shard.
+   */
+  long shardIndex;
+  long numberOfShards;
+  bool isBlockSharding;
+
+  /** block of the own points (block sharding only) */
+  long blockBegin;
+  long blockEnd;
+
+  /** true, if the current point belongs to another shard */
+  bool isForeignPoint ();
+
 public:
   void reset ();
 
+  /**
+   * set the shard of a sharded standalone scan.
+   * Will be called in 'ScanData::create'.
+   */
+  void setShard (long anIndex, long aNumber, bool blockSharding);
+
   typedef list<AbstractScanItem*> seq_t;
   seq_t sequence;
 
@@ -329,6 +359,16 @@ public:
   virtual bool inc ();
   virtual bool dec ();
   virtual bool check ();
+
+  /**
+   * refine the item by the given factor: each interval between two
+   * scan points is divided into 'factor' intervals, hence the number
+   * of points becomes \f$ (N-1) \cdot factor + 1 \f$ and the scan
+   * point with the old index i gets the index \f$ i \cdot factor \f$.
+   * Used by the adaptive scan. Not supported by default.
+   */
+  virtual void refine (long factor);
+
   virtual ~IndexableScanItem () {}
 };
 
@@ -399,6 +439,8 @@ private:
 
 public:
   RealLinearScanItem (Configuration& itemDescription);
+
+  virtual void refine (long factor);
 }; /* class RealLinearScanItem */
 
 
@@ -420,6 +462,8 @@ private:
 
 public:
   RealLogarithmicScanItem (Configuration& itemDescription);
+
+  virtual void refine (long factor);
 }; /* class RealLogarithmicScanItem */
 
 
@@ -595,6 +639,8 @@ public:
    */
   virtual void initialize (Configuration& itemDescription);
 
+  virtual void refine (long factor);
+
   virtual ~TwoDimensionalRealLinearScanItem ();
 }; /* BasicScanItem */
 
@@ -721,6 +767,11 @@ public:
  * objects can be varied. The user has to specify the number of
  * columns in the file, the indeces of columns which must be used as
  * scan objects and the names of objects to be varied.
+ *
+ * The file is parsed once during the initialization and the used
+ * columns are kept in memory, so that each scan point is available
+ * by its index without any I/O during the scan. Hence the item can
+ * be stepped in both directions and positioned directly.
  * 
  * @warning at the current stage, all objects are assumed to be real.
  *
@@ -732,19 +783,20 @@ class FromFileScanItem
 {
 private:
   /**
-   * file name, set in constructor, needed by 'reset'
+   * file name, set in constructor
    * */
   string fileName;
 
   /**
-   * number of columns inn the file, set in constructor, needed by 'reset'
+   * number of columns inn the file, set in constructor
    * */
   int numberOfColumns;
 
   /**
-   * reads the external file.
+   * values of the used columns, row by row: the value for the i-th
+   * object at the scan point k is values[k * objects.getTotalSize () + i]
    * */
-  ExternalDataReader* externalDataReader;
+  Array<real_t> values;
 
   /**
    * pointers to objects to be varied
@@ -762,7 +814,11 @@ private:
    * */
   Array<int> dataColumns;
 
-  void initExternalDataReader (string fileName, int numberOfColumns);
+  /**
+   * reads all rows of the external file into 'values'
+   * and sets the number of scan points.
+   * */
+  void loadValues ();
 
 public:
   FromFileScanItem (Configuration& itemDescription);
@@ -0,0 +1,80 @@
+/* 
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ * 
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ * 
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#include "CompiledODE_Integrator.hpp"
+
+CompiledODE_Integrator::
+CompiledODE_Integrator ( ODE_Proxy& aProxy,
+			 ODE_Data& aData,
+			 const string& name ) :
+  ODE_Integrator (aProxy, name),
+  data (aData)
+{}
+
+// static
+ODE_Integrator* 
+CompiledODE_Integrator::get (Configuration& integrationDescription,
+			     ODE_Proxy& odeProxy,
+			     ODE_Data& odeData)
+{
+  string integrationMethodStr = integrationDescription
+    .getEnum ("METHOD_KEY");
+
+  if (integrationDescription.checkForEnumValue ("METHOD_KEY",
+						"EULER_FORWARD_KEY"))
+    {
+      return new
+	CompiledODE_EulerForward ( odeProxy,
+				   odeData,
+				   integrationMethodStr );
+    }
+  if (integrationDescription.checkForEnumValue ("METHOD_KEY",
+						"HEUN_KEY"))
+    {
+      return new
+	CompiledODE_Heun ( odeProxy,
+			   odeData,
+			   integrationMethodStr );
+    }
+  if (integrationDescription.checkForEnumValue ("METHOD_KEY",
+						"MIDPOINT_KEY"))
+    {
+      return new
+	CompiledODE_Midpoint ( odeProxy,
+			       odeData,
+			       integrationMethodStr );
+    }
+  if (integrationDescription.checkForEnumValue ("METHOD_KEY",
+						"RK44_KEY"))
+    {
+      return new
+	CompiledODE_RK44 ( odeProxy,
+			   odeData,
+			   integrationMethodStr );
+    }
+
+  return NULL;
+}
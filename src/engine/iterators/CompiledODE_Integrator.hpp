@@ -0,0 +1,319 @@
+/* 
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ * 
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ * 
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#ifndef COMPILED_ODE_INTEGRATOR_HPP
+#define COMPILED_ODE_INTEGRATOR_HPP
+
+#include "ODE_Integrator.hpp"
+#include "proxies/ODE_Proxy.hpp"
+
+/**
+ * Integrators for ODEs given by a compiled system function (a system
+ * plugin). They are used by the 'ODE_Simulator' for the orbit of the
+ * system.
+ *
+ * The stepper is a template parameter and calls the system function
+ * directly through the function pointer 'ODE_Proxy::systemFunction'.
+ * The ODE data is bound at construction, so there is neither a virtual
+ * proxy call nor a down cast within a step. The steppers work on the
+ * raw buffers of the states and perform exactly the same arithmetic as
+ * their counterparts in 'ODE_Integrator.hpp', hence the orbits are
+ * identical.
+ *
+ * Only explicit one-step methods without step size adaption have a
+ * compiled variant.
+ */
+class CompiledODE_Integrator : public ODE_Integrator
+{
+protected:
+  ODE_Data& data;
+
+  CompiledODE_Integrator ( ODE_Proxy& aProxy,
+			   ODE_Data& aData,
+			   const string& name );
+
+public:
+  /**
+   * Create a compiled integrator for the current integration method
+   * (factory).
+   * @return NULL, if the method has no compiled variant.
+   */
+  static ODE_Integrator* get (Configuration& methodDescription,
+			      ODE_Proxy& odeProxy,
+			      ODE_Data& odeData);
+};
+
+
+/**
+ * @param Stepper_t one of the 'CompiledODE_...Stepper' classes
+ */
+template <class Stepper_t>
+class BasicCompiledODE_Integrator : public CompiledODE_Integrator
+{
+private:
+  Stepper_t stepper;
+
+public:
+  BasicCompiledODE_Integrator ( ODE_Proxy& aProxy,
+				ODE_Data& aData,
+				const string& name ) :
+    CompiledODE_Integrator (aProxy, aData, name),
+    stepper (aData.getStateSpaceDim ())
+  {}
+
+  /**
+   * the same as 'ODE_Integrator::execute'
+   */
+  virtual void execute (IterData& iterData)
+  {
+    Array<real_t>& parameters = data.parameters.getValues ();
+    proxy.setParameters (&parameters);
+
+    Array<real_t>& nextState = data.orbit.getNext ();
+
+    bool ok = stepper.perform ( ODE_Proxy::systemFunction,
+				parameters,
+				data.dt,
+				data.orbit[0],
+				nextState );
+
+    data.orbit.addNext ();
+
+    if (! ok) iterData.finalFlag = true;
+  }
+
+  virtual bool perform (ODE_Data& aData, Array<real_t>& nextState)
+  {
+    return stepper.perform ( ODE_Proxy::systemFunction,
+			     aData.parameters.getValues (),
+			     aData.dt,
+			     aData.orbit[0],
+			     nextState );
+  }
+};
+
+
+/* *****************
+ * compiled steppers
+ * ***************** */
+
+/**
+ * @see ODE_EulerForwardStepper
+ */
+class CompiledODE_EulerForwardStepper
+{
+public:
+  CompiledODE_EulerForwardStepper (long stateSpaceDim)
+  {}
+
+  inline bool perform ( ODE_Proxy::SystemFunction* f,
+			const Array<real_t>& parameters,
+			real_t stepSize,
+			const Array<real_t>& inState,
+			Array<real_t>& outState )
+  {
+    if (! (*f) (inState, parameters, outState)) 
+      return false;
+
+    const long n = outState.getTotalSize ();
+    const real_t* x = &(inState[0]);
+    real_t* y = &(outState[0]);
+
+    for (long i = 0; i < n; ++i)
+      y[i] = x[i] + stepSize * y[i];
+
+    return true;
+  }
+};
+
+/**
+ * @see ODE_HeunStepper
+ */
+class CompiledODE_HeunStepper
+{
+private:
+  Array<real_t> iState;
+  Array<real_t> iFState0;
+
+public:
+  CompiledODE_HeunStepper (long stateSpaceDim) :
+    iState (stateSpaceDim),
+    iFState0 (stateSpaceDim)
+  {}
+
+  inline bool perform ( ODE_Proxy::SystemFunction* f,
+			const Array<real_t>& parameters,
+			real_t stepSize,
+			const Array<real_t>& inState,
+			Array<real_t>& outState )
+  {
+    const long n = outState.getTotalSize ();
+    const real_t* x = &(inState[0]);
+    real_t* y = &(outState[0]);
+    real_t* s = &(iState[0]);
+    real_t* k0 = &(iFState0[0]);
+
+    if (! (*f) (inState, parameters, iFState0)) 
+      return false;
+
+    for (long i = 0; i < n; ++i)
+      s[i] = x[i] + stepSize * k0[i];
+
+    if (! (*f) (iState, parameters, outState)) 
+      return false;
+
+    for (long i = 0; i < n; ++i)
+      y[i] = x[i] + stepSize/2.0 * (k0[i] + y[i]);
+
+    return true;
+  }
+};
+
+/**
+ * @see ODE_MidpointStepper
+ */
+class CompiledODE_MidpointStepper
+{
+private:
+  Array<real_t> iState;
+  Array<real_t> iFState0;
+
+public:
+  CompiledODE_MidpointStepper (long stateSpaceDim) :
+    iState (stateSpaceDim),
+    iFState0 (stateSpaceDim)
+  {}
+
+  inline bool perform ( ODE_Proxy::SystemFunction* f,
+			const Array<real_t>& parameters,
+			real_t stepSize,
+			const Array<real_t>& inState,
+			Array<real_t>& outState )
+  {
+    const long n = outState.getTotalSize ();
+    const real_t* x = &(inState[0]);
+    real_t* y = &(outState[0]);
+    real_t* s = &(iState[0]);
+    real_t* k0 = &(iFState0[0]);
+
+    if (! (*f) (inState, parameters, iFState0)) 
+      return false;
+
+    for (long i = 0; i < n; ++i)
+      s[i] = x[i] + stepSize/2.0 * k0[i];
+
+    if (! (*f) (iState, parameters, outState)) 
+      return false;
+
+    for (long i = 0; i < n; ++i)
+      y[i] = x[i] + stepSize * y[i];
+
+    return true;
+  }
+};
+
+/**
+ * @see ODE_RK44_Stepper
+ */
+class CompiledODE_RK44_Stepper
+{
+private:
+  Array<real_t> iState;
+  Array<real_t> iFState0;
+  Array<real_t> iFState1;
+  Array<real_t> iFState2;
+  Array<real_t> iFState3;
+
+public:
+  CompiledODE_RK44_Stepper (long stateSpaceDim) :
+    iState (stateSpaceDim),
+    iFState0 (stateSpaceDim),
+    iFState1 (stateSpaceDim),
+    iFState2 (stateSpaceDim),
+    iFState3 (stateSpaceDim)
+  {}
+
+  inline bool perform ( ODE_Proxy::SystemFunction* f,
+			const Array<real_t>& parameters,
+			real_t stepSize,
+			const Array<real_t>& inState,
+			Array<real_t>& outState )
+  {
+    const long n = outState.getTotalSize ();
+    const real_t* x = &(inState[0]);
+    real_t* y = &(outState[0]);
+    real_t* s = &(iState[0]);
+    real_t* k0 = &(iFState0[0]);
+    real_t* k1 = &(iFState1[0]);
+    real_t* k2 = &(iFState2[0]);
+    real_t* k3 = &(iFState3[0]);
+
+    if (! (*f) (inState, parameters, iFState0)) 
+      return false;
+
+    for (long i = 0; i < n; ++i)
+      s[i] = x[i] + stepSize/2.0 * k0[i];
+
+    if (! (*f) (iState, parameters, iFState1)) 
+      return false;
+
+    for (long i = 0; i < n; ++i)
+      s[i] = x[i] + stepSize/2.0 * k1[i];
+
+    if (! (*f) (iState, parameters, iFState2)) 
+      return false;
+
+    for (long i = 0; i < n; ++i)
+      s[i] = x[i] + stepSize * k2[i];
+
+    if (! (*f) (iState, parameters, iFState3)) 
+      return false;
+
+    for (long i = 0; i < n; ++i)
+      y[i] = x[i] + stepSize/6.0 * 
+	( k0[i] + 2.0 * k1[i] + 2.0 * k2[i] + k3[i] );
+
+    return true;
+  }
+};
+
+typedef 
+BasicCompiledODE_Integrator<CompiledODE_EulerForwardStepper> 
+CompiledODE_EulerForward;
+
+typedef 
+BasicCompiledODE_Integrator<CompiledODE_HeunStepper> 
+CompiledODE_Heun;
+
+typedef 
+BasicCompiledODE_Integrator<CompiledODE_MidpointStepper> 
+CompiledODE_Midpoint;
+
+typedef 
+BasicCompiledODE_Integrator<CompiledODE_RK44_Stepper> 
+CompiledODE_RK44;
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#include <cmath>
+
+#include "ConvergenceMonitor.hpp"
+#include "data/DynSysData.hpp"
+
+ConvergenceMonitor::
+ConvergenceMonitor (Iterator& anIterator,
+		    DiscreteTimeType aTransient,
+		    long aMaxPeriod,
+		    real_t aPrecision,
+		    action_t anAction) :
+  IterTransition ("convergence monitor"),
+  iterator (anIterator),
+  transient (aTransient),
+  maxPeriod (aMaxPeriod),
+  precision (aPrecision),
+  action (anAction),
+  period (0),
+  lastPeriod (0),
+  lastDeviation (0.0)
+{}
+
+real_t
+ConvergenceMonitor::
+getDeviation (const CyclicArray<Array<real_t> >& orbit,
+	      long p) const
+{
+  real_t deviation = 0.0;
+
+  for (long k = 0; k < maxPeriod; ++k)
+    {
+      const Array<real_t>& x = orbit[-k];
+      const Array<real_t>& y = orbit[-k - p];
+
+      for (long i = 0; i < x.getTotalSize (); ++i)
+	{
+	  real_t d = fabs (x[i] - y[i]);
+
+	  // '!(d <= ...)' catches NaNs as well
+	  if (! (d <= deviation))
+	    {
+	      if (! (d < precision))
+		return d;
+
+	      deviation = d;
+	    }
+	}
+    }
+
+  return deviation;
+}
+
+// virtual
+void
+ConvergenceMonitor::execute (IterData& iterData)
+{
+  DynSysData& data = iterData.dynSysData;
+
+  if (period > 0)
+    {
+      // replay mode: x(t+1) = x(t+1-p), the system function
+      // is not called anymore.
+      data.orbit.getNext () = data.orbit[1 - period];
+      data.orbit.addNext ();
+      return;
+    }
+
+  iterator.execute (iterData);
+
+  if (iterData.finalFlag)
+    return;
+
+  DiscreteTimeType t = data.timer.getCurrentTime () + 1;
+
+  if ( (t < transient) || ((t - transient) % maxPeriod != 0) )
+    return;
+
+  if (data.orbit.getCurrentSize () < 2 * maxPeriod)
+    return;
+
+  for (long p = 1; p <= maxPeriod; ++p)
+    {
+      real_t deviation = getDeviation (data.orbit, p);
+
+      if (! (deviation < precision))
+	continue;
+
+      bool settled = (p == lastPeriod) 
+	&& (deviation >= 0.5 * lastDeviation);
+
+      lastPeriod = p;
+      lastDeviation = deviation;
+
+      if (settled)
+	{
+	  if (action == STOP)
+	    iterData.finalFlag = true;
+	  else
+	    period = p;
+	}
+
+      return;
+    }
+
+  lastPeriod = 0;
+}
+
+void
+ConvergenceMonitor::reset ()
+{
+  period = 0;
+  lastPeriod = 0;
+  lastDeviation = 0.0;
+}
+
+long
+ConvergenceMonitor::leastOrbitSize () const
+{
+  return 2 * maxPeriod;
+}
+
+long
+ConvergenceMonitor::getPeriod () const
+{
+  return period;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#ifndef CONVERGENCE_MONITOR_HPP
+#define CONVERGENCE_MONITOR_HPP
+
+#include "Iterator.hpp"
+
+/**
+ * Wrapper around the iterator of a dynamical system, which watches
+ * the orbit for settling onto a fixed point or a short cycle.
+ *
+ * After the transient, the last states of the orbit are compared
+ * (maximum norm) every 'maxPeriod' steps. If the last 'maxPeriod'
+ * states repeat themselves with the period p <= 'maxPeriod' up to
+ * 'precision' at two successive checks, and the deviation did not
+ * shrink noticeably inbetween, the orbit is assumed to be settled.
+ * The second condition rejects slowly converging orbits near
+ * bifurcation points, which would be frozen with a wrong period
+ * otherwise. Depending on the configured action, the iteration is
+ * then either stopped (via 'finalFlag' of the 'iterData') or the
+ * cycle is replayed, i.e. the next state is copied from the orbit
+ * p steps ago instead of calling the system function. The timer and
+ * all methods are running further in the replay mode, hence all
+ * methods, which evaluate only the states of the orbit (periods,
+ * bifurcation diagrams, statistics, saving) get the same results
+ * as before.
+ *
+ * @warning the replay mode is not suitable for methods using
+ * the linearization of the system function along the orbit
+ * (Lyapunov exponents etc.).
+ */
+class ConvergenceMonitor : public IterTransition
+{
+public:
+  enum action_t {STOP, REPLAY};
+
+private:
+  Iterator& iterator;
+
+  DiscreteTimeType transient;
+  long maxPeriod;
+  real_t precision;
+  action_t action;
+
+  /** detected period, zero as long as the orbit is not settled. */
+  long period;
+
+  /** candidate period and its deviation at the previous check */
+  long lastPeriod;
+  real_t lastDeviation;
+
+  /**
+   * @return the maximal deviation of the last 'maxPeriod' states
+   * from their predecessors 'p' steps ago.
+   */
+  real_t getDeviation (const CyclicArray<Array<real_t> >& orbit,
+		       long p) const;
+
+public:
+  ConvergenceMonitor (Iterator& anIterator,
+		      DiscreteTimeType aTransient,
+		      long aMaxPeriod,
+		      real_t aPrecision,
+		      action_t anAction);
+
+  /**
+   * iterate the dynamical system by the wrapped iterator (or
+   * replay the detected cycle) and check for settling.
+   */
+  virtual void execute (IterData& iterData);
+
+  /**
+   * forget the detected period, to be called before each
+   * iteration run (i.e. for each scan point).
+   */
+  void reset ();
+
+  /**
+   * number of states needed for the comparison: the last
+   * 'maxPeriod' states and their predecessors 'maxPeriod' steps ago.
+   */
+  long leastOrbitSize () const;
+
+  /**
+   * @return the detected period or zero, if the orbit
+   * was not (yet) recognized to be settled.
+   */
+  long getPeriod () const;
+};
+
+#endif
@@ -44,6 +44,26 @@ DDE_Integrator::get (Configuration& integrationDescription,
   string integrationMethodStr = integrationDescription
     .getEnum ("METHOD_KEY");
 
+  if ( integrationDescription.checkForKey ("DENSE_OUTPUT_KEY")
+       && integrationDescription.getBool ("DENSE_OUTPUT_KEY") )
+    {
+      if (integrationDescription.checkForEnumValue ( "METHOD_KEY",
+						     "RK44_KEY" ))
+	{
+	  return new 
+	    DDE_DenseRK44 ( ddeProxy,
+			    ddeData,
+			    integrationDescription,
+			    integrationMethodStr );
+	}
+
+      cerr << "Dense output is implemented for the integration method '"
+	   << "rk44' only, not for '"
+	   << integrationMethodStr
+	   << "'."
+	   << endl << Error::Exit;
+    }
+
   if (integrationDescription.checkForEnumValue ( "METHOD_KEY",
 						 "EULER_FORWARD_KEY" ))
     {
@@ -1373,3 +1393,139 @@ bool DDE_AdamsMoultonStepper::perform (AbstractDDE_Proxy& proxy,
 
   return true;
 }
+
+
+DDE_DenseRK44::
+DDE_DenseRK44 (AbstractDDE_Proxy& aProxy,
+	       DDE_Data& ddeData,
+	       Configuration& integrationMethodDescription,
+	       string name) :
+  DDE_Integrator (aProxy, ddeData, name),
+  history (ddeData.getStateSpaceDim (), ddeData.dt, ddeData.maxDelay),
+  historyIsValid (false),
+  tau (ddeData.tau),
+  iState (ddeData.getStateSpaceDim ()),
+  iDelayState (ddeData.getStateSpaceDim ()),
+  k1 (ddeData.getStateSpaceDim ()),
+  k2 (ddeData.getStateSpaceDim ()),
+  k3 (ddeData.getStateSpaceDim ()),
+  k4 (ddeData.getStateSpaceDim ())
+{
+  proxy.setDelayHistory (&history);
+}
+
+// virtual
+long 
+DDE_DenseRK44::
+leastOrbitSize ()
+{
+  return 1;
+}
+
+// virtual
+void 
+DDE_DenseRK44::
+reset ()
+{
+  historyIsValid = false;
+}
+
+void 
+DDE_DenseRK44::
+initHistory (DDE_Data& data)
+{
+  history.clear ();
+
+  // the initial states are saved at the times 0, -dt, ... back to the
+  // maximal delay
+  long n = data.getSystemMemoryLength ();
+  if (n > history.getCapacity ())
+    n = history.getCapacity ();
+
+  // derivatives of the initial function by finite differences:
+  for (long k = 0; k < n; ++k)
+    {
+      const Array<real_t>& newer = data.orbit[(k > 0) ? -k + 1 : 0];
+      const Array<real_t>& older = data.orbit[(k < n - 1) ? -k - 1 : -k];
+      real_t width = data.dt * ( ((k > 0) ? 1 : 0) 
+				 + ((k < n - 1) ? 1 : 0) );
+
+      for (long i = 0; i < k1.getTotalSize (); ++i)
+	k1[i] = (width > 0.0) ? (newer[i] - older[i]) / width : 0.0;
+
+      history.addOldState (data.orbit[-k], k1);
+    }
+
+  historyIsValid = true;
+}
+
+bool 
+DDE_DenseRK44::
+callStage (real_t stageOffset,
+	   Array<real_t>& stageState,
+	   Array<real_t>& rhs)
+{
+  history.setStageOffset (stageOffset);
+  history.getState (tau, iDelayState);
+
+  proxy.setCurrentState (&stageState);
+  proxy.setDelayState (&iDelayState);
+  proxy.setRHS (&rhs);
+
+  return proxy.callSystemFunction ();
+}
+
+// virtual
+bool 
+DDE_DenseRK44::
+perform (DDE_Data& data, Array<real_t>& nextState)
+{
+  bool firstStep = ! historyIsValid;
+
+  if (firstStep)
+    initHistory (data);
+
+  real_t h = data.dt;
+  Array<real_t>& currentState = data.orbit[0];
+  long stateSpaceDim = currentState.getTotalSize ();
+
+  if (! callStage (0.0, currentState, k1))
+    return false;
+
+  // at the begin of the orbit the derivative is usually not
+  // continuous, the left one belongs to the initial function:
+  if (firstStep)
+    history.setNewestRightSlope (k1);
+  else
+    history.setNewestSlope (k1);
+
+  for (long i = 0; i < stateSpaceDim; ++i)
+    iState[i] = currentState[i] + 0.5 * h * k1[i];
+
+  if (! callStage (0.5 * h, iState, k2))
+    return false;
+
+  for (long i = 0; i < stateSpaceDim; ++i)
+    iState[i] = currentState[i] + 0.5 * h * k2[i];
+
+  if (! callStage (0.5 * h, iState, k3))
+    return false;
+
+  for (long i = 0; i < stateSpaceDim; ++i)
+    iState[i] = currentState[i] + h * k3[i];
+
+  if (! callStage (h, iState, k4))
+    return false;
+
+  for (long i = 0; i < stateSpaceDim; ++i)
+    nextState[i] = currentState[i] 
+      + h / 6.0 * (k1[i] + 2.0 * k2[i] + 2.0 * k3[i] + k4[i]);
+
+  // the derivative 'k4' is an approximation at the new point; it will
+  // be replaced by the first stage of the next step.
+  history.addState (nextState, k4);
+  history.setStageOffset (0.0);
+
+  return true;
+}
+
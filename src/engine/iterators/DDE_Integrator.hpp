@@ -1973,6 +1973,64 @@ public:
     {}
 };
 
+
+/**
+ * Classical Runge-Kutta method (RK44) with dense output. Instead of
+ * the linear interpolation between two states of the orbit, the
+ * delayed states of the stages are evaluated from a DelayHistory,
+ * which saves the state and the derivative at each grid point and
+ * interpolates by cubic Hermite polynomials. Hence the delay need not
+ * be a multiple of the step size, multiple and state-dependent
+ * delays are possible (see DDE_Proxy::HistorySystemFunction), and
+ * the interpolation error \f$O(h^4)\f$ matches the order of the
+ * method.
+ *
+ * The derivative at the current state is the first stage of the
+ * next step, hence four evaluations of the system function per step
+ * are needed, as for the classical method.
+ */
+class DDE_DenseRK44 : public DDE_Integrator
+{
+private:
+  DelayHistory history;
+
+  /** the history is filled from the initial states at the first step
+      of each iteration run */
+  bool historyIsValid;
+
+  /** single delay for 'DDE_Proxy::systemFunction' */
+  real_t tau;
+
+  Array<real_t> iState;
+  Array<real_t> iDelayState;
+  Array<real_t> k1;
+  Array<real_t> k2;
+  Array<real_t> k3;
+  Array<real_t> k4;
+
+  void initHistory (DDE_Data& data);
+
+  bool callStage (real_t stageOffset,
+		  Array<real_t>& stageState,
+		  Array<real_t>& rhs);
+
+public:
+  DDE_DenseRK44 (AbstractDDE_Proxy& aProxy,
+		 DDE_Data& ddeData,
+		 Configuration& integrationMethodDescription,
+		 string name);
+
+  virtual bool perform (DDE_Data& data, Array<real_t>& nextState);
+
+  /**
+   * only the current state is needed, the delayed ones are taken
+   * from the history
+   */
+  virtual long leastOrbitSize ();
+
+  virtual void reset ();
+};
+
 // basic one-step integrators with fixed step size and without memory 
 typedef BasicOneStepDDE_Integrator<DDE_EulerForwardStepper> DDE_EulerForward;
 typedef BasicOneStepDDE_Integrator<DDE_HeunStepper> DDE_Heun;
@@ -0,0 +1,204 @@
+/* 
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ * 
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ * 
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#include "HybridDDE_Integrator.hpp"
+
+// virtual 
+void 
+HybridDDE_Integrator::
+execute (IterData& iterData)
+{
+  HybridPart& hData = DOWN_CAST <HybridPart&> (iterData.dynSysData);
+  HybridPartIterator::proxy.setCurrentState (&(hData.orbit[0]));
+
+  if (! eventLocatorChecked)
+    {
+      eventLocatorChecked = true;
+
+      if (HybridDDE_Proxy::hasEventFunction ())
+	{
+	  DDE_Data& data = DOWN_CAST <DDE_Data&> (iterData.dynSysData);
+
+	  if (ddeIntegrator->leastOrbitSize () == - data.tauIndex + 1)
+	    {
+	      long dim = data.orbit[0].getTotalSize ();
+
+	      eventLocator.reset 
+		(new HybridEventLocator 
+		 (dim, HybridDDE_Proxy::numberOfEventFunctions));
+	      stepStartState.alloc (dim);
+	      delayStartState.alloc (dim);
+	      delayEndState.alloc (dim);
+	      delayState.alloc (dim);
+	      switchedState.alloc (hData.orbit[0].getTotalSize ());
+	    }
+	  else
+	    cout << "HybridDDE_Integrator warning: events can be located "
+		 << "by one-step integration methods only. The discrete "
+		 << "state will be updated at the integration steps."
+		 << endl;
+	}
+    }
+
+  if (eventLocator.get () == NULL)
+    {
+      (HybridPartIterator::execute) (iterData);
+      ddeIntegrator->execute (iterData);
+      return;
+    }
+
+  // the discrete state is not updated at the step boundary, but only
+  // at the events located within the step (see 'switchAt')
+  hData.orbit.getNext () = hData.orbit[0];
+  hData.orbit.addNext ();
+  HybridPartIterator::proxy.setCurrentState (&(hData.orbit[0]));
+
+  if (! executeWithEvents (iterData))
+    iterData.finalFlag = true;
+}
+
+bool
+HybridDDE_Integrator::
+executeWithEvents (IterData& iterData)
+{
+  DDE_Data& data = DOWN_CAST <DDE_Data&> (iterData.dynSysData);
+
+  // the same as 'DDE_Integrator::execute', but the step is 
+  // finished by the event locator before it is stored
+  ddeIntegrator->proxy.setParameters (&(data.parameters.getValues ()));
+
+  Array<real_t>& nextState = data.orbit.getNext ();
+  bool ok = ddeIntegrator->perform (data, nextState);
+
+  if (ok)
+    {
+      currentIterData = &iterData;
+      stepStartState = data.orbit[0];
+
+      // 'orbit[0]' is overwritten by the parts of the step, hence
+      // the delay states are copied before
+      delayStartState = data.orbit[data.tauIndex];
+      if (data.tauIndex + 1 < 0)
+	delayEndState = data.orbit[data.tauIndex + 1];
+      else
+	delayEndState = stepStartState;
+
+      ok = eventLocator->execute (*this, stepStartState, data.dt, nextState);
+
+      data.orbit[0] = stepStartState;
+    }
+
+  data.orbit.addNext ();
+
+  return ok;
+}
+
+void 
+HybridDDE_Integrator::
+interpolateDelayState (real_t offset)
+{
+  DDE_Data& data = DOWN_CAST <DDE_Data&> (currentIterData->dynSysData);
+  real_t theta = offset / data.dt;
+
+  for (long j = 0; j < delayState.getTotalSize (); ++j)
+    delayState[j] = 
+      (1 - theta) * delayStartState[j] + theta * delayEndState[j];
+}
+
+// virtual
+bool 
+HybridDDE_Integrator::
+step ( const Array<real_t>& fromState,
+       real_t stepSize,
+       Array<real_t>& toState )
+{
+  DDE_Data& data = DOWN_CAST <DDE_Data&> (currentIterData->dynSysData);
+
+  data.orbit[0] = fromState;
+
+  real_t dt = data.dt;
+  data.dt = stepSize;
+  bool ok = ddeIntegrator->perform (data, toState);
+  data.dt = dt;
+
+  return ok;
+}
+
+// virtual
+bool 
+HybridDDE_Integrator::
+slope ( Array<real_t>& state,
+	real_t offset,
+	Array<real_t>& rhs )
+{
+  interpolateDelayState (offset);
+
+  return ddeIntegrator->proxy.callSystemFunction (&state, &delayState, &rhs);
+}
+
+// virtual
+bool 
+HybridDDE_Integrator::
+events ( const Array<real_t>& state,
+	 real_t offset,
+	 Array<real_t>& values )
+{
+  interpolateDelayState (offset);
+
+  return hybridProxy.callEventFunction (state, delayState, values);
+}
+
+// virtual
+bool 
+HybridDDE_Integrator::
+switchAt (const Array<real_t>& state)
+{
+  DynSysData& data = currentIterData->dynSysData;
+  DDE_Data& cData = DOWN_CAST <DDE_Data&> (data);
+  HybridPart& hData = DOWN_CAST <HybridPart&> (data);
+
+  cData.orbit[0] = state;
+  HybridPartIterator::proxy.setRHS (&switchedState);
+
+  if (! HybridPartIterator::proxy.callHybridFunction (data))
+    return false;
+
+  hData.orbit[0] = switchedState;
+  HybridPartIterator::proxy.setCurrentState (&(hData.orbit[0]));
+
+  return true;
+}
+
+HybridDDE_Integrator::
+HybridDDE_Integrator ( HybridDDE_Proxy& aProxy,
+		       DDE_Integrator* aDDE_Integrator ) :
+  HybridPartIterator (aProxy),
+  ddeIntegrator (aDDE_Integrator),
+  hybridProxy (aProxy),
+  eventLocatorChecked (false),
+  currentIterData (NULL)
+{
+}
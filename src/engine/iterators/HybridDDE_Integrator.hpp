@@ -30,32 +30,62 @@
 #include <memory>
 
 #include "HybridPartIterator.hpp"
+#include "HybridEventLocator.hpp"
 #include "DDE_Integrator.hpp"
 #include "proxies/HybridDDE_Proxy.hpp"
 
 using std::auto_ptr;
 
-class HybridDDE_Integrator : public HybridPartIterator
+class HybridDDE_Integrator : public HybridPartIterator,
+			     private HybridEventLocator::EventSystem
 {
 private:
   auto_ptr<DDE_Integrator> ddeIntegrator;
 
-public:
-  virtual void execute (IterData& iterData)
-  {
-    HybridPart& hData = DOWN_CAST <HybridPart&> (iterData.dynSysData);
-    HybridPartIterator::proxy.setCurrentState (&(hData.orbit[0]));
+  HybridDDE_Proxy& hybridProxy;
 
-    (HybridPartIterator::execute) (iterData); 
-    ddeIntegrator->execute (iterData);
-  }
+  /**
+   * see 'HybridODE_Integrator'. The delay states within the step
+   * are interpolated linearly between the states on the orbit, the
+   * parts of the split step use the delay states of the whole step.
+   */
+  auto_ptr<HybridEventLocator> eventLocator;
+  bool eventLocatorChecked;
+
+  IterData* currentIterData;
+  Array<real_t> stepStartState;
+  Array<real_t> delayStartState;
+  Array<real_t> delayEndState;
+  Array<real_t> delayState;
+  Array<integer_t> switchedState;
+
+  bool executeWithEvents (IterData& iterData);
+
+  /**
+   * delay state at 'offset' within the current step
+   */
+  void interpolateDelayState (real_t offset);
+
+  virtual bool step ( const Array<real_t>& fromState,
+		      real_t stepSize,
+		      Array<real_t>& toState );
+
+  virtual bool slope ( Array<real_t>& state,
+		       real_t offset,
+		       Array<real_t>& rhs );
+
+  virtual bool events ( const Array<real_t>& state,
+			real_t offset,
+			Array<real_t>& values );
+
+  virtual bool switchAt (const Array<real_t>& state);
+
+public:
+  virtual void execute (IterData& iterData);
   
 private:
   HybridDDE_Integrator (HybridDDE_Proxy& aProxy,
-			DDE_Integrator* aDDE_Integrator) :
-    HybridPartIterator (aProxy),
-    ddeIntegrator (aDDE_Integrator)
-  {}
+			DDE_Integrator* aDDE_Integrator);
 
 public:
   /** 
@@ -0,0 +1,197 @@
+/* 
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ * 
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ * 
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#include "HybridEventLocator.hpp"
+
+const int HybridEventLocator::maxEventsPerStep = 8;
+const int HybridEventLocator::maxIterations = 100;
+const real_t HybridEventLocator::timeTolerance = 1.0e-12;
+
+/**
+ * a sign change from 'a' to 'b'. A start value equal to zero is not
+ * a crossing: it is the event located at the end of the previous
+ * part of the step.
+ */
+static inline bool crosses (real_t a, real_t b)
+{
+  return ((a < 0) && (b >= 0)) || ((a > 0) && (b <= 0));
+}
+
+HybridEventLocator::
+HybridEventLocator (long stateSpaceDim, long aNumberOfEvents) :
+  numberOfEvents (aNumberOfEvents)
+{
+  startState.alloc (stateSpaceDim);
+  startSlope.alloc (stateSpaceDim);
+  endSlope.alloc (stateSpaceDim);
+  eventState.alloc (stateSpaceDim);
+
+  startValues.alloc (numberOfEvents);
+  endValues.alloc (numberOfEvents);
+  values.alloc (numberOfEvents);
+}
+
+void 
+HybridEventLocator::
+interpolate ( const Array<real_t>& endState,
+	      real_t theta,
+	      real_t h,
+	      Array<real_t>& state )
+{
+  real_t theta2 = theta * theta;
+  real_t theta3 = theta2 * theta;
+
+  real_t h00 = 2 * theta3 - 3 * theta2 + 1;
+  real_t h10 = h * (theta3 - 2 * theta2 + theta);
+  real_t h01 = 3 * theta2 - 2 * theta3;
+  real_t h11 = h * (theta3 - theta2);
+
+  for (long j = 0; j < state.getTotalSize (); ++j)
+    state[j] = 
+      h00 * startState[j] + h10 * startSlope[j]
+      + h01 * endState[j] + h11 * endSlope[j];
+}
+
+bool 
+HybridEventLocator::
+locate ( EventSystem& system,
+	 const Array<real_t>& endState,
+	 real_t offset,
+	 real_t h,
+	 real_t& theta )
+{
+  theta = 1.0;
+
+  for (long i = 0; i < numberOfEvents; ++i)
+    {
+      real_t a = startValues[i];
+
+      if (! crosses (a, endValues[i]))
+	continue;
+
+      real_t lo = 0.0;
+      real_t hi = 1.0;
+      real_t gLo = a;
+      real_t gHi = endValues[i];
+      int side = 0;
+
+      for ( int n = 0; 
+	    (n < maxIterations) && (hi - lo > timeTolerance); 
+	    ++n )
+	{
+	  real_t t = (lo * gHi - hi * gLo) / (gHi - gLo);
+	  if (! ((t > lo) && (t < hi)))
+	    t = 0.5 * (lo + hi);
+
+	  interpolate (endState, t, h, eventState);
+	  if (! system.events (eventState, offset + t * h, values))
+	    return false;
+
+	  real_t g = values[i];
+	  if (crosses (a, g))
+	    {
+	      hi = t;
+	      gHi = g;
+	      // Illinois: halve the retained end point after two 
+	      // consecutive steps from the same side
+	      if (side == 1) gLo *= 0.5;
+	      side = 1;
+
+	      if (g == 0) break;
+	    }
+	  else
+	    {
+	      lo = t;
+	      gLo = g;
+	      if (side == -1) gHi *= 0.5;
+	      side = -1;
+	    }
+	}
+
+      if (hi < theta)
+	theta = hi;
+    }
+
+  return true;
+}
+
+bool 
+HybridEventLocator::
+execute ( EventSystem& system,
+	  const Array<real_t>& fromState,
+	  real_t h,
+	  Array<real_t>& endState )
+{
+  startState = fromState;
+  real_t offset = 0.0;
+  real_t rest = h;
+
+  for (int k = 0; k < maxEventsPerStep; ++k)
+    {
+      if (! system.events (startState, offset, startValues))
+	return false;
+      if (! system.events (endState, h, endValues))
+	return false;
+
+      bool found = false;
+      for (long i = 0; (i < numberOfEvents) && (! found); ++i)
+	found = crosses (startValues[i], endValues[i]);
+
+      if (! found)
+	return true;
+
+      if (! system.slope (startState, offset, startSlope))
+	return false;
+      if (! system.slope (endState, h, endSlope))
+	return false;
+
+      real_t theta;
+      if (! locate (system, endState, offset, rest, theta))
+	return false;
+
+      real_t eventStep = theta * rest;
+
+      if (! system.step (startState, eventStep, eventState))
+	return false;
+      if (! system.switchAt (eventState))
+	return false;
+
+      offset += eventStep;
+      rest -= eventStep;
+      startState = eventState;
+
+      if (rest <= timeTolerance * h)
+	{
+	  endState = eventState;
+	  return true;
+	}
+
+      if (! system.step (startState, rest, endState))
+	return false;
+    }
+
+  return true;
+}
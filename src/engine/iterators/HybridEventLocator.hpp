@@ -0,0 +1,154 @@
+/* 
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ * 
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ * 
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#ifndef HYBRID_EVENT_LOCATOR_HPP
+#define HYBRID_EVENT_LOCATOR_HPP
+
+#include "../utils/arrays/Array.hpp"
+#include "utils/GlobalConstants.hpp"
+
+/**
+ * Locates sign changes of the event functions of a hybrid system
+ * within one integration step of the continuous part and splits the
+ * step at the located events.
+ *
+ * The event functions are evaluated on the cubic Hermite
+ * interpolant between the states (and slopes) at both ends of the
+ * (remaining) step, the zero of each component with a sign change is
+ * bracketed and refined by the Illinois variant of regula falsi. The
+ * earliest one is the event: the continuous part is integrated up to
+ * it, the discrete state is updated there and the rest of the step is
+ * integrated with the new discrete state. Only one-step integration
+ * methods can be restarted at an arbitrary point, hence the step
+ * splitting is used for them only.
+ *
+ * The located event time is always the side of the bracket on which
+ * the sign has already changed, so that the same crossing is not
+ * detected again within the rest of the step.
+ */
+class HybridEventLocator
+{
+public:
+  /**
+   * interface to the hybrid system and its integrator. The 'offset'
+   * arguments are the times relative to the beginning of the
+   * (complete) integration step.
+   */
+  class EventSystem
+  {
+  public:
+    /**
+     * integrates the continuous part from 'fromState' over 'stepSize'
+     * using the current discrete state.
+     */
+    virtual bool step ( const Array<real_t>& fromState,
+			real_t stepSize,
+			Array<real_t>& toState ) = 0;
+
+    /**
+     * right hand side of the continuous part
+     */
+    virtual bool slope ( Array<real_t>& state,
+			 real_t offset,
+			 Array<real_t>& rhs ) = 0;
+
+    /**
+     * values of the event functions
+     */
+    virtual bool events ( const Array<real_t>& state,
+			  real_t offset,
+			  Array<real_t>& values ) = 0;
+
+    /**
+     * applies the hybrid function at the given continuous state and
+     * makes the result the current discrete state.
+     */
+    virtual bool switchAt (const Array<real_t>& state) = 0;
+
+    virtual ~EventSystem () {}
+  };
+
+private:
+  /**
+   * the step is split at most so many times, further events within
+   * the same step (Zeno behaviour) are handled at the step boundary.
+   */
+  static const int maxEventsPerStep;
+
+  /**
+   * iteration limit and relative accuracy of the event time.
+   */
+  static const int maxIterations;
+  static const real_t timeTolerance;
+
+  long numberOfEvents;
+
+  Array<real_t> startState;
+  Array<real_t> startSlope;
+  Array<real_t> endSlope;
+  Array<real_t> eventState;
+  Array<real_t> startValues;
+  Array<real_t> endValues;
+  Array<real_t> values;
+
+  /**
+   * cubic Hermite interpolation between 'startState' and 'endState'
+   * at the relative time 'theta' of a step with size 'h'.
+   */
+  void interpolate ( const Array<real_t>& endState,
+		     real_t theta,
+		     real_t h,
+		     Array<real_t>& state );
+
+  /**
+   * smallest relative time 'theta' at which one of the event
+   * functions changes its sign within the step of size 'h' starting
+   * at 'offset'.
+   */
+  bool locate ( EventSystem& system,
+		const Array<real_t>& endState,
+		real_t offset,
+		real_t h,
+		real_t& theta );
+
+public:
+  HybridEventLocator (long stateSpaceDim, long aNumberOfEvents);
+
+  /**
+   * @param fromState the state at the beginning of the step
+   * @param h the step size
+   * @param endState the state at the end of the step. Input: the
+   * result of the (unsplit) step, output: the result of the step
+   * split at the located events.
+   * @return false, if a call of the system failed.
+   */
+  bool execute ( EventSystem& system,
+		 const Array<real_t>& fromState,
+		 real_t h,
+		 Array<real_t>& endState );
+};
+
+#endif
@@ -33,16 +33,148 @@ execute (IterData& iterData)
 {
   HybridPart& hData = DOWN_CAST <HybridPart&> (iterData.dynSysData);
   HybridPartIterator::proxy.setCurrentState (&(hData.orbit[0]));
-  
-  (HybridPartIterator::execute) (iterData);
-  odeIntegrator->execute (iterData);
+
+  if (! eventLocatorChecked)
+    {
+      eventLocatorChecked = true;
+
+      if (HybridODE_Proxy::hasEventFunction ())
+	{
+	  if (odeIntegrator->leastOrbitSize () == 2)
+	    {
+	      ODE_Data& data = DOWN_CAST <ODE_Data&> (iterData.dynSysData);
+	      long dim = data.orbit[0].getTotalSize ();
+
+	      eventLocator.reset 
+		(new HybridEventLocator 
+		 (dim, HybridODE_Proxy::numberOfEventFunctions));
+	      stepStartState.alloc (dim);
+	      switchedState.alloc (hData.orbit[0].getTotalSize ());
+	    }
+	  else
+	    cout << "HybridODE_Integrator warning: events can be located "
+		 << "by one-step integration methods only. The discrete "
+		 << "state will be updated at the integration steps."
+		 << endl;
+	}
+    }
+
+  if (eventLocator.get () == NULL)
+    {
+      (HybridPartIterator::execute) (iterData);
+      odeIntegrator->execute (iterData);
+      return;
+    }
+
+  // the discrete state is not updated at the step boundary, but only
+  // at the events located within the step (see 'switchAt')
+  hData.orbit.getNext () = hData.orbit[0];
+  hData.orbit.addNext ();
+  HybridPartIterator::proxy.setCurrentState (&(hData.orbit[0]));
+
+  if (! executeWithEvents (iterData))
+    iterData.finalFlag = true;
+}
+
+bool
+HybridODE_Integrator::
+executeWithEvents (IterData& iterData)
+{
+  ODE_Data& data = DOWN_CAST <ODE_Data&> (iterData.dynSysData);
+
+  // the same as 'ODE_Integrator::execute', but the step is 
+  // finished by the event locator before it is stored
+  odeIntegrator->proxy.setParameters (&(data.parameters.getValues ()));
+
+  Array<real_t>& nextState = data.orbit.getNext ();
+  bool ok = odeIntegrator->perform (data, nextState);
+
+  if (ok)
+    {
+      currentIterData = &iterData;
+      stepStartState = data.orbit[0];
+
+      ok = eventLocator->execute (*this, stepStartState, data.dt, nextState);
+
+      // the parts of the step are integrated starting from 'orbit[0]'
+      data.orbit[0] = stepStartState;
+    }
+
+  data.orbit.addNext ();
+
+  return ok;
+}
+
+// virtual
+bool 
+HybridODE_Integrator::
+step ( const Array<real_t>& fromState,
+       real_t stepSize,
+       Array<real_t>& toState )
+{
+  ODE_Data& data = DOWN_CAST <ODE_Data&> (currentIterData->dynSysData);
+
+  data.orbit[0] = fromState;
+
+  real_t dt = data.dt;
+  data.dt = stepSize;
+  bool ok = odeIntegrator->perform (data, toState);
+  data.dt = dt;
+
+  return ok;
+}
+
+// virtual
+bool 
+HybridODE_Integrator::
+slope ( Array<real_t>& state,
+	real_t offset,
+	Array<real_t>& rhs )
+{
+  return odeIntegrator->proxy.callSystemFunction (&state, &rhs);
+}
+
+// virtual
+bool 
+HybridODE_Integrator::
+events ( const Array<real_t>& state,
+	 real_t offset,
+	 Array<real_t>& values )
+{
+  return hybridProxy.callEventFunction (state, values);
+}
+
+// virtual
+bool 
+HybridODE_Integrator::
+switchAt (const Array<real_t>& state)
+{
+  DynSysData& data = currentIterData->dynSysData;
+  ODE_Data& cData = DOWN_CAST <ODE_Data&> (data);
+  HybridPart& hData = DOWN_CAST <HybridPart&> (data);
+
+  // the hybrid function is called at the event state, the result
+  // replaces the discrete state of the step
+  cData.orbit[0] = state;
+  HybridPartIterator::proxy.setRHS (&switchedState);
+
+  if (! HybridPartIterator::proxy.callHybridFunction (data))
+    return false;
+
+  hData.orbit[0] = switchedState;
+  HybridPartIterator::proxy.setCurrentState (&(hData.orbit[0]));
+
+  return true;
 }
 
 HybridODE_Integrator::
 HybridODE_Integrator ( HybridODE_Proxy& aProxy,
 		       ODE_Integrator* aODE_Integrator ) :
   HybridPartIterator (aProxy),
-  odeIntegrator (aODE_Integrator)
+  odeIntegrator (aODE_Integrator),
+  hybridProxy (aProxy),
+  eventLocatorChecked (false),
+  currentIterData (NULL)
 {
 }
 
@@ -29,6 +29,7 @@
 #include <memory>
 
 #include "HybridPartIterator.hpp"
+#include "HybridEventLocator.hpp"
 #include "ODE_Integrator.hpp"
 #include "proxies/HybridODE_Proxy.hpp"
 
@@ -42,7 +43,8 @@ using std::auto_ptr;
  *
  * @see ODE_Integrator, HybridPartIterator
  */
-class HybridODE_Integrator : public HybridPartIterator
+class HybridODE_Integrator : public HybridPartIterator,
+			     private HybridEventLocator::EventSystem
 {
 
 private:
@@ -52,6 +54,43 @@ private:
    */
   auto_ptr<ODE_Integrator> odeIntegrator;
 
+  HybridODE_Proxy& hybridProxy;
+
+  /**
+   * splits the integration steps at the zeros of the event functions,
+   * if the system defines some. Allocated at the first step, remains
+   * empty if the system has no event functions or the integration
+   * method is not a one-step method.
+   */
+  auto_ptr<HybridEventLocator> eventLocator;
+  bool eventLocatorChecked;
+
+  /**
+   * data of the current step, used by the 'EventSystem' routines
+   */
+  IterData* currentIterData;
+  Array<real_t> stepStartState;
+  Array<integer_t> switchedState;
+
+  /**
+   * one integration step, split at the events located within it.
+   */
+  bool executeWithEvents (IterData& iterData);
+
+  virtual bool step ( const Array<real_t>& fromState,
+		      real_t stepSize,
+		      Array<real_t>& toState );
+
+  virtual bool slope ( Array<real_t>& state,
+		       real_t offset,
+		       Array<real_t>& rhs );
+
+  virtual bool events ( const Array<real_t>& state,
+			real_t offset,
+			Array<real_t>& values );
+
+  virtual bool switchAt (const Array<real_t>& state);
+
 public:
   virtual void execute (IterData& iterData);
   
@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#include "PDE_1d_IMEX_Integrator.hpp"
+#include "data/DynSysData.hpp"
+
+PDE_1d_IMEX_Integrator::
+PDE_1d_IMEX_Integrator (AbstractODE_Proxy& aProxy,
+			PDE_Data& aData,
+			const Array<real_t>& aDiffusion,
+			scheme_t aScheme,
+			bool dirichletBoundaries) :
+  Iterator ("PDE_1d_IMEX_Integrator"),
+  proxy (aProxy),
+  scheme (aScheme),
+  numberOfCells (aData.numberOfCells),
+  cellDim (aData.cellDim),
+  policy (defaultBoundaryPolicy),
+  lowerBoundaryValue (0.0),
+  upperBoundaryValue (0.0),
+  hasPrevious (false)
+{
+  // the diffusion term is the operator 'D<0,0>' and uses its policy
+  const string operatorName = "D<0,0>";
+
+  map<string, BoundaryPolicyEnum>::iterator i
+    = boundaryPolicyMap ().find (operatorName);
+
+  if (i != boundaryPolicyMap ().end ())
+    policy = i->second;
+
+  // Dirichlet boundary conditions: the boundary cells are fixed
+  if (dirichletBoundaries)
+    policy = FLUXLESS;
+
+  if (policy == CONSTANT)
+    {
+      lowerBoundaryValue = constantBoundaryPolicyMin () [operatorName];
+      upperBoundaryValue = constantBoundaryPolicyMax () [operatorName];
+    }
+
+  if ( (policy != FLUXLESS)
+       && (policy != CONSTANT)
+       && (policy != CYCLIC) )
+    {
+      cerr << "PDE_1d_IMEX_Integrator: only the boundary policies "
+	   << "'fluxless', 'constant' and 'cyclic' are supported "
+	   << "for the implicit diffusion term."
+	   << endl << Error::Exit;
+    }
+
+  if ( (policy == CYCLIC) && (numberOfCells < 3) )
+    {
+      cerr << "PDE_1d_IMEX_Integrator: at least three grid points "
+	   << "are needed for cyclic boundaries."
+	   << endl << Error::Exit;
+    }
+
+  diffusion.alloc (cellDim);
+  diffusion = aDiffusion;
+
+  int n = numberOfCells * cellDim;
+
+  reaction.alloc (n);
+  previousReaction.alloc (n);
+  previousState.alloc (n);
+  rhs.alloc (n);
+
+  lower.alloc (numberOfCells);
+  diag.alloc (numberOfCells);
+  upper.alloc (numberOfCells);
+  b.alloc (numberOfCells);
+  x.alloc (numberOfCells);
+  z.alloc (numberOfCells);
+  work.alloc (numberOfCells);
+}
+
+void
+PDE_1d_IMEX_Integrator::thomas (const Array<real_t>& d,
+				const Array<real_t>& r,
+				Array<real_t>& y)
+{
+  work[0] = upper[0] / d[0];
+  y[0] = r[0] / d[0];
+
+  for (int i = 1; i < numberOfCells; ++i)
+    {
+      real_t m = d[i] - lower[i] * work[i - 1];
+
+      work[i] = upper[i] / m;
+      y[i] = (r[i] - lower[i] * y[i - 1]) / m;
+    }
+
+  for (int i = numberOfCells - 2; i >= 0; --i)
+    y[i] -= work[i] * y[i + 1];
+}
+
+void
+PDE_1d_IMEX_Integrator::solve (int k,
+			       real_t gamma,
+			       real_t c,
+			       Array<real_t>& nextState)
+{
+  int last = numberOfCells - 1;
+
+  for (int i = 0; i < numberOfCells; ++i)
+    {
+      lower[i] = -c;
+      diag[i] = gamma + 2.0 * c;
+      upper[i] = -c;
+      b[i] = rhs[i * cellDim + k];
+    }
+
+  if (policy == CYCLIC)
+    {
+      // Sherman-Morrison: the corner entries A[0][last] = beta and
+      // A[last][0] = alpha are removed by a rank one correction.
+      real_t alpha = -c;
+      real_t beta = -c;
+      real_t g = -diag[0];
+
+      diag[0] -= g;
+      diag[last] -= alpha * beta / g;
+
+      thomas (diag, b, x);
+
+      b.setAll (0.0);
+      b[0] = g;
+      b[last] = alpha;
+
+      thomas (diag, b, z);
+
+      real_t fact = (x[0] + beta * x[last] / g)
+	/ (1.0 + z[0] + beta * z[last] / g);
+
+      for (int i = 0; i < numberOfCells; ++i)
+	x[i] -= fact * z[i];
+    }
+  else
+    {
+      // FLUXLESS, CONSTANT: no diffusion in the boundary cells
+      diag[0] = gamma;
+      upper[0] = 0.0;
+      diag[last] = gamma;
+      lower[last] = 0.0;
+
+      thomas (diag, b, x);
+    }
+
+  for (int i = 0; i < numberOfCells; ++i)
+    nextState[i * cellDim + k] = x[i];
+}
+
+// virtual
+void
+PDE_1d_IMEX_Integrator::execute (IterData& iterData)
+{
+  PDE_Data& data = DOWN_CAST <PDE_Data&> (iterData.dynSysData);
+
+  real_t h = data.dt;
+  real_t deltaX = data.getDeltaX ();
+  Array<real_t>& currentState = data.orbit[0];
+  int n = currentState.getTotalSize ();
+
+  proxy.setParameters (&(data.parameters.getValues ()));
+
+  // explicit part: the reaction term
+  bool ok = proxy.callSystemFunction (&currentState, &reaction);
+
+  real_t gamma = 1.0;
+
+  if ( (scheme == SBDF2) && hasPrevious )
+    {
+      gamma = 1.5;
+
+      for (int i = 0; i < n; ++i)
+	rhs[i] = 2.0 * currentState[i] - 0.5 * previousState[i]
+	  + h * (2.0 * reaction[i] - previousReaction[i]);
+    }
+  else
+    {
+      for (int i = 0; i < n; ++i)
+	rhs[i] = currentState[i] + h * reaction[i];
+    }
+
+  if (scheme == SBDF2)
+    {
+      previousState = currentState;
+      previousReaction = reaction;
+      hasPrevious = true;
+    }
+
+  if (policy == CONSTANT)
+    {
+      // the second derivatives in the boundary cells are given
+      for (int k = 0; k < cellDim; ++k)
+	{
+	  rhs[k] += h * diffusion[k] * lowerBoundaryValue;
+	  rhs[(numberOfCells - 1) * cellDim + k]
+	    += h * diffusion[k] * upperBoundaryValue;
+	}
+    }
+
+  // implicit part: the diffusion term
+  Array<real_t>& nextState = data.orbit.getNext ();
+
+  for (int k = 0; k < cellDim; ++k)
+    solve (k, gamma, h * diffusion[k] / (deltaX * deltaX), nextState);
+
+  data.orbit.addNext ();
+
+  if (!ok) iterData.finalFlag = true;
+}
+
+// virtual
+void
+PDE_1d_IMEX_Integrator::reset ()
+{
+  hasPrevious = false;
+}
+
+// virtual
+AbstractODE_Proxy*
+PDE_1d_IMEX_Integrator::getProxy ()
+{
+  return &proxy;
+}
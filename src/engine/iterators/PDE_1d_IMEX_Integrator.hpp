@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#ifndef PDE_1D_IMEX_INTEGRATOR_HPP
+#define PDE_1D_IMEX_INTEGRATOR_HPP
+
+#include "Iterator.hpp"
+#include "proxies/AbstractODE_Proxy.hpp"
+#include "SpatialDiffOperators.hpp" // BoundaryPolicyEnum
+
+/**
+ * Implicit-explicit (IMEX) integrator for PDEs with one space
+ * direction of the form
+ * \f[
+ *  \partial_t u_k = D_k \partial_x^2 u_k + N_k(u),
+ * \f]
+ * where the linear diffusion term is treated implicitly and the
+ * reaction term \f$N\f$, returned by the system function, explicitly.
+ * Hence the step size is not restricted by \f$\Delta x^2/D_k\f$.
+ *
+ * The diffusion term is discretized as the operator 'D<0,0>' with
+ * its boundary policy:
+ * <UL>
+ * <LI> FLUXLESS (and Dirichlet boundary conditions): the boundary
+ *      cells are not diffused, a tridiagonal system is solved. </LI>
+ * <LI> CONSTANT: as FLUXLESS, but the given constant values are
+ *      used as second derivative in the boundary cells. </LI>
+ * <LI> CYCLIC: a cyclic tridiagonal system is solved
+ *      (Sherman-Morrison formula). </LI>
+ * </UL>
+ *
+ * Two schemes are available:
+ * <UL>
+ * <LI> IMEX Euler (order 1):
+ *   \f$(I - h D L) u^{n+1} = u^n + h N(u^n)\f$ </LI>
+ * <LI> SBDF2 (order 2):
+ *   \f$(\frac{3}{2} I - h D L) u^{n+1} = 2 u^n - \frac{1}{2} u^{n-1}
+ *   + h (2 N(u^n) - N(u^{n-1}))\f$,
+ *   the first step after a reset is an IMEX Euler step. </LI>
+ * </UL>
+ */
+class PDE_1d_IMEX_Integrator : public Iterator
+{
+public:
+  enum scheme_t {IMEX_EULER, SBDF2};
+
+private:
+  AbstractODE_Proxy& proxy;
+
+  scheme_t scheme;
+
+  int numberOfCells;
+  int cellDim;
+
+  /** diffusion coefficient of each state variable */
+  Array<real_t> diffusion;
+
+  BoundaryPolicyEnum policy;
+
+  /** second derivatives at the boundary cells (CONSTANT only) */
+  real_t lowerBoundaryValue;
+  real_t upperBoundaryValue;
+
+  /** reaction terms at the current and at the previous step */
+  Array<real_t> reaction;
+  Array<real_t> previousReaction;
+  Array<real_t> previousState;
+  bool hasPrevious;
+
+  /** right hand side of the implicit step */
+  Array<real_t> rhs;
+
+  /**
+   * the tridiagonal matrix of the current solve (one state variable,
+   * all cells) and work arrays of the length 'numberOfCells'
+   */
+  Array<real_t> lower;
+  Array<real_t> diag;
+  Array<real_t> upper;
+  Array<real_t> b;
+  Array<real_t> x;
+  Array<real_t> z;
+  Array<real_t> work;
+
+  /**
+   * Thomas algorithm: solve the tridiagonal system given by 'lower',
+   * 'd' and 'upper' with the right hand side 'r'.
+   */
+  void thomas (const Array<real_t>& d,
+	       const Array<real_t>& r,
+	       Array<real_t>& y);
+
+  /**
+   * solve \f$(\gamma I - c L) u = r\f$ for the state variable k,
+   * whereby \f$L\f$ is the stencil (1, -2, 1) with the boundary
+   * rows given by the policy. r is taken from 'rhs', the solution
+   * is written into 'nextState' (both with the stride 'cellDim').
+   */
+  void solve (int k, real_t gamma, real_t c, Array<real_t>& nextState);
+
+public:
+  PDE_1d_IMEX_Integrator (AbstractODE_Proxy& aProxy,
+			  PDE_Data& aData,
+			  const Array<real_t>& aDiffusion,
+			  scheme_t aScheme,
+			  bool dirichletBoundaries);
+
+  virtual void execute (IterData& iterData);
+
+  /**
+   * forget the previous step (SBDF2), called before each
+   * iteration run.
+   */
+  virtual void reset ();
+
+  virtual AbstractODE_Proxy* getProxy ();
+};
+
+#endif
@@ -25,6 +25,7 @@
  */
 
 #include "StochasticalDDE_Integrator.hpp"
+#include "../utils/arrays/RealVector.hpp"
 
 
 //  virtual 
@@ -84,3 +85,91 @@ getProxy ()
 {
   return &proxy;
 }
+
+//  virtual 
+void 
+StochasticalDDE_SRA::execute (IterData& iterData)
+{
+  bool ok = true;
+  DDE_Data& data = DOWN_CAST <DDE_Data&> (iterData.dynSysData);
+
+  real_t h = data.dt;
+  Array<real_t>& currentState = data.orbit[0];
+  Array<real_t>& preDelayState = data.orbit[data.tauIndex];
+  Array<real_t>& postDelayState = data.orbit[data.tauIndex + 1];
+
+  proxy.setParameters (&(data.parameters.getValues ()));
+
+  increments.create (h);
+
+  for (int s = 0; s < coefficients.stages; ++s)
+    {
+      Array<real_t>& H = stageStates[s];
+
+      for (long i = 0; i < H.getTotalSize (); ++i)
+	{
+	  H[i] = currentState[i] + coefficients.b[s] * increments.deltaZ[i];
+
+	  for (int j = 0; j < s; ++j)
+	    H[i] += h * coefficients.a[s][j] * stageRHS[j][i];
+	}
+
+      interpolate (delayState, preDelayState, postDelayState,
+		   coefficients.c[s]);
+
+      proxy.setCurrentState (&H);
+      proxy.setDelayState (&delayState);
+      proxy.setRHS (&(stageRHS[s]));
+
+      ok = proxy.callSystemFunction () && ok;
+    }
+
+  // get adress for the next slot of the orbit
+  Array<real_t>& nextState = data.orbit.getNext ();
+
+  for (long i = 0; i < nextState.getTotalSize (); ++i)
+    {
+      nextState[i] = currentState[i] + increments.deltaW[i];
+
+      for (int s = 0; s < coefficients.stages; ++s)
+	nextState[i] += h * coefficients.alpha[s] * stageRHS[s][i];
+    }
+
+  // store the calculated value as the newest element (cycle ringbuffer)
+  data.orbit.addNext ();
+
+  // only continue iteration if the timer and the systemfunction tell us to
+  if (!ok) iterData.finalFlag = true;
+}
+
+StochasticalDDE_SRA::
+StochasticalDDE_SRA ( AbstractDDE_Proxy& aProxy,
+		      DDE_Data& aData,
+		      Configuration& dynSysDescription,
+		      const SRA_Coefficients& aCoefficients ) :
+  Iterator ("StochasticalDDE_SRA"),
+  proxy (aProxy),
+  coefficients (aCoefficients)
+{
+  int stateSpaceDim = (aData.initialStates[0]).getTotalSize ();
+
+  increments.initialize (dynSysDescription, stateSpaceDim);
+
+  stageStates.alloc (coefficients.stages);
+  stageRHS.alloc (coefficients.stages);
+
+  for (int s = 0; s < coefficients.stages; ++s)
+    {
+      stageStates[s].alloc (stateSpaceDim);
+      stageRHS[s].alloc (stateSpaceDim);
+    }
+
+  delayState.alloc (stateSpaceDim);
+}
+
+AbstractDDE_Proxy* 
+StochasticalDDE_SRA::
+getProxy ()
+{
+  return &proxy;
+}
@@ -31,6 +31,7 @@
 #include "proxies/DDE_Proxy.hpp"
 #include "../utils/config/Configuration.hpp"
 #include "utils/noise/NoiseGenerator.hpp"
+#include "StochasticalODE_Integrator.hpp" // SRA_Coefficients
 
 
 /**
@@ -67,4 +68,43 @@ public:
 
 };
 
+/**
+ * stochastic Runge-Kutta method of type SRA for stochastical DDEs.
+ * The delayed states of the stages are linearly interpolated between
+ * \f$\vec y(t-\tau)\f$ and \f$\vec y(t-\tau+h)\f$, as done by
+ * the one-step steppers for deterministic DDEs.
+ * @see SRA_Coefficients
+ */
+class StochasticalDDE_SRA : public Iterator
+{
+private:
+  // system function
+  AbstractDDE_Proxy& proxy;
+
+  const SRA_Coefficients& coefficients;
+
+  SRA_NoiseIncrements increments;
+
+  Array<Array<real_t> > stageStates;
+  Array<Array<real_t> > stageRHS;
+  Array<real_t> delayState;
+
+public:
+  /**
+   * make one integration step
+   * @param iterdata ...
+   */
+  virtual void execute(IterData& iterData);
+
+  /**
+   * initialize the integrator
+   */
+  StochasticalDDE_SRA (AbstractDDE_Proxy& aProxy,
+		       DDE_Data& aData,
+		       Configuration& dynSysDescription,
+		       const SRA_Coefficients& aCoefficients);
+
+  virtual AbstractDDE_Proxy* getProxy ();
+};
+
 #endif
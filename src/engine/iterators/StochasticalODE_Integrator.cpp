@@ -79,3 +79,128 @@ getProxy ()
 {
   return &proxy;
 }
+
+const SRA_Coefficients SRA_Coefficients::SRA1 =
+  { 2,
+    { {0.0,  0.0, 0.0},
+      {0.75, 0.0, 0.0},
+      {0.0,  0.0, 0.0} },
+    {0.0, 1.5, 0.0},
+    {0.0, 0.75, 0.0},
+    {1.0/3.0, 2.0/3.0, 0.0} };
+
+const SRA_Coefficients SRA_Coefficients::SRA3 =
+  { 3,
+    { {0.0,  0.0,  0.0},
+      {1.0,  0.0,  0.0},
+      {0.25, 0.25, 0.0} },
+    {0.0, 0.0, 1.5},
+    {0.0, 1.0, 0.5},
+    {1.0/6.0, 1.0/6.0, 2.0/3.0} };
+
+void
+SRA_NoiseIncrements::initialize (Configuration& dynSysDescription,
+				 int stateSpaceDim)
+{
+  noiseVectorCreator.initialize (dynSysDescription, stateSpaceDim);
+  aux1.alloc (stateSpaceDim);
+  aux2.alloc (stateSpaceDim);
+  deltaW.alloc (stateSpaceDim);
+  deltaZ.alloc (stateSpaceDim);
+}
+
+void
+SRA_NoiseIncrements::create (real_t h)
+{
+  noiseVectorCreator.getNoiseVector (deltaW);
+  noiseVectorCreator.getNoiseVector (aux1);
+  noiseVectorCreator.getNoiseVector (aux2);
+
+  real_t sqrtH = sqrt (h);
+
+  // I_(1,0) = h^(3/2)/2 * (xi_1 + xi_2/sqrt(3)), xi_1, xi_2 independent
+  // and standard normal; xi_2 is taken as (aux1 - aux2)/sqrt(2).
+  for (long i = 0; i < deltaW.getTotalSize (); ++i)
+    {
+      deltaZ[i] = 0.5 * sqrtH 
+	* (deltaW[i] + (aux1[i] - aux2[i]) / sqrt (6.0));
+      deltaW[i] *= sqrtH;
+    }
+}
+
+//  virtual 
+void 
+StochasticalODE_SRA::execute (IterData& iterData)
+{
+  bool ok = true;
+  ODE_Data& data = DOWN_CAST <ODE_Data&> (iterData.dynSysData);
+
+  real_t h = data.dt;
+  Array<real_t>& currentState = data.orbit[0];
+
+  proxy.setParameters (&(data.parameters.getValues ()));
+
+  increments.create (h);
+
+  for (int s = 0; s < coefficients.stages; ++s)
+    {
+      Array<real_t>& H = stageStates[s];
+
+      for (long i = 0; i < H.getTotalSize (); ++i)
+	{
+	  H[i] = currentState[i] + coefficients.b[s] * increments.deltaZ[i];
+
+	  for (int j = 0; j < s; ++j)
+	    H[i] += h * coefficients.a[s][j] * stageRHS[j][i];
+	}
+
+      ok = proxy.callSystemFunction (&H, &(stageRHS[s])) && ok;
+    }
+
+  // get adress for the next slot of the orbit
+  Array<real_t>& nextState = data.orbit.getNext ();
+
+  for (long i = 0; i < nextState.getTotalSize (); ++i)
+    {
+      nextState[i] = currentState[i] + increments.deltaW[i];
+
+      for (int s = 0; s < coefficients.stages; ++s)
+	nextState[i] += h * coefficients.alpha[s] * stageRHS[s][i];
+    }
+
+  // store the calculated value as the newest element (cycle ringbuffer)
+  data.orbit.addNext ();
+
+  // only continue iteration if the timer and the systemfunction tell us to
+  if (!ok) iterData.finalFlag = true;
+}
+
+StochasticalODE_SRA::
+StochasticalODE_SRA ( AbstractODE_Proxy& aProxy,
+		      ODE_Data& aData,
+		      Configuration& dynSysDescription,
+		      const SRA_Coefficients& aCoefficients ) :
+  Iterator ("StochasticalODE_SRA"),
+  proxy (aProxy),
+  coefficients (aCoefficients)
+{
+  int stateSpaceDim = (aData.initialStates[0]).getTotalSize ();
+
+  increments.initialize (dynSysDescription, stateSpaceDim);
+
+  stageStates.alloc (coefficients.stages);
+  stageRHS.alloc (coefficients.stages);
+
+  for (int s = 0; s < coefficients.stages; ++s)
+    {
+      stageStates[s].alloc (stateSpaceDim);
+      stageRHS[s].alloc (stateSpaceDim);
+    }
+}
+
+AbstractODE_Proxy* 
+StochasticalODE_SRA::
+getProxy ()
+{
+  return &proxy;
+}
@@ -75,4 +75,113 @@ public:
 
 };
 
+/**
+ * Coefficients of an explicit stochastic Runge-Kutta method of
+ * type SRA (A. Roessler, SIAM J. Numer. Anal. 48(3), 2010) for
+ * systems with additive noise, i.e. the noise does not depend on
+ * the state, as it is the case for all stochastical systems in AnT.
+ *
+ * The stages are
+ * \f[
+ *  H_i = X_n + h \sum_{j<i} a_{ij} f(H_j) + b_i \, g \, I_{(1,0)}/h
+ * \f]
+ * and the next state is
+ * \f[
+ *  X_{n+1} = X_n + h \sum_i \alpha_i f(H_i) + g \, \Delta W,
+ * \f]
+ * where \f$b_i\f$ are the row sums of \f$B^{(0)}\f$ of the
+ * original scheme (the noise intensity \f$g\f$ is constant) and
+ * \f$I_{(1,0)} = \int_0^h\int_0^s dW_u\,ds\f$.
+ *
+ * The strong order 1.5 requires (besides the deterministic order 2)
+ * \f$\sum_i \alpha_i b_i = 1\f$ and
+ * \f$\sum_i \alpha_i b_i^2 = 3/2\f$.
+ * For additive noise the Euler scheme (as well as the Milstein
+ * scheme, which coincides with it here) has the strong order 1.0.
+ */
+struct SRA_Coefficients
+{
+  enum {MAX_STAGES = 3};
+
+  int stages;
+  real_t a[MAX_STAGES][MAX_STAGES];
+  real_t b[MAX_STAGES];
+  real_t c[MAX_STAGES];
+  real_t alpha[MAX_STAGES];
+
+  /** two stages, deterministic order 2 */
+  static const SRA_Coefficients SRA1;
+
+  /**
+   * three stages, the drift part is the SSP Runge-Kutta method of
+   * order 3, the noise enters the last stage only
+   */
+  static const SRA_Coefficients SRA3;
+};
+
+/**
+ * Noise increments needed for one step of a SRA method.
+ * Three noise vectors are drawn per step: the first one gives
+ * \f$g\,\Delta W\f$, the difference of the other two (which
+ * cancels the mean value of the noise) the independent part
+ * of \f$g\,I_{(1,0)}\f$.
+ */
+class SRA_NoiseIncrements
+{
+private:
+  NoiseVectorCreator noiseVectorCreator;
+  Array<real_t> aux1;
+  Array<real_t> aux2;
+
+public:
+  /** \f$g\,\Delta W\f$ */
+  Array<real_t> deltaW;
+
+  /** \f$g\,I_{(1,0)}/h\f$ */
+  Array<real_t> deltaZ;
+
+  void initialize (Configuration& dynSysDescription,
+		   int stateSpaceDim);
+
+  /**
+   * draw the increments for the step size h
+   */
+  void create (real_t h);
+};
+
+/**
+ * stochastic Runge-Kutta method of type SRA for stochastical ODEs
+ * @see SRA_Coefficients
+ */
+class StochasticalODE_SRA : public Iterator
+{
+private:
+  // system function
+  AbstractODE_Proxy& proxy;
+
+  const SRA_Coefficients& coefficients;
+
+  SRA_NoiseIncrements increments;
+
+  Array<Array<real_t> > stageStates;
+  Array<Array<real_t> > stageRHS;
+
+public:
+  /**
+   * make one integration step
+   * @param iterdata ...
+   */
+  virtual void execute(IterData& iterData);
+
+  /**
+   * initialize the integrator
+   */
+  StochasticalODE_SRA (AbstractODE_Proxy& aProxy,
+		       ODE_Data& aData,
+		       Configuration& dynSysDescription,
+		       const SRA_Coefficients& aCoefficients);
+
+  virtual AbstractODE_Proxy* getProxy ();
+};
+
 #endif
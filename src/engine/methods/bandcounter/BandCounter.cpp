@@ -662,6 +662,15 @@ isPossible (ScanData& scanData)
 }
 
 
+/* *********************************************************************** */
+long
+BandCounter::
+getBandCount () const
+{
+  return bandCount;
+}
+
+
 /** ********************************************************************** */
 /** Method 1 getGCD                                                        */
 
@@ -117,6 +117,9 @@ public:
   /* *********************************************************************** */
   static bool isPossible (ScanData & scanData);  // true if method can be used
 
+  /* *********************************************************************** */
+  long getBandCount () const;                    // result for the current scan point
+
   /* *********************************************************************** */
   class M1Init : public IterTransition
   {
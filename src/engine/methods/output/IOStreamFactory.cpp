@@ -53,6 +53,12 @@ getOStream (const string& fileName,
   return getOStream (fileName.c_str (), scanData_ptr);
 }
 
+// virtual
+void
+IOStreamFactory::
+beginScanPoint (long pointNumber)
+{}
+
 // virtual 
 IOStreamFactory::
 ~IOStreamFactory () 
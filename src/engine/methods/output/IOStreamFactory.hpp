@@ -80,6 +80,14 @@ public:
    * @param stream the stream to be closed
    */
   virtual void closeOStream (ostream* stream) = 0; 
+
+  /**
+   * Announce the start of the scan point with the given number in
+   * the canonical scan order. Only called in sharded scans, where
+   * the output of the shards has to be merged later.
+   * Has no effect by default.
+   */
+  virtual void beginScanPoint (long pointNumber);
   
   /**
    * destructor
@@ -25,6 +25,7 @@
  */
 
 #include "LocalIOStreamFactory.hpp"
+#include "../utils/strconv/StringConverter.hpp"
 using std::ofstream;
 
 #define DEBUG__LOCAL_IOSTREAM_FACTORY_CPP 0
@@ -35,12 +36,52 @@ using std::map;
 map<const ostream*, string> streamNames;
 #endif /* DEBUG__LOCAL_IOSTREAM_FACTORY_CPP */
 
+LocalIOStreamFactory::
+LocalIOStreamFactory (long aShardIndex, long aNumberOfShards)
+  : shardIndex (aShardIndex),
+    numberOfShards (aNumberOfShards),
+    currentPointNumber (-1)
+{}
+
+// static
+string
+LocalIOStreamFactory::
+getShardFileName (const string& fileName,
+		  long anIndex,
+		  long aNumber)
+{
+  string result (fileName);
+
+  if (aNumber <= 1)
+    return result;
+
+  string tag = string (".shard-") + toString (anIndex)
+    + "-of-" + toString (aNumber);
+
+  /* insert the tag before the extension of the base name, if any: */
+  string::size_type slash = result.find_last_of ("/");
+  string::size_type dot = result.find_last_of (".");
+
+  if ( (dot != string::npos)
+       && ((slash == string::npos) || (dot > slash + 1)) )
+  {
+    result.insert (dot, tag);
+  }
+  else
+  {
+    result += tag;
+  }
+
+  return result;
+}
+
 ostream* 
 LocalIOStreamFactory::
 getOStream (const char* fileName,
 	    ScanData* scanData_ptr)
 {
-  ofstream *ofstr =  new ofstream (fileName);
+  ofstream *ofstr =  new ofstream
+    ( (getShardFileName (fileName, shardIndex, numberOfShards)).c_str () );
   openStreams.push_back (ofstr);
 #if DEBUG__LOCAL_IOSTREAM_FACTORY_CPP
 streamNames[ofstr] = string (fileName);
@@ -50,9 +91,27 @@ streamNames[ofstr] = string (fileName);
 
   printHeader (ofstr, scanData_ptr);
 
+  if (currentPointNumber >= 0)
+  {
+    (*ofstr) << SCAN_POINT_MARKER " " << currentPointNumber << endl;
+  }
+
   return ofstr;
 }
 
+// virtual
+void
+LocalIOStreamFactory::beginScanPoint (long pointNumber)
+{
+  currentPointNumber = pointNumber;
+
+  for (std::list<ofstream*>::iterator i = openStreams.begin ();
+       i != openStreams.end (); ++i)
+  {
+    (**i) << SCAN_POINT_MARKER " " << currentPointNumber << "\n";
+  }
+}
+
 void LocalIOStreamFactory::commit ()
 {}
 
@@ -32,6 +32,13 @@
 
 #include "IOStreamFactory.hpp"
 
+/**
+ * comment line, which precedes the output of each scan point in the
+ * output files of a sharded scan, followed by the number of the scan
+ * point. Used by 'AnT-merge-shards'.
+ */
+#define SCAN_POINT_MARKER "#@scanpoint"
+
 /**
  * LocalIOStreamFactory is the implementation of IOStreamFactory for
  * local operation of AnT. It provides an abstraction for opening and
@@ -42,7 +49,31 @@ class LocalIOStreamFactory : public IOStreamFactory
 private:
   std::list<std::ofstream*> openStreams;
 
+  /** shard of a sharded scan, see 'getShardFileName' */
+  long shardIndex;
+  long numberOfShards;
+
+  /** number of the current scan point, -1 before the first one */
+  long currentPointNumber;
+
 public:
+  /**
+   * @param aShardIndex, aNumberOfShards the shard of a sharded scan
+   * (standalone run with '--shard i/K'). The file names are tagged
+   * with the shard and the output of each scan point is preceded by
+   * a marker line.
+   */
+  LocalIOStreamFactory (long aShardIndex = 0, long aNumberOfShards = 1);
+
+  /**
+   * @return the file name tagged with the shard:
+   * 'period.tna' becomes 'period.shard-3-of-100.tna'.
+   * No tag for one shard.
+   */
+  static string getShardFileName (const string& fileName,
+				  long anIndex,
+				  long aNumber);
+
   /**
    * open a local file for writing
    * @param fileName the name of the file that should be opened
@@ -65,6 +96,12 @@ public:
    */
   void closeOStream (ostream* stream); 
 
+  /**
+   * write the marker of the scan point into all open files
+   * (sharded scan only)
+   */
+  virtual void beginScanPoint (long pointNumber);
+
   /**
    * destructor (closes open files)
    */
@@ -40,6 +40,9 @@ SVD_Calculator (ScanData& scanData,
 		MethodsData& methodsData)
 #if ANT_HAS_LIBLAPACK
     : calculate (NULL),
+      resetStatistics (NULL),
+      updateStatistics (NULL),
+      calculateFromStatistics (NULL),
       writeEvalues (NULL),
       writeEvectors (NULL),
       writeCovMatrix (NULL)
@@ -72,50 +75,155 @@ SVD_Calculator (ScanData& scanData,
 	   << ") needed by the singular value decomposition analysis."
 	   << endl << Error::Exit;
 
-  data.orbit.leastSize (numPoints);
-  
-  jobu = 'A';
-  jobvt = 'A';
-  
+  streaming = false;
+  if (methodDescription.checkForKey ("SVD_MODE_KEY"))
+    {
+      streaming = methodDescription.checkForEnumValue 
+	("SVD_MODE_KEY", "SVD_STREAMING_MODE_KEY");
+    }
+
   m   = data.getStateSpaceDim ();
-  lda = m;
-  ldu = m;
-  n     = ((long) numPoints)  / ((long) usingPoints);
-  ldvt  = n;
-  lwork = 2*std::max(3*std::min(m,n)+std::max(m,n),5*std::min(m,n)-4);
-
-  a  = (double *) malloc( m * n * sizeof(double));
-  if (a == NULL)
-    cerr << "can not allocate memory for 'a' in 'SVD_Calculator'" 
-	 << endl << Error::Exit;
-  
-  s  = (double *) malloc( m * sizeof(double));
-  if (s == NULL)
-    cerr << "can not allocate memory for 's' in 'SVD_Calculator'" 
-	 << endl << Error::Exit;
-  
-  u  = (double *) malloc( m * m * sizeof(double));
-  if (u == NULL)
-    cerr << "can not allocate memory for 'u' in 'SVD_Calculator'" 
-	 << endl << Error::Exit;
-  
-  /*
-    vt = NULL; 
-  */
-  vt  = (double *) malloc( n * n * sizeof(double));
-  if (vt == NULL)
-    cerr << "can not allocate memory for 'vt' in 'SVD_Calculator'" 
-	 << endl << Error::Exit;
-  
-  work = (double *) malloc( lwork * sizeof(double));
-  if (work == NULL)
-    cerr << "can not allocate memory for 'work' in 'SVD_Calculator'" 
-	 << endl << Error::Exit;
-  
-  
+  n   = ((long) numPoints)  / ((long) usingPoints);
+
+  numComponents = m;
+  if (methodDescription.checkForKey ("PRINCIPAL_COMPONENTS_KEY"))
+    {
+      int k = methodDescription.getInteger ("PRINCIPAL_COMPONENTS_KEY");
+      if ((k > 0) && (k < m))
+	numComponents = k;
+    }
+
+  a = s = u = vt = work = NULL;
+  block = mean = scatter = NULL;
+  isuppz = iwork = NULL;
+
+  if (streaming)
+    {
+      // the orbit is not needed, but the moment matrix:
+      blockSize = 64;
+      if (methodDescription.checkForKey ("BLOCK_SIZE_KEY"))
+	blockSize = methodDescription.getInteger ("BLOCK_SIZE_KEY");
+      if (blockSize > n)
+	blockSize = n;
+
+      lda = m;
+      ldu = m;
+
+      a = (double *) malloc( m * m * sizeof(double));
+      if (a == NULL)
+	cerr << "can not allocate memory for 'a' in 'SVD_Calculator'" 
+	     << endl << Error::Exit;
+
+      s = (double *) malloc( m * sizeof(double));
+      if (s == NULL)
+	cerr << "can not allocate memory for 's' in 'SVD_Calculator'" 
+	     << endl << Error::Exit;
+
+      u = (double *) malloc( m * numComponents * sizeof(double));
+      if (u == NULL)
+	cerr << "can not allocate memory for 'u' in 'SVD_Calculator'" 
+	     << endl << Error::Exit;
+
+      block = (double *) malloc( m * blockSize * sizeof(double));
+      if (block == NULL)
+	cerr << "can not allocate memory for 'block' in 'SVD_Calculator'" 
+	     << endl << Error::Exit;
+
+      mean = (double *) malloc( m * sizeof(double));
+      if (mean == NULL)
+	cerr << "can not allocate memory for 'mean' in 'SVD_Calculator'" 
+	     << endl << Error::Exit;
+
+      scatter = (double *) malloc( m * m * sizeof(double));
+      if (scatter == NULL)
+	cerr << "can not allocate memory for 'scatter' in 'SVD_Calculator'" 
+	     << endl << Error::Exit;
+
+      isuppz = (int *) malloc( 2 * m * sizeof(int));
+      if (isuppz == NULL)
+	cerr << "can not allocate memory for 'isuppz' in 'SVD_Calculator'" 
+	     << endl << Error::Exit;
+
+      // workspace query:
+      char jobz = 'V';
+      char range = 'I';
+      char uplo = 'U';
+      double vl = 0.0;
+      double vu = 0.0;
+      int il = m - numComponents + 1;
+      int iu = m;
+      double abstol = 0.0;
+      int found;
+      double optimalWork;
+      int optimalIWork;
+      int query = -1;
+
+      dsyevr_ (&jobz, &range, &uplo, &m, a, &lda, &vl, &vu, &il, &iu,
+	       &abstol, &found, s, u, &ldu, isuppz,
+	       &optimalWork, &query, &optimalIWork, &query, &info);
+
+      lwork  = std::max ((int) optimalWork, 26*m);
+      liwork = std::max (optimalIWork, 10*m);
+
+      work = (double *) malloc( lwork * sizeof(double));
+      if (work == NULL)
+	cerr << "can not allocate memory for 'work' in 'SVD_Calculator'" 
+	     << endl << Error::Exit;
+
+      iwork = (int *) malloc( liwork * sizeof(int));
+      if (iwork == NULL)
+	cerr << "can not allocate memory for 'iwork' in 'SVD_Calculator'" 
+	     << endl << Error::Exit;
+
+      resetStatistics = new ResetStatistics (*this);
+      updateStatistics = new UpdateStatistics (*this);
+      calculateFromStatistics = new CalculateFromStatistics (*this);
+    }
+  else
+    {
+      data.orbit.leastSize (numPoints);
+
+      jobu = 'A';
+      jobvt = 'A';
+
+      lda = m;
+      ldu = m;
+      ldvt  = n;
+      lwork = 2*std::max(3*std::min(m,n)+std::max(m,n),5*std::min(m,n)-4);
+
+      a  = (double *) malloc( m * n * sizeof(double));
+      if (a == NULL)
+	cerr << "can not allocate memory for 'a' in 'SVD_Calculator'" 
+	     << endl << Error::Exit;
+
+      s  = (double *) malloc( m * sizeof(double));
+      if (s == NULL)
+	cerr << "can not allocate memory for 's' in 'SVD_Calculator'" 
+	     << endl << Error::Exit;
+
+      u  = (double *) malloc( m * m * sizeof(double));
+      if (u == NULL)
+	cerr << "can not allocate memory for 'u' in 'SVD_Calculator'" 
+	     << endl << Error::Exit;
+
+      /*
+	vt = NULL; 
+      */
+      vt  = (double *) malloc( n * n * sizeof(double));
+      if (vt == NULL)
+	cerr << "can not allocate memory for 'vt' in 'SVD_Calculator'" 
+	     << endl << Error::Exit;
+
+      work = (double *) malloc( lwork * sizeof(double));
+      if (work == NULL)
+	cerr << "can not allocate memory for 'work' in 'SVD_Calculator'" 
+	     << endl << Error::Exit;
+
+
+      calculate = new Calculate (*this, scanData, methodDescription);
+    }
+
   // create 'sub-objects':
-  calculate = new Calculate (*this, scanData, methodDescription);
-  
   if ( methodDescription.getBool ("EVAL_KEY") )
     {
       writeEvalues = new WriteEvalues 
@@ -180,13 +288,15 @@ execute (IterData& iterData)
   long k;
   real_t norm = sqrt(owner.numPoints);
 
+  // 'a' is stored column-major (one state per column), as
+  // expected by 'dgesvd_':
   for (j = 0, k = 0;
-       k > -owner.numPoints;
+       (k > -owner.numPoints) && (j < owner.n);
        ++j, k -= owner.usingPoints)
     {
       for(i=0; i < owner.m; i++)
 	{
-	  owner.a[ i*owner.n + j ] = iterData.dynSysData.orbit[k][i]/norm;
+	  owner.a[ j*owner.m + i ] = iterData.dynSysData.orbit[k][i]/norm;
 	}
     }
 
@@ -202,6 +312,197 @@ execute (IterData& iterData)
 
 //#####################################
 
+void
+SVD_Calculator::
+flushBlock ()
+{
+  if (blockFill == 0)
+    return;
+
+  int i;
+  int j;
+  int b = blockFill;
+
+  // mean of the block and the centered block:
+  for (i = 0; i < m; ++i)
+    {
+      double blockMean = 0.0;
+      for (j = 0; j < b; ++j)
+	blockMean += block[j*m + i];
+      blockMean /= b;
+
+      for (j = 0; j < b; ++j)
+	block[j*m + i] -= blockMean;
+
+      // 'work' is not used before the final decomposition,
+      // hence the difference of the means can be stored here:
+      work[i] = blockMean - mean[i];
+    }
+
+  // scatter += (centered block) * (centered block)^T
+  char uplo = 'U';
+  char trans = 'N';
+  double alpha = 1.0;
+  double beta = 1.0;
+
+  dsyrk_ (&uplo, &trans, &m, &b, &alpha, block, &m, 
+	  &beta, scatter, &m);
+
+  // Chan's combination of the two partial results:
+  double total = (double) (count + b);
+  double factor = ((double) count) * ((double) b) / total;
+
+  for (j = 0; j < m; ++j)
+    for (i = 0; i <= j; ++i)
+      scatter[j*m + i] += factor * work[i] * work[j];
+
+  for (i = 0; i < m; ++i)
+    mean[i] += work[i] * ((double) b) / total;
+
+  count += b;
+  blockFill = 0;
+}
+
+//#####################################
+
+SVD_Calculator::
+ResetStatistics::
+ResetStatistics (SVD_Calculator & aOwner) :
+  IterTransition ("SVD_Calculator::ResetStatistics"),
+  owner (aOwner)
+{}
+
+// virtual 
+void 
+SVD_Calculator::
+ResetStatistics::
+execute (IterData& iterData)
+{
+  owner.count = 0;
+  owner.blockFill = 0;
+
+  for (int i = 0; i < owner.m; ++i)
+    owner.mean[i] = 0.0;
+
+  for (int i = 0; i < owner.m * owner.m; ++i)
+    owner.scatter[i] = 0.0;
+}
+
+//#####################################
+
+SVD_Calculator::
+UpdateStatistics::
+UpdateStatistics (SVD_Calculator & aOwner) :
+  IterTransition ("SVD_Calculator::UpdateStatistics"),
+  owner (aOwner)
+{}
+
+// virtual 
+void 
+SVD_Calculator::
+UpdateStatistics::
+execute (IterData& iterData)
+{
+  DynSysData& data = iterData.dynSysData;
+
+  // the states at the times 'stopTime', 'stopTime - usingPoints',
+  // ... are used, exactly as in the orbit mode:
+  long distance = data.timer.getStopTime () - data.timer.getCurrentTime ();
+
+  if ( (distance < 0) 
+       || (distance >= owner.numPoints)
+       || (distance % owner.usingPoints != 0) 
+       || (distance / owner.usingPoints >= owner.n) )
+    return;
+
+  Array<real_t>& state = data.orbit[0];
+  double* column = owner.block + owner.blockFill * owner.m;
+
+  for (int i = 0; i < owner.m; ++i)
+    column[i] = state[i];
+
+  ++(owner.blockFill);
+
+  if (owner.blockFill == owner.blockSize)
+    owner.flushBlock ();
+}
+
+//#####################################
+
+SVD_Calculator::
+CalculateFromStatistics::
+CalculateFromStatistics (SVD_Calculator & aOwner) :
+  IterTransition ("SVD_Calculator::CalculateFromStatistics"),
+  owner (aOwner)
+{}
+
+// virtual 
+void 
+SVD_Calculator::
+CalculateFromStatistics::
+execute (IterData& iterData)
+{
+  owner.flushBlock ();
+
+  if (owner.count == 0)
+    {
+      cout << "SVD_Calculator WARNING: no states are accumulated. "
+	   << "Calculation can not be performed."
+	   << endl;
+      
+      return;
+    }
+
+  int i;
+  int j;
+  int m = owner.m;
+
+  // sum of x * x^T (upper triangle) from scatter matrix and mean,
+  // normalized as in the orbit mode. Hence its eigenvalues are the
+  // squared singular values calculated in the orbit mode.
+  double norm = (double) owner.numPoints;
+  for (j = 0; j < m; ++j)
+    for (i = 0; i <= j; ++i)
+      owner.a[j*m + i] 
+	= ( owner.scatter[j*m + i] 
+	    + owner.count * owner.mean[i] * owner.mean[j] ) / norm;
+
+  char jobz = 'V';
+  char range = 'I';
+  char uplo = 'U';
+  double vl = 0.0;
+  double vu = 0.0;
+  int il = m - owner.numComponents + 1;
+  int iu = m;
+  double abstol = 0.0;
+  int found;
+
+  dsyevr_ (&jobz, &range, &uplo, &m, owner.a, &owner.lda, 
+	   &vl, &vu, &il, &iu, &abstol, &found, 
+	   owner.s, owner.u, &owner.ldu, owner.isuppz,
+	   owner.work, &owner.lwork, owner.iwork, &owner.liwork, 
+	   &owner.info);
+
+  if (owner.info != 0)
+    cerr << "'SVD_Calculator::CalculateFromStatistics': "
+	 << "dsyevr_ performed not correctly"
+	 << endl << Error::Exit; 
+
+  // 'dsyevr_' delivers the eigenvalues in ascending order, 
+  // but the singular values are expected in descending order:
+  for (i = 0, j = found - 1; i < j; ++i, --j)
+    {
+      std::swap (owner.s[i], owner.s[j]);
+      for (int k = 0; k < m; ++k)
+	std::swap (owner.u[i*m + k], owner.u[j*m + k]);
+    }
+
+  for (i = 0; i < found; ++i)
+    owner.s[i] = (owner.s[i] > 0.0) ? sqrt (owner.s[i]) : 0.0;
+}
+
+//#####################################
+
 SVD_Calculator::
 WriteEvalues::
 WriteEvalues ( SVD_Calculator & aOwner,
@@ -222,7 +523,7 @@ SVD_Calculator::
 WriteEvalues::
 execute (ScanData& scanData)
 {
-    for(int i=0; i < owner.m; i++)
+    for(int i=0; i < owner.numComponents; i++)
     {
 	(*f) << scanData 
 	     << " " 
@@ -254,7 +555,7 @@ SVD_Calculator::
 WriteEvectors::
 execute (ScanData& scanData)
 {
-  for(int i=0; i < owner.m; i++)
+  for(int i=0; i < owner.numComponents; i++)
     {
       for(int j=0; j < owner.m; j++)
 	{
@@ -286,6 +587,25 @@ SVD_Calculator::
 WriteCovMatrix::
 execute (ScanData& scanData)
 {
+  if (owner.streaming)
+    {
+      // the (m x m) covariance matrix, only its upper triangle is stored
+      for(int i=0; i < owner.m; i++)
+	{
+	  for(int j=0; j < owner.m; j++)
+	    {
+	      int k = (i <= j) ? (j*owner.m+i) : (i*owner.m+j);
+	      real_t cov = (owner.count > 0) ? 
+		owner.scatter[k] / owner.count : 0.0;
+
+	      (*f) << scanData << " " << cov;
+	    } 
+	  (*f) << endl;
+	}
+
+      return;
+    }
+
   for(int i=0; i < owner.n; i++)
     {
       for(int j=0; j < owner.n; j++)
@@ -306,12 +626,29 @@ SVD_Calculator::
 
   if (calculate != NULL)
     delete calculate;
+  if (resetStatistics != NULL)
+    delete resetStatistics;
+  if (updateStatistics != NULL)
+    delete updateStatistics;
+  if (calculateFromStatistics != NULL)
+    delete calculateFromStatistics;
   if (writeEvalues != NULL)
     delete writeEvalues;
   if (writeEvectors != NULL)
     delete writeEvectors;
   if (writeCovMatrix != NULL)
     delete writeCovMatrix;
+
+  free (a);
+  free (s);
+  free (u);
+  free (vt);
+  free (work);
+  free (block);
+  free (mean);
+  free (scatter);
+  free (isuppz);
+  free (iwork);
 #endif
 }
 
@@ -322,7 +659,14 @@ void SVD_Calculator::connect (PrePostStateMachine& scanMachine,
 			      Configuration & ini)
 {    	       
 #if ANT_HAS_LIBLAPACK
-  iterMachine.post.add (calculate);
+  if (streaming)
+    {
+      iterMachine.pre.add (resetStatistics);
+      iterMachine.addToIterLoop (updateStatistics);
+      iterMachine.post.add (calculateFromStatistics);
+    }
+  else
+    iterMachine.post.add (calculate);
   if (writeEvalues != NULL)
     scanMachine.transition.add (writeEvalues);
   if (writeEvectors != NULL)
@@ -42,12 +42,36 @@ int dgesvd_( char *jobu, char *jobvt, int *m, int *n,
 	     double *a, int *lda, double *s, double *u, int *ldu,
 	     double *vt, int *ldvt, double *work, int *lwork,
 	     int *info);
+
+int dsyrk_ ( char *uplo, char *trans, int *n, int *k,
+	     double *alpha, double *a, int *lda,
+	     double *beta, double *c, int *ldc );
+
+int dsyevr_ ( char *jobz, char *range, char *uplo, int *n,
+	      double *a, int *lda, double *vl, double *vu,
+	      int *il, int *iu, double *abstol, int *m,
+	      double *w, double *z, int *ldz, int *isuppz,
+	      double *work, int *lwork, int *iwork, int *liwork,
+	      int *info );
 }
 #endif
 
 /**
  * Constructor SVD_Calculator
  * 
+ * Two calculation modes are supported:
+ * - 'orbit': the last 'numPoints' states are taken from the stored
+ *   orbit and the singular value decomposition of the complete data
+ *   matrix is performed once per scan point.
+ * - 'streaming': the same states are accumulated on the fly into a
+ *   running mean and scatter matrix (Welford/Chan update, performed in
+ *   blocks of 'blockSize' states via BLAS-3), hence the orbit is not
+ *   stored at all. Only the leading 'numComponents' eigenpairs of the
+ *   resulting (m x m) moment matrix are calculated.
+ *
+ * Both modes use the same states and the same normalization, hence
+ * they deliver the same singular values and left singular vectors.
+ *
  * @todo The logic of the usingPoints and numPoints variables 
  * is to be discussed.
  */
@@ -60,6 +84,19 @@ public:
   // lokale Vars vom Konstruktor  
   int numPoints;
   int usingPoints;
+
+  /**
+   * 'true' if the covariances are accumulated during the iteration
+   * instead of being calculated from the stored orbit.
+   */
+  bool streaming;
+
+  /**
+   * number of leading principal components to be calculated and
+   * written. Equal to the state space dimension if all of them are
+   * needed.
+   */
+  int numComponents;
   
 #if ANT_HAS_LIBLAPACK
 
@@ -77,8 +114,33 @@ public:
   double * work; 
   int lwork; 
   int info;
-  
-  
+
+  /* streaming mode: */
+
+  /** number of states collected in a block before the update */
+  int blockSize;
+  /** current number of states in the block */
+  int blockFill;
+  /** block of states (m x blockSize, column-major) */
+  double * block;
+  /** running mean (m) */
+  double * mean;
+  /** running scatter matrix (m x m, upper triangle used) */
+  double * scatter;
+  /** number of states accumulated so far */
+  long count;
+
+  /* workspace for 'dsyevr_' */
+  int * isuppz;
+  int * iwork;
+  int liwork;
+
+  /**
+   * add the states collected in 'block' to the running mean and
+   * scatter matrix and empty the block.
+   */
+  void flushBlock ();
+
   class Calculate  : public IterTransition
   {
   private:
@@ -93,6 +155,51 @@ public:
     // ~Calculate ();
   };
 
+  /**
+   * streaming mode: reset the running statistics before the
+   * iteration starts.
+   */
+  class ResetStatistics : public IterTransition
+  {
+  private:
+    SVD_Calculator & owner;
+    
+  public:
+    ResetStatistics (SVD_Calculator & aOwner);
+
+    virtual void execute (IterData& iterData);
+  };
+
+  /**
+   * streaming mode: add the current state to the running statistics,
+   * if it belongs to the states which would be used in the orbit mode.
+   */
+  class UpdateStatistics : public IterTransition
+  {
+  private:
+    SVD_Calculator & owner;
+    
+  public:
+    UpdateStatistics (SVD_Calculator & aOwner);
+
+    virtual void execute (IterData& iterData);
+  };
+
+  /**
+   * streaming mode: calculate the leading eigenpairs of the
+   * accumulated moment matrix.
+   */
+  class CalculateFromStatistics : public IterTransition
+  {
+  private:
+    SVD_Calculator & owner;
+    
+  public:
+    CalculateFromStatistics (SVD_Calculator & aOwner);
+
+    virtual void execute (IterData& iterData);
+  };
+
   class WriteEvalues : public ScanTransition
   {
   private:
@@ -139,6 +246,9 @@ public:
 
 
   Calculate*       calculate;
+  ResetStatistics*  resetStatistics;
+  UpdateStatistics* updateStatistics;
+  CalculateFromStatistics* calculateFromStatistics;
   WriteEvalues*    writeEvalues;
   WriteEvectors*   writeEvectors;
   WriteCovMatrix*  writeCovMatrix;
@@ -328,7 +328,8 @@ void SipaBackOrbitLayer::buildEdges(){
   if(!m_pDefaultCellVector->empty()){
 
     // get the mapping for every cell and add the cells of the boxes, if not NULL,
-    // as new edges.
+    // as new edges. The boxes are mapped in blocks, so that the box manager
+    // can map the boxes of a block concurrently.
 
     //cout << "0%..." << endl;
 
@@ -340,25 +341,41 @@ void SipaBackOrbitLayer::buildEdges(){
     SipaSolutionDistanceCellVector::iterator it  = m_pDefaultCellVector->begin();
     SipaSolutionDistanceCellVector::iterator end = m_pDefaultCellVector->end();
 
+    const int blockSize = 1024;
+
+    SipaSolutionDistanceCellVector blockCells;
+    SymbolicImageAbstractBoxManager::SymbolicImageAbstractBoxVector blockBoxes;
+    vector<SymbolicImageAbstractBoxManager::SymbolicImageAbstractBoxVector> blockTargetBoxes;
+
     while( it != end ){
 
-      progressCounter.increase();
+      blockCells.clear();
+      blockBoxes.clear();
+      blockTargetBoxes.clear();
 
-      SipaSolutionDistanceCell* cell = (*it);
-      SymbolicImageAbstractBoxManager::SymbolicImageAbstractBoxVector targetBoxes;
+      while( (it != end) && (static_cast<int> (blockCells.size()) < blockSize) ){
+        blockCells.push_back(*it);
+        blockBoxes.push_back((*it)->getBox());
+        it++;
+      }
 
-      m_pBackOrbitBoxManager->getBoxMapping(cell->getBox(),targetBoxes);
+      m_pBackOrbitBoxManager->getBoxMappings(blockBoxes,blockTargetBoxes);
 
-      SymbolicImageAbstractBoxManager::SymbolicImageAbstractBoxVector::iterator tarit  = targetBoxes.begin();
-      SymbolicImageAbstractBoxManager::SymbolicImageAbstractBoxVector::iterator tarend = targetBoxes.end();
+      for(unsigned int i=0; i<blockCells.size(); i++){
 
-      while(tarit != tarend){
-        SipaSolutionDistanceCell* newEdge = DOWN_CAST< SipaSolutionDistanceCell* > ((*tarit)->getCell());
-        newEdge->setTargetCell(cell); // cout << "added: " << newEdge->getCellNumber() << " " << cell->getCellNumber() << endl;
-        tarit++;
-      }
+        progressCounter.increase();
 
-      it++;
+        SipaSolutionDistanceCell* cell = blockCells[i];
+
+        SymbolicImageAbstractBoxManager::SymbolicImageAbstractBoxVector::iterator tarit  = blockTargetBoxes[i].begin();
+        SymbolicImageAbstractBoxManager::SymbolicImageAbstractBoxVector::iterator tarend = blockTargetBoxes[i].end();
+
+        while(tarit != tarend){
+          SipaSolutionDistanceCell* newEdge = DOWN_CAST< SipaSolutionDistanceCell* > ((*tarit)->getCell());
+          newEdge->setTargetCell(cell); // cout << "added: " << newEdge->getCellNumber() << " " << cell->getCellNumber() << endl;
+          tarit++;
+        }
+      }
     }
 
   }
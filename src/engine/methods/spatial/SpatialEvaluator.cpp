@@ -279,6 +279,231 @@ execute (IterData& iterData)
 }
 
 
+/* *********************************************************************** */
+SpatialEvaluator::
+WriteSpatialCorrelationByDistance::
+WriteSpatialCorrelationByDistance (SpatialEvaluator & aOwner,
+				   const string& fileName,
+				   ScanData& aScanData,
+				   int aNumberOfCells,
+				   int aCellDim): 
+  IterTransition ("SpatialEvaluator::WriteSpatialCorrelationByDistance"),
+  owner (aOwner),
+  scanData (aScanData),
+  numberOfCells (aNumberOfCells),
+  cellDim (aCellDim),
+  maxDistance (aNumberOfCells / 2),
+  numberOfSnapshots (0),
+  resetter (*this),
+  writer (*this)
+{
+  f = ioStreamFactory->getOStream (fileName, &scanData);
+
+  sumCov.alloc (cellDim);
+  for (int i = 0; i < cellDim; ++i)
+    {
+      sumCov[i].alloc (maxDistance + 1, 0.0);
+    }
+
+#if (ANT_HAS_LIBFFTW == 2)
+  fftwArray = (fftw_complex*) 
+    malloc (numberOfCells * sizeof (fftw_complex));
+  fftwSpectrum = (fftw_complex*) 
+    malloc (numberOfCells * sizeof (fftw_complex));
+
+  forwardPlan 
+    = fftw_create_plan (numberOfCells, FFTW_FORWARD, FFTW_ESTIMATE);
+  backwardPlan
+    = fftw_create_plan (numberOfCells, FFTW_BACKWARD, FFTW_ESTIMATE);
+#elif ANT_HAS_LIBFFTW
+  fftwArray = (fftw_complex*) 
+    fftw_malloc (numberOfCells * sizeof (fftw_complex));
+  fftwSpectrum = (fftw_complex*) 
+    fftw_malloc (numberOfCells * sizeof (fftw_complex));
+
+  forwardPlan
+    = fftw_plan_dft_1d ( numberOfCells,
+			 fftwArray,
+			 fftwSpectrum,
+			 FFTW_FORWARD,
+			 FFTW_ESTIMATE );
+  backwardPlan
+    = fftw_plan_dft_1d ( numberOfCells,
+			 fftwSpectrum,
+			 fftwArray,
+			 FFTW_BACKWARD,
+			 FFTW_ESTIMATE );
+#else
+  deviations.alloc (numberOfCells);
+#endif
+}
+
+SpatialEvaluator::
+WriteSpatialCorrelationByDistance::
+~WriteSpatialCorrelationByDistance ()
+{
+#if (ANT_HAS_LIBFFTW == 2)
+  free (fftwArray);
+  free (fftwSpectrum);
+  fftw_destroy_plan (forwardPlan);
+  fftw_destroy_plan (backwardPlan);
+#elif ANT_HAS_LIBFFTW
+  fftw_free (fftwArray);
+  fftw_free (fftwSpectrum);
+  fftw_destroy_plan (forwardPlan);
+  fftw_destroy_plan (backwardPlan);
+#endif
+}
+
+void
+SpatialEvaluator::
+WriteSpatialCorrelationByDistance::
+addSnapshot (const Array<real_t>& state, int component)
+{
+  int N = numberOfCells;
+
+  real_t mean = 0;
+  for (int j = 0; j < N; ++j)
+    {
+      mean += state[j*cellDim + component];
+    }
+  mean /= ((real_t) N);
+
+  Array<real_t>& sum = sumCov[component];
+
+#if ANT_HAS_LIBFFTW
+  for (int j = 0; j < N; ++j)
+    {
+      c_re (fftwArray[j]) = state[j*cellDim + component] - mean;
+      c_im (fftwArray[j]) = 0.0;
+    }
+
+#if (ANT_HAS_LIBFFTW == 2)
+  fftw_one (forwardPlan, fftwArray, fftwSpectrum);
+#else
+  fftw_execute (forwardPlan);
+#endif
+
+  // power spectrum:
+  for (int k = 0; k < N; ++k)
+    {
+      c_re (fftwSpectrum[k]) 
+	= sq (c_re (fftwSpectrum[k])) + sq (c_im (fftwSpectrum[k]));
+      c_im (fftwSpectrum[k]) = 0.0;
+    }
+
+#if (ANT_HAS_LIBFFTW == 2)
+  fftw_one (backwardPlan, fftwSpectrum, fftwArray);
+#else
+  fftw_execute (backwardPlan);
+#endif
+
+  // both transformations are not normalized, hence the factor N^2.
+  // The auto-covariance is normalized by N as well:
+  real_t norm = ((real_t) N) * ((real_t) N);
+  for (int d = 0; d <= maxDistance; ++d)
+    {
+      sum[d] += c_re (fftwArray[d]) / norm;
+    }
+#else
+  for (int j = 0; j < N; ++j)
+    {
+      deviations[j] = state[j*cellDim + component] - mean;
+    }
+
+  for (int d = 0; d <= maxDistance; ++d)
+    {
+      real_t cov = 0;
+      for (int j = 0; j < N; ++j)
+	{
+	  int k = j + d;
+	  if (k >= N) 
+	    k -= N;
+	  cov += deviations[j] * deviations[k];
+	}
+      sum[d] += cov / ((real_t) N);
+    }
+#endif
+}
+
+void
+SpatialEvaluator::
+WriteSpatialCorrelationByDistance::
+execute (IterData& iterData)
+{
+  const Array<real_t>& state = iterData.dynSysData.orbit[0];
+
+  for (int i = 0; i < cellDim; ++i)
+    {
+      addSnapshot (state, i);
+    }
+
+  ++numberOfSnapshots;
+}
+
+SpatialEvaluator::
+WriteSpatialCorrelationByDistance::
+Resetter::
+Resetter (WriteSpatialCorrelationByDistance& anOwner) :
+  IterTransition 
+  ("SpatialEvaluator::WriteSpatialCorrelationByDistance::Resetter"),
+  owner (anOwner)
+{}
+
+void
+SpatialEvaluator::
+WriteSpatialCorrelationByDistance::
+Resetter::
+execute (IterData& iterData)
+{
+  for (int i = 0; i < owner.cellDim; ++i)
+    {
+      owner.sumCov[i].setAll (0.0);
+    }
+
+  owner.numberOfSnapshots = 0;
+}
+
+SpatialEvaluator::
+WriteSpatialCorrelationByDistance::
+Writer::
+Writer (WriteSpatialCorrelationByDistance& anOwner) :
+  IterTransition 
+  ("SpatialEvaluator::WriteSpatialCorrelationByDistance::Writer"),
+  owner (anOwner)
+{}
+
+void
+SpatialEvaluator::
+WriteSpatialCorrelationByDistance::
+Writer::
+execute (IterData& iterData)
+{
+  if (owner.numberOfSnapshots == 0)
+    return;
+
+  ostream& f = *(owner.f);
+
+  for (int d = 0; d <= owner.maxDistance; ++d)
+    {
+      f << owner.scanData << " " << d;
+
+      for (int i = 0; i < owner.cellDim; ++i)
+	{
+	  real_t variance = owner.sumCov[i][0];
+
+	  // spatially homogeneous states are not correlated:
+	  real_t corr = (variance > 0) ? 
+	    (owner.sumCov[i][d] / variance) : 0.0;
+
+	  f << " " << corr;
+	}
+
+      f << endl;
+    }
+}
+
+
 /* *********************************************************************** */
 SpatialEvaluator::
 WriteSpatialWaveNumbers::
@@ -556,7 +781,9 @@ SpatialEvaluator ( ScanData& scanData,
   writeSpatialMeanValueConditionalTransition (NULL),
   writeSpatialStdDevConditionalTransition (NULL),
   writeSpatialAverageCorrelationConditionalTransition (NULL),
-  writeSpatialWaveNumbersConditionalTransition (NULL)
+  writeSpatialCorrelationByDistanceConditionalTransition (NULL),
+  writeSpatialWaveNumbersConditionalTransition (NULL),
+  writeSpatialCorrelationByDistance (NULL)
 {
 
   // ---------------------------------------------------------- //
@@ -732,6 +959,66 @@ SpatialEvaluator ( ScanData& scanData,
     }
 
 
+  /* -------------------- */
+  bool saveSpatialCorrelationByDistanceOption = 
+    methodsDescription.checkForKey ("CORRELATION_BY_DISTANCE_KEY") ?
+    methodsDescription.getBool ("CORRELATION_BY_DISTANCE_KEY") : false;  
+  
+  if (saveSpatialCorrelationByDistanceOption)
+    {
+      int numberOfCells = 0;
+      int cellDim = 0;
+
+      DynSysData* dataPtr = &(scanData.iterData().dynSysData);
+
+      if (dynamic_cast<CML_Data*> (dataPtr) != NULL)
+	{
+	  CML_Data* cmlDataPtr = dynamic_cast<CML_Data*> (dataPtr);
+	  numberOfCells = cmlDataPtr->numberOfCells;
+	  cellDim = cmlDataPtr->cellDim;
+	}
+      else if (dynamic_cast<CODEL_Data*> (dataPtr) != NULL)
+	{
+	  CODEL_Data* codelDataPtr = dynamic_cast<CODEL_Data*> (dataPtr);
+	  numberOfCells = codelDataPtr->numberOfCells;
+	  cellDim = codelDataPtr->cellDim;
+	}
+      else 
+	{
+	  PDE_Data* pdeDataPtr = dynamic_cast<PDE_Data*> (dataPtr);
+	  assert (pdeDataPtr != NULL);
+	  numberOfCells = pdeDataPtr->numberOfCells;
+	  cellDim = pdeDataPtr->cellDim;
+	}
+
+      // not a local variable, because the internal resetter and
+      // writer have to be connected as well. It will be destructed
+      // together with the conditional transition.
+      writeSpatialCorrelationByDistance
+	= new WriteSpatialCorrelationByDistance 
+	(*this,
+	 methodsDescription.getString ("CORRELATION_BY_DISTANCE_FILE_KEY"),
+	 scanData,
+	 numberOfCells,
+	 cellDim);
+      
+      writeSpatialCorrelationByDistanceConditionalTransition =
+	new ConditionalTransition (writeSpatialCorrelationByDistance);
+      
+      if (transientCondition != NULL)
+	{
+	  writeSpatialCorrelationByDistanceConditionalTransition
+	    ->addCondition (transientCondition);
+	}
+      
+      if (stepCondition != NULL)
+	{
+	  writeSpatialCorrelationByDistanceConditionalTransition
+	    ->addCondition (stepCondition);
+	}
+    }
+
+
   /* -------------------- */
   bool saveSpatialWaveNumbers = 
     methodsDescription.checkForKey ("WAVE_NUMBERS_KEY") ?
@@ -1098,6 +1385,18 @@ connect (PrePostStateMachine& scanMachine,
 	(writeSpatialAverageCorrelationConditionalTransition); 
     }
 
+  if (writeSpatialCorrelationByDistanceConditionalTransition != NULL)
+    {
+      iterMachine.pre.add 
+	(&(writeSpatialCorrelationByDistance->resetter));
+
+      iterMachine.addToIterLoop
+	(writeSpatialCorrelationByDistanceConditionalTransition); 
+
+      iterMachine.post.add 
+	(&(writeSpatialCorrelationByDistance->writer));
+    }
+
   if (writeSpatialWaveNumbersConditionalTransition != NULL)
     {
       iterMachine.addToIterLoop
@@ -1135,6 +1434,9 @@ SpatialEvaluator::
   if (writeSpatialAverageCorrelationConditionalTransition != NULL) 
     delete writeSpatialAverageCorrelationConditionalTransition;
 
+  if (writeSpatialCorrelationByDistanceConditionalTransition != NULL) 
+    delete writeSpatialCorrelationByDistanceConditionalTransition;
+
   if (writeSpatialWaveNumbersConditionalTransition != NULL) 
     delete writeSpatialWaveNumbersConditionalTransition;
 
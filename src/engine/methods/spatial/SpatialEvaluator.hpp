@@ -38,6 +38,20 @@ using std::map;
 #include "utils/conditions/OutputConditions.hpp"
 #include "methods/output/IOStreamFactory.hpp"
 
+#if ANT_HAS_LIBFFTW
+#if (ANT_HAS_LIBFFTW == 2)
+#include <fftw.h>
+#else
+#include <fftw3.h>
+#ifndef c_re
+#define c_re(c) ((c)[0])
+#endif
+#ifndef c_im
+#define c_im(c) ((c)[1])
+#endif
+#endif /* (ANT_HAS_LIBFFTW == 2) */
+#endif /* ANT_HAS_LIBFFTW */
+
 
 /**
  * Several simple evaluations specific for spatial inhomogenuous dynamical
@@ -142,6 +156,101 @@ public:
 
 
 
+/**
+ * Spatial auto-correlation as a function of the distance between
+ * cells, averaged over time. The lattice is assumed to be
+ * translation-invariant (periodic), hence for each component the
+ * correlation of a snapshot is obtained from its power spectrum
+ * (Wiener-Khinchin) with O(N log N) costs and O(N) memory, if the
+ * fftw library is available. Otherwise the circular correlation is
+ * summed up directly for all distances.
+ *
+ * The time-averaged auto-covariances are accumulated within the
+ * iteration (conditional transition, i.e. after transient and each
+ * 'points step'), the normalized correlation versus distance is
+ * written by the internal writer at the end of each iteration.
+ *
+ * @warning (IMPORTANT!) the internal resetter must be added to the
+ * IterMachine.pre and the internal writer to the IterMachine.post
+ */
+  class WriteSpatialCorrelationByDistance: public IterTransition
+  {
+  private:
+    /** wrapper object for communication with other methods parts */
+    SpatialEvaluator& owner;
+    /** output file */
+    ostream *f;
+    /** dirty solution, due to the sub-optimal design: we need the
+     * scan values, which can not be accessed from the 'IterData'
+     */
+    ScanData& scanData;
+
+    int numberOfCells;
+    int cellDim;
+
+    /** distances 0, 1, ..., N/2 are considered (circular lattice) */
+    int maxDistance;
+
+    /** accumulated auto-covariance for each component and distance */
+    Array<Array<real_t> > sumCov;
+
+    /** number of accumulated snapshots */
+    long numberOfSnapshots;
+
+#if ANT_HAS_LIBFFTW
+    fftw_complex* fftwArray;
+    fftw_complex* fftwSpectrum;
+    fftw_plan forwardPlan;
+    fftw_plan backwardPlan;
+#else
+    Array<real_t> deviations;
+#endif
+
+    /**
+     * add the circular auto-covariance of the given component of the
+     * current snapshot to 'sumCov'
+     */
+    void addSnapshot (const Array<real_t>& state, int component);
+
+  public:
+    class Resetter : public IterTransition
+    {
+    private:
+      WriteSpatialCorrelationByDistance& owner;
+    public:
+      Resetter (WriteSpatialCorrelationByDistance& anOwner);
+
+      virtual void execute (IterData& iterData);
+    };
+
+    class Writer : public IterTransition
+    {
+    private:
+      WriteSpatialCorrelationByDistance& owner;
+    public:
+      Writer (WriteSpatialCorrelationByDistance& anOwner);
+
+      virtual void execute (IterData& iterData);
+    };
+
+    /** must be added into the IterMachine.pre */
+    Resetter resetter;
+
+    /** must be added into the IterMachine.post */
+    Writer writer;
+
+    WriteSpatialCorrelationByDistance (SpatialEvaluator & aOwner,
+				       const string& fileName,
+				       ScanData& aScanData,
+				       int aNumberOfCells,
+				       int aCellDim);
+
+    virtual ~WriteSpatialCorrelationByDistance ();
+
+    virtual void execute (IterData& iterData);
+  };
+
+
   /**
    * saving of the spatial wave numbers: number of spatial min points
    * at each time. The min points are determined if the deviation
@@ -467,8 +576,15 @@ public:
   ConditionalTransition* writeSpatialMeanValueConditionalTransition;
   ConditionalTransition* writeSpatialStdDevConditionalTransition;
   ConditionalTransition* writeSpatialAverageCorrelationConditionalTransition;
+  ConditionalTransition* writeSpatialCorrelationByDistanceConditionalTransition;
   ConditionalTransition* writeSpatialWaveNumbersConditionalTransition;
 
+  /** 
+   * the internal transition of the conditional wrapper above. It is
+   * needed for its internal resetter and writer.
+   */
+  WriteSpatialCorrelationByDistance* writeSpatialCorrelationByDistance;
+
   /** list of conditional wrappers */
   list<ConditionalTransition*> writeNumberOfCellsTransitionList;
 
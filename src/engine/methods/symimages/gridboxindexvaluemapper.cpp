@@ -347,15 +347,8 @@ void GridBoxIndexValueMapper::getErrorToleranceIndices(NDimensionIndex & index,
       maxIndex.nDimensionIndex[i] = index.nDimensionIndex[i] + error.maxError[i];
       startIndex->nDimensionIndex[i] = index.nDimensionIndex[i] - error.minError[i];
 
-      // and update the totalError, another parameter
-     if(error.maxError[i] > totalMaxError->maxError[i]){
-       totalMaxError->maxError[i] = error.maxError[i];
-     }
-
-     if(error.minError[i] > totalMaxError->minError[i]){
-       totalMaxError->minError[i] = error.minError[i];
-     }
-     
+      // the totalError is not updated here, since this function is called
+      // concurrently by the box mapping threads and the value is never read.
     }
 
     // test, if there is something wrong
@@ -645,6 +645,17 @@ void GridBoxScanPointCalculator::setBoxSize(SymbolicImageAbstractBoxSizeDefiniti
 
 }
 
+bool GridBoxScanPointCalculator::hasRandomScanPoints(){
+
+  for(int i=0;i<m_pScanPoints.getTotalSize();i++){
+    for(int j=0;j<m_pScanPoints[i].randomRange.getTotalSize();j++){
+      if(m_pScanPoints[i].randomRange[j] > 0.) return true;
+    }
+  }
+
+  return false;
+}
+
 inline void GridBoxScanPointCalculator::getScanPoint(Array<real_t> &gridBoxPoint, int scanPointIndex, Array<real_t> &scanPoint){
 
   // get either the scan point for the grix box or a random value of the scan range
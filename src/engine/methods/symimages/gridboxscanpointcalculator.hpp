@@ -122,6 +122,9 @@ public:
    */
   void setBoxSize(SymbolicImageAbstractBoxSizeDefinition &boxSize);
 
+  /** True, if a random range is given for a scan point. */
+  bool hasRandomScanPoints();
+
 protected: 
 
   /**
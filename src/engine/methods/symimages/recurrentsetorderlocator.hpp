@@ -28,13 +28,10 @@
 #define RECURRENTSETORDERLOCATOR_HPP
 
 #include "symbolicimagedefaultcell.hpp"
+#include "symbolicimagecellgraph.hpp"
 #include "../../utils/progress/progresscounter.hpp"
 //#include "../utils/arrays/Array.hpp"
 #include <queue>
-#include <stack>
-
-//using std::queue;
-using std::stack;
 
 /**
   This class handles all further processing of the Symbolic Image and its recurrent sets (set of
@@ -46,10 +43,17 @@ using std::stack;
   sets are connected with each other?). If a set A is larger than B then there is a path from
   B to A..
 
+  The initialisation builds a directed acyclic graph (dag) in which every recurrent cell set
+  is represented by one dag cell and every other cell by a dag cell of its own. Dag cell i < number of
+  sets represents the set with number i, the remaining dag cells follow in the order of the
+  original cells. The dag is stored as SymbolicImageCellGraph with parent edges, all passes
+  (domains of attraction, set ordering, connecting cells) are breadth-first or iterative
+  depth-first searches over its integer arrays.
+
   The cell list passed to this object must have been preprocessed so that the corresponding recurrent cell
   sets have been created.
 
-  \sa SymbolicImageRecurrentCellSet, StronglyConnectedComponentsFinder
+  \sa SymbolicImageRecurrentCellSet, StronglyConnectedComponentsFinder and SymbolicImageCellGraph
   
   *@author Danny Fundinger
   */
@@ -58,103 +62,6 @@ class RecurrentSetOrderLocator {
 
 public:
 
-//  enum SetOrderType { UNSEEN, HAS_NO_SET, HAS_SET};
-//  enum MarkedCellConnector { NOT_VISITED, IN_PROGRESS, NO_CONNECTOR, CONNECTOR};
-//  enum SetBoundary { IN_BOUNDARY, OUTSIDE_BOUNDARY, TARGET_CELL };
-
-  /**
-    Extended SymbolicImageDefaultCell to handle specific calculations. The initialisation
-    phase of the RecurrentSetOrderLocator creates a new directed acyclic graph (dag) so
-    that there is for all sets of strongly connected components  only one SymbolicImageDagCell.
-
-    These cells also have edges to their parent cells.
-
-    Again, the cells need a proper enumeration according to their position in a list.
-  
-  *@author Danny Fundinger
-  */
-  
-
-  class SymbolicImageDagCell : public SymbolicImageDefaultCell  {
-
-  public:
-
-      /**
-        Constructor. Needs a proper cellNumber and the SymbolicImageDefaultCell
-        object if it is not representing a set of strongly connected components.
-
-          @param cellNumber the number of the cell in a vector or list
-          @param originalCell corresponding cell if it exists.
-     */
-      SymbolicImageDagCell(int cellNumber, SymbolicImageDefaultCell* originalCell = NULL);
-
-      /** Destructor. */
-      ~SymbolicImageDagCell();
-
-      /**
-        Adds a new edge to this cell. Also calls addNewParent of targetCell and
-        adds targetCell to largerSet of its recurrent cell set if target cell
-        has also a set.
-
-        \sa addNewParent and  SymbolicImageRecurrentCellSet::addLargerSet
-
-          @return true, if edge does not yet exist and has been added
-      */
-      bool addNewEdge(SymbolicImageDagCell* targetCell);
-
-      /**
-        Removes the edge to targetCell if it does exist. Also
-        deletes the edge in the target cell to this cell by calling
-        removeParent
-      
-      */
-      void removeEdge(SymbolicImageDagCell* targetCell);
-
-      /**
-        Removes the edge to the parent cell.
-
-      */
-      void removeParent(SymbolicImageDagCell* parentCell);
-
-      /**
-        Enumerator object with the list of parent elements.
-        Enumerator will be created and not further handled.
-      */
-      CellEnumerator* getParentList();
-
-      /**
-        Returns true if this dag cell has an edge.
-      */
-      bool hasExit();
-
-      /**
-          Returns the SymbolicImageDefaultCell which is connected
-          with this dag cell, if it exists. If this dag cell represents
-          a set of strongly connected components, it returns NULL.
-
-          @return cell belonging to this dag cell or NULL
-      */
-      SymbolicImageDefaultCell* getOriginalCell();
-
-  protected:
-
-        /**
-          Adds  a new parent object to this cell.
-        */
-        void addNewParent(SymbolicImageDagCell* parentCell);
-  
-  private:
-  
-      /** The parent cell list */
-      SymbolicImageDefaultCellMap m_parentCells;
-
-      /** The SymbolicImageDefaultCell which belongs to this cell */
-      SymbolicImageDefaultCell* m_pOriginalCell;
-
-  };
-
-  typedef vector<SymbolicImageDagCell*> SymbolicImageDagCellVector;
-
   /** Constructor */
   RecurrentSetOrderLocator();
 
@@ -171,13 +78,9 @@ public:
    void init(SymbolicImageDefaultCell::CellEnumerator* cellList,SymbolicImageRecurrentCellSet::RecurrentCellSetEnumerator* recurrentSetList);
 
   /**
-    Location of the set order by deleting all dag cells not belonging to a
-    nonrecurrent cell set. Furthermore, to every cell set object the larger sets
+    Location of the set order. To every cell set object the larger sets
     are added.
 
-    Important!! This method changes the dag cell graph and deletes cells. Do only call
-    as the last operation. Also call only once!!
-
      \sa SymbolicImageRecurrentCellSet and SymbolicImageRecurrentCellSet::addLargerSet
   */ 
   void locateSetOrder();
@@ -229,35 +132,12 @@ public:
 
 protected:
 
-    /**
-      Data for stack simulation to avoid recursion in function locatePeriodic.
-    */
-    struct FunctionData{
-
-       SymbolicImageDefaultCell* cell;
-       FunctionData* returnFunction;
-
-       bool retValSet;
-       bool hasSet;
-
-       SymbolicImageDefaultCell::CellEnumerator* edgeList;
-  };
-
-  /** The simulated stack */
-  stack< FunctionData* > m_pFunctionStack;
-  
   /**
-    Creates the function data for a cell and puts it into the stack.
+    Iterative depth-first search from a dag cell, which sets the state type
+    (TEND_TO_INF or ORIGIN_IN_INF) for every cell from which a cell without exit
+    (respectively without entrance) can be reached. Called by locateInfSets.
   */
-  void createFunctionForCell(SymbolicImageDagCell* cell, FunctionData* returnFunction, int type);
-
-   /**
-     Works down all recursive functions in the function stack, adds new function objects
-     and finally empties the whole stack.
-   */
-  void processFunctionStack(int type);
-
-  
+  void searchInfFrom(int startCell, int type);
 
   /**
     Called by connecteMarkedSets() to find the uper bound connections between the sets.
@@ -265,21 +145,22 @@ protected:
     \sa connectMarkedSets()
   */
   void findConnectingCells(int markedSourceSet);
+
   /**
-    Finds the domain of attraction to a (marked) cell. Called by
+    Finds the domain of attraction to a (marked) set. Called by
     the markSets...-methods.
 
     \sa findInverseDomainOfAttraction, markSets and markSetsInRange
   */
-  void findDomainOfAttraction(SymbolicImageDagCell* cell);
+  void findDomainOfAttraction(int setNumber);
 
   /**
-    Finds the inverse domain of attraction to a (marked) cell. Called by
+    Finds the inverse domain of attraction to a (marked) set. Called by
     the markSets...-methods.
 
     \sa findDomainOfAttraction, markSets and markSetsInRange
   */
-  void findInverseDomainOfAttraction(SymbolicImageDagCell* cell);
+  void findInverseDomainOfAttraction(int setNumber);
   
   /**
     Finds the lower bound for the currently focused marked set.
@@ -291,12 +172,7 @@ protected:
   /**
     Called by findLowerBound to make all selected parent cells of a cell unselected.
   */
-  void unsetCellParents(SymbolicImageDagCell* cell);
-
-  /**
-   Recursive method to locate the exit sets. Currently not in use.
-  */
-  bool visitCell(SymbolicImageDagCell* cell);
+  void unsetCellParents(int cellNumber);
 
   /**
     Mark all cells currently selected somehow. Called at the end of an marking method.
@@ -306,27 +182,25 @@ protected:
   void markCurrentBoundaryCells();
 
   /**
-    Add to the recurrent cell set of cell all recurrent cell sets which are larger.
+    Add to the recurrent cell set all recurrent cell sets which are larger.
 
     \sa locateSetOrder
   */
-  void addAllLargerSets(SymbolicImageDagCell* cell);
+  void addAllLargerSets(int setNumber);
 
-  //void markDirectChildrenAs(SymbolicImageDagCell* cell);
-  
 private:
 
-  /**
-    The dag cells of the Symbolic Image  which
-    represent a non recurrent cell set.
-  */
-  Array< SymbolicImageDagCell* > m_cellsForSets;
+  /** The dag of the Symbolic Image */
+  SymbolicImageCellGraph m_dagGraph;
+
+  /** The recurrent cell set for every dag cell representing a set */
+  Array< SymbolicImageRecurrentCellSet* > m_recurrentSets;
 
   /**
-    The dag cells of the Symbolic Image representing single cells,
-    no recurrent cell sets.
+    The original cell for every dag cell which represents a single cell,
+    NULL for dag cells representing a set.
   */
-  SymbolicImageDagCellVector m_dagCellVector;
+  Array< SymbolicImageDefaultCell* > m_originalCells;
 
   /** The number of sets */
   int m_iNumberOfSets;
@@ -334,9 +208,6 @@ private:
   /** The number of cells */
   int m_iNumberOfCells;
 
-  //Array< Array<bool> > m_bMarkedRecurrentCellSets;
-  //Array< bool > m_bCurrentMarkedRecurrentCellSet;
-
    /**
     The boolean state variables for the operations. For the sake
     of efficient memory  usage all of them are saved in one integer variable
@@ -350,11 +221,11 @@ private:
   */
   Array< int > m_iMarkedRecurrentCellSets;
 
-  // Former state variables
-  //Array< bool > m_bDomainOfSetMarked;
-  //Array< SetOrderType > m_unseenCells;
-  //Array< MarkedCellConnector > m_markedCellConnector;
-  //Array< SetBoundary > m_currentBoundary;
+  /** Queue for the breadth-first searches */
+  std::queue< int > m_cellQueue;
+
+  /** Visit marks for the breadth-first searches */
+  Array< bool > m_bUnvisitedCells;
 };
 
 #endif
@@ -30,7 +30,6 @@ StronglyConnectedComponentsFinder::StronglyConnectedComponentsFinder(SymbolicIma
                                         SymbolicImageRecurrentCellSetCreator & cellSetCreator, bool markRecurrent){
 
   // set everything to 0
-  m_pCellList = NULL;
   m_iNumberOfCells = 0;
   m_iID=0;
   m_iNumberOfPeriodicCells=0;
@@ -42,42 +41,34 @@ StronglyConnectedComponentsFinder::StronglyConnectedComponentsFinder(SymbolicIma
 }
 
 StronglyConnectedComponentsFinder::~StronglyConnectedComponentsFinder(){
-
-  if(m_pCellList) delete m_pCellList;
-  m_pCellList = NULL;
 }
 
 
 void StronglyConnectedComponentsFinder::init(SymbolicImageDefaultCell::CellEnumerator* cellList){
 
+  // build the cell graph in one go, the enumerator is not needed afterwards
+  m_cellGraph.init(cellList);
+  delete cellList;
+
   // initialise everything
-  if(m_pCellList) delete m_pCellList;
-  m_pCellList=cellList;
-  m_iNumberOfCells = m_pCellList->size();
-  m_bUnseenCells.alloc(m_iNumberOfCells,true);
-  m_iVisitedAt.alloc(m_iNumberOfCells);
-
-  m_iStackMaxSize = 0;
-  m_iStackCurrentSize = 0;
-  m_iStackAverageSize = 0;
-  m_iStackLoad = 0;
-
-  
+  m_iNumberOfCells = m_cellGraph.getNumberOfCells();
+  m_iVisitedAt.assign(m_iNumberOfCells,0);
+  m_iTotalMin.assign(m_iNumberOfCells,0);
+  m_iNextEdge.assign(m_iNumberOfCells,0);
+
+  m_cellStack.clear();
+  m_searchStack.clear();
+  m_cellStack.reserve(m_iNumberOfCells);
+  m_searchStack.reserve(m_iNumberOfCells);
 }
 
 void StronglyConnectedComponentsFinder::locatePeriodic(){
 
-    // go through all cells and check if they are not yet visited
-   // if not create a function object without return function and process function stack
-
-   while( m_pCellList->hasMoreElements() ){
-
-    //int depth =0;
-    SymbolicImageDefaultCell* cell = m_pCellList->getNextElement();
-    if(m_bUnseenCells[cell->getCellNumber()]){
-      //visitCell(cell, depth);
-      createFunctionForCell(cell,NULL);
-      processFunctionStack();
+   // go through all cells and start a depth-first search
+   // for every cell which is not yet visited
+   for(int i=0; i < m_iNumberOfCells; i++){
+    if(m_iVisitedAt[i] == 0){
+      searchFrom(i);
     }
    }
 
@@ -95,172 +86,119 @@ int StronglyConnectedComponentsFinder::getNumberOfPeriodicCells(){
   return m_iNumberOfPeriodicCells;
 }
 
-void StronglyConnectedComponentsFinder::createFunctionForCell(SymbolicImageDefaultCell* cell, FunctionData* returnFunction){
-
-  int cellNumber = cell->getCellNumber();
+inline void StronglyConnectedComponentsFinder::visitCell(int cellNumber){
 
   // cell is visited now and gets an ID
-  m_bUnseenCells[cellNumber] = false;
-  
   m_iID++;
   m_iVisitedAt[cellNumber] = m_iID;
-  
-  // create the function object and set its data
-  FunctionData* func = new FunctionData;
-  func->cell = cell;
-  func->returnFunction = returnFunction;
-  func->retValSet = true;
-  func->totalMin = m_iID;
-  func->edgeList = cell->getEdgeList();
+  m_iTotalMin[cellNumber] = m_iID;
+  m_iNextEdge[cellNumber] = m_cellGraph.getEdgesBegin(cellNumber);
 
-  // push cell on stack
-  m_cellStack.push(cell);
-  m_iStackCurrentSize++;
+  // push cell on both stacks
+  m_cellStack.push_back(cellNumber);
+  m_searchStack.push_back(cellNumber);
 
-  if(m_bMarkRecurrent) cell->setRecurrent(false);
+  if(m_bMarkRecurrent) m_cellGraph.getCell(cellNumber)->setRecurrent(false);
+}
 
- // ... and on the function stack
-  m_pFunctionStack.push(func);
+void StronglyConnectedComponentsFinder::searchFrom(int startCell){
 
-}
+  visitCell(startCell);
 
-void StronglyConnectedComponentsFinder::processFunctionStack(){
-
-  // process function stack until it is empty
-  FunctionData* func;
-  while(!m_pFunctionStack.empty()){
-    
-     func = m_pFunctionStack.top();
-     int cellNumber = func->cell->getCellNumber();
-
-     // if the edge list of the current function
-     // contains an unseen cell then interrupt this
-     // function, create a new function object and push
-     // it on the stack -> simulated recursion
-     bool interruptFunc = false;
-     while( (!interruptFunc) && (func->edgeList->hasMoreElements()) ){
-
-       SymbolicImageDefaultCell* edge = (func->edgeList->getNextElement());
-       if(!edge){
-          cout << "Null edge" << endl << Error::Exit;
-        }
+  // process the search stack until it is empty
+  while(!m_searchStack.empty()){
+
+     int cellNumber = m_searchStack.back();
+     int edgesEnd = m_cellGraph.getEdgesEnd(cellNumber);
+
+     // if the edge list of the current cell
+     // contains an unseen cell then interrupt the current
+     // cell and descend -> simulated recursion
+     bool interrupted = false;
+     while( (!interrupted) && (m_iNextEdge[cellNumber] < edgesEnd) ){
 
-        int edgeNumber = edge->getCellNumber();
+        int edgeNumber = m_cellGraph.getEdgeTarget(m_iNextEdge[cellNumber]);
+        m_iNextEdge[cellNumber]++;
 
         // get minimum ID of all unseen and seen cells
-        if(m_bUnseenCells[edgeNumber]){
-          interruptFunc = true;
-          func->retValSet = false;
-          createFunctionForCell(edge,func );
+        if(m_iVisitedAt[edgeNumber] == 0){
+          interrupted = true;
+          visitCell(edgeNumber);
         }
         else{
           int min = m_iVisitedAt[edgeNumber];
-          if((min >= 0) && (min < func->totalMin)) func->totalMin=min;
+          if((min >= 0) && (min < m_iTotalMin[cellNumber])) m_iTotalMin[cellNumber]=min;
         }
      }
 
-     // function was not interrupted, so now we are "after" the recursion part
-     if(!interruptFunc){
-       
-       if(!func->retValSet)
-        cout << "Function stack error in StronglyConnectedComponentsFinder algorithm." << endl
-        << Error::Exit;
-        
-       // if current cell is minimum ID it is head of invariant set, so lets read out the stack
-      if(func->totalMin == m_iVisitedAt[cellNumber]){
-        processNextInvariantSet( (*func) );
+     // all edges are processed, so now we are "after" the recursion part
+     if(!interrupted){
+
+      int totalMin = m_iTotalMin[cellNumber];
+
+      // if current cell is minimum ID it is head of invariant set, so lets read out the stack
+      if(totalMin == m_iVisitedAt[cellNumber]){
+        processNextInvariantSet(cellNumber);
       }
 
       // simulate return
-      if(func->returnFunction){
+      m_searchStack.pop_back();
 
-        if((func->totalMin >= 0) && (func->totalMin < func->returnFunction->totalMin))
-          func->returnFunction->totalMin=func->totalMin;
+      if(!m_searchStack.empty()){
 
-        func->returnFunction->retValSet = true;
+        int parentNumber = m_searchStack.back();
+        if((totalMin >= 0) && (totalMin < m_iTotalMin[parentNumber]))
+          m_iTotalMin[parentNumber]=totalMin;
       }
-
-      m_pFunctionStack.pop();
-      
-      // delete everything after usage
-      delete func->edgeList;
-      delete func;
-    }  
+    }
   }
 }
 
-inline void StronglyConnectedComponentsFinder::processNextInvariantSet(FunctionData & func){
+inline void StronglyConnectedComponentsFinder::processNextInvariantSet(int rootCell){
 
-  SymbolicImageDefaultCell* vCell = NULL;
+  SymbolicImageDefaultCell* root = m_cellGraph.getCell(rootCell);
 
-  // create new SymbolicImageRecurrentCellSet object although it is not clear
-  // if it is really needed
-  
-  SymbolicImageRecurrentCellSet* newRecurrentSet = createNewCellSetObject();
-  
-  bool isFirst=true;
-  bool isPeriodic = false;
+  // a single cell without an edge to itself is no invariant set
+  if( (m_cellStack.back() == rootCell) && (!root->isSelfConnecting()) ){
 
-  if(m_iStackMaxSize < m_iStackCurrentSize){
-    m_iStackMaxSize = m_iStackCurrentSize;
+    m_cellStack.pop_back();
+    m_iVisitedAt[rootCell] = -1;
+    return;
   }
 
-  long_t newAvSize = m_iStackAverageSize * m_iStackLoad + m_iStackCurrentSize;
-  m_iStackLoad++;
-  m_iStackAverageSize = newAvSize / (long_t) m_iStackLoad;
-
-  int popSize = 0;
-  //cout << m_iStackMaxSize << " " << m_iStackCurrentSize << " " << m_iStackAverageSize << " " << m_iStackLoad << " ";
+  SymbolicImageRecurrentCellSet* newRecurrentSet = createNewCellSetObject();
 
   // read out the cell stack - every cell in it is part of the invariant set
   // and set the SymbolicImageRecurrentCellSet object
+  int vCellNumber;
   do{
 
-    vCell = m_cellStack.top();
-    m_cellStack.pop();
-    m_iStackCurrentSize--;
-    popSize++;
+    vCellNumber = m_cellStack.back();
+    m_cellStack.pop_back();
 
     // set visitedAt to -1 -> cell is excluded to avoid cross edges
-    m_iVisitedAt[vCell->getCellNumber()] = -1;
+    m_iVisitedAt[vCellNumber] = -1;
 
-    if( isFirst && (vCell == func.cell) && (!func.cell->isSelfConnecting()) ){
-        // ignore, that means invariant set has only one element and
-       // cell is none-periodic
-    }
-    else{
+    SymbolicImageDefaultCell* vCell = m_cellGraph.getCell(vCellNumber);
 
-      // otherwise let's build the invariant set
-
-      if(vCell->getRecurrentSet()){
-        delete newRecurrentSet;
-        cerr << "Error. Recurrent set is already set for a cell while running StronglyConnectedComponents algorithm."
-        << endl << Error::Exit;
-      }
+    if(vCell->getRecurrentSet()){
+      delete newRecurrentSet;
+      cerr << "Error. Recurrent set is already set for a cell while running StronglyConnectedComponents algorithm."
+      << endl << Error::Exit;
+    }
 
-      // no matter if the cell was 1-periodic or not - now it is
-      // part of a larger invariant set
-      vCell->setRecurrentSet(newRecurrentSet);
-      newRecurrentSet->addNewCell(vCell->getBox());
-        
-      isPeriodic = true;
-      m_iNumberOfPeriodicCells++;
-      if(m_bMarkRecurrent) vCell->setRecurrent(true);
-      
-     }
+    // no matter if the cell was 1-periodic or not - now it is
+    // part of a larger invariant set
+    vCell->setRecurrentSet(newRecurrentSet);
+    newRecurrentSet->addNewCell(vCell->getBox());
 
-     isFirst = false;
-  }while(func.cell != vCell);
+    m_iNumberOfPeriodicCells++;
+    if(m_bMarkRecurrent) vCell->setRecurrent(true);
 
-  //if the cell was periodic we need a new invariant set
-  // otherwise it can be deleted
-  if(isPeriodic){
-    m_iInvariantSet++;
-    m_pSetVector->push_back(newRecurrentSet);
-  }
-  else delete newRecurrentSet;
+  }while(vCellNumber != rootCell);
 
-  //cout << popSize << endl;
+  m_iInvariantSet++;
+  m_pSetVector->push_back(newRecurrentSet);
 }
 
 SymbolicImageRecurrentCellSet* StronglyConnectedComponentsFinder::createNewCellSetObject(){
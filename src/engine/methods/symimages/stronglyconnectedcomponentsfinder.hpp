@@ -31,8 +31,7 @@
 #include "../utils/arrays/Array.hpp"
 #include "symbolicimageperiodfinder.hpp"
 #include "symbolicimagerecurrentcellset.hpp"
-#include <stack>
-using std::stack;
+#include "symbolicimagecellgraph.hpp"
 
 /**
 
@@ -41,14 +40,16 @@ using std::stack;
   strongly connected component a SymbolicImageRecurrentCellSet object will be created
   and connected with the sets.
 
-  This algorithm avoids  recursion by simulating the function stack.
+  The cells are first copied into a SymbolicImageCellGraph (compressed sparse row form),
+  the search itself is an iterative version of the algorithm on these integer arrays which
+  keeps an explicit depth-first stack of cell numbers instead of recursing.
 
   All cells need a proper enumeration according to their position in the vector (0..n-1).
 
   Performance: O(e) e = number of edges
 
-  \sa SymbolicImageAbstractCell, SymbolicImageRecurrentCellSet, SymbolicImageDefaultCell
-  and GreedyPeriodicCellFinder
+  \sa SymbolicImageAbstractCell, SymbolicImageRecurrentCellSet, SymbolicImageDefaultCell,
+  SymbolicImageCellGraph and GreedyPeriodicCellFinder
 
   *@author Danny Fundinger
   */
@@ -71,11 +72,11 @@ public:
     ~StronglyConnectedComponentsFinder();
 
    /**
-    Initializes the CellFinder with the given cell list.
+    Initializes the CellFinder with the given cell list and builds the cell graph.
 
     \sa SymbolicImageDefaultCell
     @param cellList Enumerator containing cells of type SymbolicImageDefaultCell. This enumerator
-    will be deleted when CellFinder will be destroyed
+    will be deleted after the cell graph has been built.
    */
   void init(SymbolicImageDefaultCell::CellEnumerator* cellList);
 
@@ -94,43 +95,21 @@ public:
  
 protected:
 
-  /** FunctionData object definition for simulation of a function stack */
-  struct FunctionData{
-    
-       SymbolicImageDefaultCell* cell;
-       FunctionData* returnFunction;
-
-       bool retValSet;
-       // The value usually acquired by recursion
-       int totalMin;
-
-       SymbolicImageDefaultCell::CellEnumerator* edgeList;
-  };
-
-  // The function stack simulator
-  stack< FunctionData* > m_pFunctionStack;
-
   /**
-      Function of Tarjan algorithm for visiting a cell.
+    Visits a cell for the first time: assigns its ID and pushes it
+    on the depth-first stack and the component stack.
   */
-  //int visitCell(SymbolicImageDefaultCell* cell, int depth);
+  void visitCell(int cellNumber);
 
   /**
-    Creates a new function object for a cell.
-
-    @returnFunction the function in which this function was recursively called.
-  */
-  void createFunctionForCell(SymbolicImageDefaultCell* cell, FunctionData* returnFunction);
-
-   /**
-    Process the current function stack.
+    Depth-first search starting at an unseen cell.
   */
-  void processFunctionStack();
+  void searchFrom(int startCell);
 
   /**
-    For the function a new invariant set was detected and will be processed.
+    For the root cell a new invariant set was detected and will be processed.
   */
-  void processNextInvariantSet(FunctionData & function);
+  void processNextInvariantSet(int rootCell);
 
    /** Creates a new recurrent cell set object */
   virtual SymbolicImageRecurrentCellSet* createNewCellSetObject();
@@ -145,8 +124,8 @@ protected:
    
 private:
 
-   /** The cell list */
-  SymbolicImageDefaultCell::CellEnumerator* m_pCellList;
+  /** The cell graph */
+  SymbolicImageCellGraph m_cellGraph;
 
   /** The recurrent set vector */
   SymbolicImageRecurrentCellSet::RecurrentCellSetVector* m_pSetVector;
@@ -157,27 +136,29 @@ private:
   /** The number of periodic cells */
   int m_iNumberOfPeriodicCells;
 
-  /** Stack containing the cells of the tree */
-  stack< SymbolicImageDefaultCell* > m_cellStack;
+  /** Stack containing the cells of the tree (not yet assigned to a component) */
+  vector< int > m_cellStack;
 
-  /** Still unseen cells */
-  Array< bool > m_bUnseenCells;
+  /** The simulated call stack of the depth-first search */
+  vector< int > m_searchStack;
 
-  /** ID of order when visited */
-  Array< int > m_iVisitedAt;
+  /**
+    ID of order when visited: 0 for unseen cells, -1 for cells
+    already assigned to a component
+  */
+  vector< int > m_iVisitedAt;
+
+  /** Minimum ID reachable from a cell (low link) */
+  vector< int > m_iTotalMin;
+
+  /** Next edge to be processed for every cell on the search stack */
+  vector< int > m_iNextEdge;
 
   /** current ID */
   int m_iID;
 
   /** Parameter defining if recurrent cells get marked */                         
   bool m_bMarkRecurrent;
-
-  int m_iStackMaxSize;
-  int m_iStackCurrentSize;
-  long_t m_iStackAverageSize;
-  int m_iStackLoad;
-
-
 };
 
 
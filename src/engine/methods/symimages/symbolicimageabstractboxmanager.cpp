@@ -241,6 +241,16 @@ void SymbolicImageAbstractBoxManager::setCurrentIterData(IterData &iterData){
   m_pIterData = &iterData;
 }
 
+void SymbolicImageAbstractBoxManager::getBoxMappings(SymbolicImageAbstractBoxVector &boxes,
+                                                     vector<SymbolicImageAbstractBoxVector> &targetBoxes){
+
+  targetBoxes.resize(boxes.size());
+
+  for(unsigned int i=0; i<boxes.size(); i++){
+    getBoxMapping(boxes[i], targetBoxes[i]);
+  }
+}
+
 SymbolicImageAbstractLinearExtendedBoxManager::SymbolicImageAbstractLinearExtendedBoxManager(){}
 
 SymbolicImageAbstractLinearExtendedBoxManager::~SymbolicImageAbstractLinearExtendedBoxManager(){}
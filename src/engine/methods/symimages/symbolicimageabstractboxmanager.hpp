@@ -105,6 +105,19 @@ public:
   virtual void getBoxMapping(SymbolicImageAbstractBox* box,
                             SymbolicImageAbstractBoxVector &targetBoxes) = 0;
 
+  /**
+      Get the mappings of several boxes. The target boxes of boxes[i] are
+      appended to targetBoxes[i], hence the result does not depend on the
+      order in which the boxes are mapped. The default implementation calls
+      getBoxMapping for each box, a derived box manager may map the boxes
+      concurrently.
+
+      @param boxes the boxes to map
+      @param targetBoxes vectors of target boxes, one for each box
+  */
+  virtual void getBoxMappings(SymbolicImageAbstractBoxVector &boxes,
+                            vector<SymbolicImageAbstractBoxVector> &targetBoxes);
+
   virtual bool loadBoxCovering(string & filename, int startRow, int startLine, SymbolicImageAbstractBoxVector & targetBoxes, real_t errorTolerance) = 0;
 
 
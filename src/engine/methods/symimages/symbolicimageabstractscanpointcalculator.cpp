@@ -31,3 +31,7 @@ SymbolicImageAbstractScanPointCalculator::SymbolicImageAbstractScanPointCalculat
 }
 SymbolicImageAbstractScanPointCalculator::~SymbolicImageAbstractScanPointCalculator(){
 }
+
+bool SymbolicImageAbstractScanPointCalculator::hasRandomScanPoints(){
+  return false;
+}
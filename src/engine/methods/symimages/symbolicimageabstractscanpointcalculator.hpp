@@ -80,6 +80,13 @@ public:
   */
   virtual void setBoxSize(SymbolicImageAbstractBoxSizeDefinition &boxSize) = 0;
 
+  /**
+    True, if the scan points are drawn at random. The boxes must then be
+    mapped serially, since the random numbers are not drawn thread-safe
+    and the graph must not depend on the order of the mappings.
+  */
+  virtual bool hasRandomScanPoints();
+
 
 
 };
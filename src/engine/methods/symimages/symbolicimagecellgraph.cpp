@@ -0,0 +1,146 @@
+/* 
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ * 
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ * 
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#include "symbolicimagecellgraph.hpp"
+#include <algorithm>
+
+SymbolicImageCellGraph::SymbolicImageCellGraph(){
+
+  m_iNumberOfCells = 0;
+}
+
+SymbolicImageCellGraph::~SymbolicImageCellGraph(){
+}
+
+void SymbolicImageCellGraph::clear(int numberOfCells){
+
+  m_iNumberOfCells = numberOfCells;
+
+  m_cells.clear();
+  m_iEdgeTargets.clear();
+  m_iParentOffsets.clear();
+  m_iParentSources.clear();
+
+  m_iEdgeOffsets.assign(numberOfCells + 1, 0);
+}
+
+void SymbolicImageCellGraph::init(SymbolicImageDefaultCell::CellEnumerator* cellList){
+
+  clear(cellList->size());
+  m_cells.reserve(m_iNumberOfCells);
+
+  // the targets of every cell are appended directly behind the targets
+  // of its predecessor, so one pass over the cells is sufficient
+  int cellNumber = 0;
+  while( cellList->hasMoreElements() ){
+
+    SymbolicImageDefaultCell* cell = cellList->getNextElement();
+
+    if(cell->getCellNumber() != cellNumber){
+      cerr << "Cells are not properly enumerated for the cell graph." << endl
+           << Error::Exit;
+    }
+
+    m_cells.push_back(cell);
+    cell->appendTargetCellNumbers(m_iEdgeTargets);
+
+    cellNumber++;
+    m_iEdgeOffsets[cellNumber] = (int) m_iEdgeTargets.size();
+  }
+}
+
+void SymbolicImageCellGraph::init(int numberOfCells, vector<int> & sources, vector<int> & targets){
+
+  clear(numberOfCells);
+
+  int numberOfEdges = (int) sources.size();
+
+  // count the edges of every cell, then sort them into place
+  for(int k=0; k < numberOfEdges; k++){
+    m_iEdgeOffsets[sources[k]+1]++;
+  }
+  for(int i=0; i < numberOfCells; i++){
+    m_iEdgeOffsets[i+1] += m_iEdgeOffsets[i];
+  }
+
+  vector< int > position(m_iEdgeOffsets.begin(), m_iEdgeOffsets.end() - 1);
+  m_iEdgeTargets.resize(numberOfEdges);
+
+  for(int k=0; k < numberOfEdges; k++){
+    m_iEdgeTargets[ position[sources[k]]++ ] = targets[k];
+  }
+
+  sources.clear();
+  targets.clear();
+
+  // sort the targets of every cell and remove duplicates, compacting
+  // the edge array in place
+  int newEnd = 0;
+  for(int i=0; i < numberOfCells; i++){
+
+    vector<int>::iterator begin = m_iEdgeTargets.begin() + m_iEdgeOffsets[i];
+    vector<int>::iterator end = m_iEdgeTargets.begin() + m_iEdgeOffsets[i+1];
+
+    std::sort(begin, end);
+    end = std::unique(begin, end);
+
+    // the destination never lies behind the source, hence a forward
+    // copy is safe unless both coincide (no copy needed then)
+    vector<int>::iterator dest = m_iEdgeTargets.begin() + newEnd;
+    m_iEdgeOffsets[i] = newEnd;
+    if(dest != begin){
+      std::copy(begin, end, dest);
+    }
+    newEnd += (int) (end - begin);
+  }
+  m_iEdgeOffsets[numberOfCells] = newEnd;
+  m_iEdgeTargets.resize(newEnd);
+}
+
+void SymbolicImageCellGraph::buildParentEdges(){
+
+  int numberOfEdges = getNumberOfEdges();
+
+  m_iParentOffsets.assign(m_iNumberOfCells + 1, 0);
+  m_iParentSources.resize(numberOfEdges);
+
+  for(int k=0; k < numberOfEdges; k++){
+    m_iParentOffsets[m_iEdgeTargets[k]+1]++;
+  }
+  for(int i=0; i < m_iNumberOfCells; i++){
+    m_iParentOffsets[i+1] += m_iParentOffsets[i];
+  }
+
+  // sources are visited in increasing order, so the parents
+  // of every cell are sorted as well
+  vector< int > position(m_iParentOffsets.begin(), m_iParentOffsets.end() - 1);
+
+  for(int i=0; i < m_iNumberOfCells; i++){
+    for(int e = m_iEdgeOffsets[i]; e < m_iEdgeOffsets[i+1]; e++){
+      m_iParentSources[ position[m_iEdgeTargets[e]]++ ] = i;
+    }
+  }
+}
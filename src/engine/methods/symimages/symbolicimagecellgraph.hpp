@@ -0,0 +1,170 @@
+/* 
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ * 
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ * 
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#ifndef SYMBOLICIMAGECELLGRAPH_HPP
+#define SYMBOLICIMAGECELLGRAPH_HPP
+
+#include "symbolicimagedefaultcell.hpp"
+#include <vector>
+
+using std::vector;
+
+/**
+  Compressed sparse row (CSR) representation of the transition graph of a
+  Symbolic Image. Cells are identified by their cell number (0..n-1), the
+  targets of cell i are stored contiguously in the edge array between
+  getEdgesBegin(i) and getEdgesEnd(i). Optionally, the transposed graph
+  (parent edges) is built in the same form.
+
+  The graph is built once in bulk after the mapping of the boxes and is
+  afterwards read-only. The graph algorithms (StronglyConnectedComponentsFinder,
+  RecurrentSetOrderLocator) traverse these integer arrays instead of the
+  edge maps of the single cell objects.
+
+  \sa SymbolicImageDefaultCell, StronglyConnectedComponentsFinder and
+  RecurrentSetOrderLocator
+  */
+
+class SymbolicImageCellGraph {
+
+public:
+
+  /** Constructor. */
+  SymbolicImageCellGraph();
+
+  /** Destructor. */
+  ~SymbolicImageCellGraph();
+
+  /**
+    Builds the graph from the edges of the cells. The cells must be enumerated
+    in the order of their cell numbers (0..n-1). The order of the targets
+    of a cell is the order of SymbolicImageDefaultCell::getEdgeList().
+    The enumerator is not deleted.
+
+    @param cellList the cells of the Symbolic Image
+  */
+  void init(SymbolicImageDefaultCell::CellEnumerator* cellList);
+
+  /**
+    Builds a graph with numberOfCells cells from a list of edges
+    sources[k] -> targets[k]. The targets of every cell are sorted and
+    duplicate edges are removed. Both vectors are cleared.
+
+    @param numberOfCells number of cells (nodes) of the graph
+    @param sources source cell of every edge
+    @param targets target cell of every edge
+  */
+  void init(int numberOfCells, vector<int> & sources, vector<int> & targets);
+
+  /**
+    Builds the transposed graph, so that the parent cells of
+    every cell can be traversed with getParentsBegin() and getParentsEnd().
+  */
+  void buildParentEdges();
+
+  /** The number of cells. */
+  inline int getNumberOfCells() const{
+    return m_iNumberOfCells;
+  }
+
+  /** The number of edges. */
+  inline int getNumberOfEdges() const{
+    return (int) m_iEdgeTargets.size();
+  }
+
+  /**
+    The cell object with the given number. Only available if the graph
+    was built from a cell list, otherwise NULL.
+  */
+  inline SymbolicImageDefaultCell* getCell(int cellNumber) const{
+    return m_cells.empty() ? NULL : m_cells[cellNumber];
+  }
+
+  /** Index of the first edge of a cell in the edge array. */
+  inline int getEdgesBegin(int cellNumber) const{
+    return m_iEdgeOffsets[cellNumber];
+  }
+
+  /** Index behind the last edge of a cell in the edge array. */
+  inline int getEdgesEnd(int cellNumber) const{
+    return m_iEdgeOffsets[cellNumber+1];
+  }
+
+  /** Target cell of an edge. */
+  inline int getEdgeTarget(int edge) const{
+    return m_iEdgeTargets[edge];
+  }
+
+  /** Index of the first parent edge of a cell. Needs buildParentEdges(). */
+  inline int getParentsBegin(int cellNumber) const{
+    return m_iParentOffsets[cellNumber];
+  }
+
+  /** Index behind the last parent edge of a cell. Needs buildParentEdges(). */
+  inline int getParentsEnd(int cellNumber) const{
+    return m_iParentOffsets[cellNumber+1];
+  }
+
+  /** Source cell of a parent edge. */
+  inline int getParentSource(int edge) const{
+    return m_iParentSources[edge];
+  }
+
+  /** True, if the cell has at least one outgoing edge. */
+  inline bool hasExit(int cellNumber) const{
+    return m_iEdgeOffsets[cellNumber+1] > m_iEdgeOffsets[cellNumber];
+  }
+
+  /** True, if the cell has at least one incoming edge. Needs buildParentEdges(). */
+  inline bool isTarget(int cellNumber) const{
+    return m_iParentOffsets[cellNumber+1] > m_iParentOffsets[cellNumber];
+  }
+
+private:
+
+  /** Resets the graph to an empty graph with the given number of cells. */
+  void clear(int numberOfCells);
+
+  /** The number of cells */
+  int m_iNumberOfCells;
+
+  /** The cell objects, if the graph was built from a cell list */
+  vector< SymbolicImageDefaultCell* > m_cells;
+
+  /** Start of the edges of every cell (n+1 entries) */
+  vector< int > m_iEdgeOffsets;
+
+  /** Target cells of all edges */
+  vector< int > m_iEdgeTargets;
+
+  /** Start of the parent edges of every cell (n+1 entries) */
+  vector< int > m_iParentOffsets;
+
+  /** Source cells of all parent edges */
+  vector< int > m_iParentSources;
+};
+
+#endif
@@ -241,6 +241,17 @@ SymbolicImageDefaultCell::CellEnumerator* SymbolicImageDefaultCell::getEdgeList(
   return new MapCellEnumerator(&m_targetCells);
 }
 
+void SymbolicImageDefaultCell::appendTargetCellNumbers(vector<int> & targetNumbers){
+
+  SymbolicImageDefaultCellMap::iterator it = m_targetCells.begin();
+  SymbolicImageDefaultCellMap::iterator end = m_targetCells.end();
+
+  while( it != end ){
+    targetNumbers.push_back( it->second->getCellNumber() );
+    it++;
+  }
+}
+
 void SymbolicImageDefaultCell::setPeriodSize(int size){
 
   // sets the period size and also peridiocity of cell
@@ -105,6 +105,15 @@ public:
    */
   CellEnumerator* getEdgeList();
 
+  /**
+      Appends the cell numbers of all target cells (edges) to targetNumbers,
+      in the same order as getEdgeList() would enumerate them. Used to build
+      the SymbolicImageCellGraph in bulk without an enumerator per cell.
+
+      \sa getEdgeList() and SymbolicImageCellGraph
+   */
+  void appendTargetCellNumbers(vector<int> & targetNumbers);
+
   /**
     True if the cell has an incoming edge.
    */
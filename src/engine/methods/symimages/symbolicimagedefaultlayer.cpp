@@ -1371,7 +1371,9 @@ void SymbolicImageDefaultLayer::buildEdges(){
   if(!m_pDefaultCellVector->empty()){
 
     // get the mapping for every cell and add the cells of the boxes, if not NULL,
-    // as new edges.
+    // as new edges. The boxes are mapped in blocks, so that the box manager
+    // can map the boxes of a block concurrently, while the edges are added
+    // in the order of the cells.
 
     //cout << "0%..." << endl;
 
@@ -1383,18 +1385,41 @@ void SymbolicImageDefaultLayer::buildEdges(){
     SymbolicImageDefaultCellVector::iterator it    = m_pDefaultCellVector->begin();
     SymbolicImageDefaultCellVector::iterator end = m_pDefaultCellVector->end();
 
+    const int blockSize = 1024;
+
+    SymbolicImageDefaultCellVector blockCells;
+    SymbolicImageAbstractBoxManager::SymbolicImageAbstractBoxVector blockBoxes;
+    vector<SymbolicImageAbstractBoxManager::SymbolicImageAbstractBoxVector> blockTargetBoxes;
+
     while( it != end ){
 
-      progressCounter.increase();
+      blockCells.clear();
+      blockBoxes.clear();
+      blockTargetBoxes.clear();
 
-      SymbolicImageDefaultCell* cell = (*it);
-      SymbolicImageAbstractBoxManager::SymbolicImageAbstractBoxVector targetBoxes;
+      while( (it != end) && (static_cast<int> (blockCells.size()) < blockSize) ){
+
+        SymbolicImageDefaultCell* cell = (*it);
+
+        if(!cell->isInfinityCell()){
+          blockCells.push_back(cell);
+          blockBoxes.push_back(cell->getBox());
+        }
+        else progressCounter.increase();
 
-      if(!cell->isInfinityCell()){
-        m_pAbstractBoxManager->getBoxMapping(cell->getBox(),targetBoxes);
+        it++;
+      }
+
+      m_pAbstractBoxManager->getBoxMappings(blockBoxes,blockTargetBoxes);
+
+      for(unsigned int i=0; i<blockCells.size(); i++){
+
+        progressCounter.increase();
+
+        SymbolicImageDefaultCell* cell = blockCells[i];
        
-        SymbolicImageAbstractBoxManager::SymbolicImageAbstractBoxVector::iterator tarit    = targetBoxes.begin();
-        SymbolicImageAbstractBoxManager::SymbolicImageAbstractBoxVector::iterator tarend = targetBoxes.end();
+        SymbolicImageAbstractBoxManager::SymbolicImageAbstractBoxVector::iterator tarit    = blockTargetBoxes[i].begin();
+        SymbolicImageAbstractBoxManager::SymbolicImageAbstractBoxVector::iterator tarend = blockTargetBoxes[i].end();
 
         while(tarit != tarend){
           SymbolicImageDefaultCell* newEdge = DOWN_CAST< SymbolicImageDefaultCell* > ((*tarit)->getCell());
@@ -1402,7 +1427,6 @@ void SymbolicImageDefaultLayer::buildEdges(){
           tarit++;
         }
       } 
-      it++;
     }
 
   }
@@ -336,6 +336,16 @@ bool SymbolicImageGridBoxManager::parse(Configuration& coverDescription, int sta
   if(! pars4.parseModificationPart(coverDescription, "CONNECT_ITER_BOXES_ARRAY", "connect_iter_boxes", m_bConnectIterBoxes )){
    return false;
   }
+
+  if(coverDescription.checkForKey("NUMBER_OF_THREADS_KEY")){
+    int iNumberOfThreads = coverDescription.getInteger("NUMBER_OF_THREADS_KEY");
+    if(iNumberOfThreads < 1){
+      cout << "Number of threads is smaller 1."
+      << endl;
+      return false;
+    }
+    setNumberOfThreads(iNumberOfThreads);
+  }
   // Parse uniform grid definitions
 
   Array<UniformGridAxis> uniformGridDefinition;
@@ -25,6 +25,127 @@
  */
  
 #include "symbolicimageindexboxmanager.hpp"
+#include "iterators/MapIterator.hpp"
+#include "proxies/MapProxy.hpp"
+#include <typeinfo>
+
+/**
+  Copy of the iteration data and of everything else a box mapping writes to,
+  one for each thread. The system function of a map is a static member of
+  MapProxy, so a default constructed proxy calls the same function as the
+  proxy of the simulator.
+*/
+class SymbolicImageIndexBoxManager::MappingWorker{
+
+public:
+
+  /**
+    The initial states of the map data of a mapping thread are never used,
+    since the orbit is always swapped with the private orbit of the thread.
+  */
+  class Initializer : public InitialStates::AbstractInitializer<Array<real_t> >{
+
+  public:
+
+    Initializer(DynSysData &data){
+
+      m_iSystemMemoryLength = data.getSystemMemoryLength();
+      m_iStateSpaceDim = data.getStateSpaceDim();
+    }
+
+    virtual void initialize(Array<Array<real_t> > &initialStates) const{
+
+      initialStates.alloc(m_iSystemMemoryLength);
+
+      for(int i=0; i<m_iSystemMemoryLength; i++){
+        initialStates[i].alloc(m_iStateSpaceDim);
+      }
+    }
+
+  private:
+
+    int m_iSystemMemoryLength;
+    int m_iStateSpaceDim;
+  };
+
+  MappingWorker(DynSysData &dynSysData, int stateSpaceDimensionSize) :
+    distanceGenerator(stateSpaceDimensionSize){
+
+    data = new MapData(dynSysData.name, Initializer(dynSysData), 1);
+    data->setIterator(new MapIterator(proxy));
+    iterData = new IterData(*data);
+
+    initPrivateOrbit(privateOrbit, dynSysData);
+
+    errorTolerance.maxError.alloc(stateSpaceDimensionSize);
+    errorTolerance.minError.alloc(stateSpaceDimensionSize);
+    globalMaxIndexDistance.alloc(stateSpaceDimensionSize);
+
+    context.iterData = iterData;
+    context.privateOrbit = &privateOrbit;
+    context.errorTolerance = &errorTolerance;
+    context.distanceGenerator = &distanceGenerator;
+    context.globalMaxIndexDistance = &globalMaxIndexDistance;
+  }
+
+  ~MappingWorker(){
+
+    delete iterData;
+    delete data->getIterator();
+    data->setIterator(NULL);
+    delete data;
+  }
+
+  MapProxy proxy;
+  MapData* data;
+  IterData* iterData;
+  CyclicArray<Array <real_t> > privateOrbit;
+  IndexErrorToleranceField errorTolerance;
+  NDimensionIndexDistanceGenerator distanceGenerator;
+  NDimensionIndexDistance globalMaxIndexDistance;
+  MappingContext context;
+};
+
+/**
+  Job for the thread pool: the "cells" of the pool are the workers, so
+  that each thread maps with its own worker. Worker w maps the boxes
+  w, w + numberOfWorkers, w + 2*numberOfWorkers, ... which distributes
+  expensive regions of the state space evenly over the threads.
+*/
+class SymbolicImageIndexBoxManager::BoxMappingJob : public LatticeThreadPool::Job{
+
+public:
+
+  BoxMappingJob(SymbolicImageIndexBoxManager &manager,
+                SymbolicImageAbstractBoxVector &boxes,
+                vector<SymbolicImageAbstractBoxVector> &targetBoxes) :
+    m_manager(manager),
+    m_boxes(boxes),
+    m_targetBoxes(targetBoxes)
+  {}
+
+  virtual bool execute(int beginWorker, int endWorker){
+
+    int numberOfWorkers = m_manager.m_mappingWorkers.size();
+    int numberOfBoxes = m_boxes.size();
+
+    for(int w=beginWorker; w<endWorker; w++){
+
+      MappingContext &context = m_manager.m_mappingWorkers[w]->context;
+
+      for(int i=w; i<numberOfBoxes; i+=numberOfWorkers){
+        m_manager.getBoxMapping(context, m_boxes[i], m_targetBoxes[i]);
+      }
+    }
+    return true;
+  }
+
+private:
+
+  SymbolicImageIndexBoxManager &m_manager;
+  SymbolicImageAbstractBoxVector &m_boxes;
+  vector<SymbolicImageAbstractBoxVector> &m_targetBoxes;
+};
 
 SymbolicImageIndexBoxManager::SymbolicImageIndexBox::SymbolicImageIndexBox
     (NDimensionIndex* index){
@@ -138,6 +259,10 @@ SymbolicImageIndexBoxManager::SymbolicImageIndexBoxManager(){
 
   m_pDataReader = NULL;
   m_infBox = NULL;
+
+  m_iNumberOfThreads = 1;
+  m_pThreadPool = NULL;
+  m_bSerialMappingReported = false;
 }
 
 // public constructor which calls the init-function
@@ -156,6 +281,11 @@ SymbolicImageIndexBoxManager::SymbolicImageIndexBoxManager(int stateSpaceDimensi
   m_bUseErrorTolerance = false;
 
   m_pDataReader = NULL;
+  m_infBox = NULL;
+
+  m_iNumberOfThreads = 1;
+  m_pThreadPool = NULL;
+  m_bSerialMappingReported = false;
 
   //SymbolicImageIndexBoxManager();
   init(stateSpaceDimensionSize);
@@ -205,6 +335,13 @@ SymbolicImageIndexBoxManager::~SymbolicImageIndexBoxManager(){
     delete m_pDataReader;
     m_pDataReader = NULL;
   }
+
+  deleteMappingWorkers();
+
+  if(m_pThreadPool){
+    delete m_pThreadPool;
+    m_pThreadPool = NULL;
+  }
 }
 
 bool SymbolicImageIndexBoxManager::reset(){
@@ -663,6 +800,13 @@ bool SymbolicImageIndexBoxManager::subdivide(int numberOfBoxes, bool bDeleteBoxe
 
 void SymbolicImageIndexBoxManager::getBoxMapping(SymbolicImageAbstractBox * box,
                                                                       SymbolicImageAbstractBoxVector & targetBoxes){
+
+  MappingContext context = getDefaultMappingContext();
+  getBoxMapping(context, box, targetBoxes);
+}
+
+void SymbolicImageIndexBoxManager::getBoxMapping(MappingContext & context, SymbolicImageAbstractBox * box,
+                                                                      SymbolicImageAbstractBoxVector & targetBoxes){
                                                               
    int numOfPoints = m_pScanPointCalculator->getNumberOfScanPoints();
 
@@ -683,30 +827,38 @@ void SymbolicImageIndexBoxManager::getBoxMapping(SymbolicImageAbstractBox * box,
     for(int scanPointNumber=0;scanPointNumber<numOfPoints;scanPointNumber++){
 
         // get f(x) for each scan point
-        Array< real_t> *result = calculateFunctionPoint(indexBoxPoint,  (*indexBox->indexPosition), scanPointNumber);
+        Array< real_t> *result = calculateFunctionPoint(context, indexBoxPoint,  (*indexBox->indexPosition), scanPointNumber);
         
        // now we have the value and need to find the new index box. Therefore
        // we first have to calculate the corresponding index.
        // if this is the first box object, the distance object must be reseted, but
        // only if a box can be found. Therefore keep track of that in the bResetDistanceSet variable
-       bResetDistanceSet = getBoxesForPoint( (*result),targetBoxes,bResetDistanceSet);
+       bResetDistanceSet = getBoxesForPoint(context, (*result),targetBoxes,bResetDistanceSet);
   }
 }
 
-inline Array< real_t >* SymbolicImageIndexBoxManager::calculateFunctionPoint(Array<real_t> &point, NDimensionIndex &pointIndex, int scanPointNumber){
+Array< real_t >* SymbolicImageIndexBoxManager::calculateFunctionPoint(Array<real_t> &point, NDimensionIndex &pointIndex, int scanPointNumber){
+
+  MappingContext context = getDefaultMappingContext();
+  return calculateFunctionPoint(context, point, pointIndex, scanPointNumber);
+}
+
+inline Array< real_t >* SymbolicImageIndexBoxManager::calculateFunctionPoint(MappingContext & context, Array<real_t> &point, NDimensionIndex &pointIndex, int scanPointNumber){
+
+  CyclicArray<Array <real_t> > &privateOrbit = *context.privateOrbit;
 
   // reset the private orbit
-  m_privateOrbit.reset();
-  m_privateOrbit.getNext();
-  m_privateOrbit.addNext();
+  privateOrbit.reset();
+  privateOrbit.getNext();
+  privateOrbit.addNext();
 
   // scan on iter data. Do this by swapping its current value with "our" scan point value
   // in the private orbit. do then the calculation and swap values again to set
   // the iter data back to its former state
 
-  m_pScanPointCalculator->getScanPoint(point,scanPointNumber,m_privateOrbit[0]);
+  m_pScanPointCalculator->getScanPoint(point,scanPointNumber,privateOrbit[0]);
 
-  m_pIterData->dynSysData.orbit.swap(m_privateOrbit);
+  context.iterData->dynSysData.orbit.swap(privateOrbit);
 
   NDimensionIndex* currentIndex = &pointIndex;
   bool bCurrentIsPoint = true;
@@ -714,15 +866,15 @@ inline Array< real_t >* SymbolicImageIndexBoxManager::calculateFunctionPoint(Arr
 
   for(int j=0;j<m_iNumOfIterations[m_iCurrentSubdivisionDepth];j++){
 
-    m_pIterData->dynSysData.getIterator()->execute(*m_pIterData);
+    context.iterData->dynSysData.getIterator()->execute(*context.iterData);
 
     // check if we are in another box if option is set.
     if(m_bStopIterInNewBox[m_iCurrentSubdivisionDepth]){
 
         // this is definitely not the best implementation but the
         // function is probably not very broadly used...
-        m_pIterData->dynSysData.orbit.swap(m_privateOrbit);
-        NDimensionIndex* index = m_pIndexValueMapper->getIndexForValue(m_privateOrbit[0]);
+        context.iterData->dynSysData.orbit.swap(privateOrbit);
+        NDimensionIndex* index = m_pIndexValueMapper->getIndexForValue(privateOrbit[0]);
 
         // stop iterating if we are in another box which could
         // also be no box (=NULL)
@@ -750,7 +902,7 @@ inline Array< real_t >* SymbolicImageIndexBoxManager::calculateFunctionPoint(Arr
 		 bHasLeftInitialBox = true;
 		}
         if(index) delete index;
-        m_pIterData->dynSysData.orbit.swap(m_privateOrbit);
+        context.iterData->dynSysData.orbit.swap(privateOrbit);
 
     }
 
@@ -758,8 +910,8 @@ inline Array< real_t >* SymbolicImageIndexBoxManager::calculateFunctionPoint(Arr
 
        // this is definitely not the best implementation but the
         // function is probably not very broadly used...
-        m_pIterData->dynSysData.orbit.swap(m_privateOrbit);
-        NDimensionIndex* index = m_pIndexValueMapper->getIndexForValue(m_privateOrbit[0]);
+        context.iterData->dynSysData.orbit.swap(privateOrbit);
+        NDimensionIndex* index = m_pIndexValueMapper->getIndexForValue(privateOrbit[0]);
 
         // stop iterating if we are in another box which could
         // also be no box (=NULL)
@@ -787,7 +939,7 @@ inline Array< real_t >* SymbolicImageIndexBoxManager::calculateFunctionPoint(Arr
         }
         else if(index) delete index;
         
-        m_pIterData->dynSysData.orbit.swap(m_privateOrbit);
+        context.iterData->dynSysData.orbit.swap(privateOrbit);
     }
     
   }
@@ -796,12 +948,18 @@ inline Array< real_t >* SymbolicImageIndexBoxManager::calculateFunctionPoint(Arr
    delete currentIndex;
   }
 
-  m_pIterData->dynSysData.orbit.swap(m_privateOrbit);
+  context.iterData->dynSysData.orbit.swap(privateOrbit);
 
-  return (&m_privateOrbit[0]);
+  return (&privateOrbit[0]);
 }
 
-inline bool SymbolicImageIndexBoxManager::getBoxesForPoint(Array<real_t> &point, SymbolicImageAbstractBoxVector &targetBoxes, bool resetDistanceSet){
+bool SymbolicImageIndexBoxManager::getBoxesForPoint(Array<real_t> &point, SymbolicImageAbstractBoxVector &targetBoxes, bool resetDistanceSet){
+
+  MappingContext context = getDefaultMappingContext();
+  return getBoxesForPoint(context, point, targetBoxes, resetDistanceSet);
+}
+
+inline bool SymbolicImageIndexBoxManager::getBoxesForPoint(MappingContext & context, Array<real_t> &point, SymbolicImageAbstractBoxVector &targetBoxes, bool resetDistanceSet){
 
     NDimensionIndex* index;
     bool bIsFirstDistanceSet = resetDistanceSet;
@@ -809,8 +967,8 @@ inline bool SymbolicImageIndexBoxManager::getBoxesForPoint(Array<real_t> &point,
     // depending if there is an error tolerance, the index value for the point is calculated
     if(m_bUseErrorTolerance[m_iCurrentSubdivisionDepth]){
       
-        // the current error tolerance will be written in m_errorTolerance variable
-        index = m_pIndexValueMapper->getIndexForValue(m_errorTolerance,point);
+        // the current error tolerance will be written in (*context.errorTolerance) variable
+        index = m_pIndexValueMapper->getIndexForValue((*context.errorTolerance),point);
     }
     else index = m_pIndexValueMapper->getIndexForValue(point);
 
@@ -836,11 +994,11 @@ inline bool SymbolicImageIndexBoxManager::getBoxesForPoint(Array<real_t> &point,
 
         // set the distance generator for this mapping
         if(bIsFirstDistanceSet){
-          m_pDistanceGenerator->resetToIndex( (*index) );
+          context.distanceGenerator->resetToIndex( (*index) );
           bIsFirstDistanceSet = false;
         }
         else{
-          m_pDistanceGenerator->addNewIndexDistance( (*index) );
+          context.distanceGenerator->addNewIndexDistance( (*index) );
         }
 
         
@@ -858,7 +1016,7 @@ inline bool SymbolicImageIndexBoxManager::getBoxesForPoint(Array<real_t> &point,
         else*/ if(m_bUseErrorTolerance[m_iCurrentSubdivisionDepth]){
 
           
-          addErrorToleranceBoxes( iBox , targetBoxes);
+          addErrorToleranceBoxes( context, iBox , targetBoxes);
         }
         // else just add the found box
         else targetBoxes.push_back(iBox);
@@ -870,18 +1028,25 @@ inline bool SymbolicImageIndexBoxManager::getBoxesForPoint(Array<real_t> &point,
 
     // also update, if necessary, the global distance parameter.
    if(!bIsFirstDistanceSet)
-      m_pDistanceGenerator->updateGlobalIndexDistance(m_globalMaxIndexDistance);
+      context.distanceGenerator->updateGlobalIndexDistance((*context.globalMaxIndexDistance));
   
     return bIsFirstDistanceSet;           
 }
 
-inline void SymbolicImageIndexBoxManager::addErrorToleranceBoxes(SymbolicImageIndexBox* sourceBox,
+void SymbolicImageIndexBoxManager::addErrorToleranceBoxes(SymbolicImageIndexBox* sourceBox,
+                                                                          SymbolicImageAbstractBoxVector & targetBoxes){
+
+  MappingContext context = getDefaultMappingContext();
+  addErrorToleranceBoxes(context, sourceBox, targetBoxes);
+}
+
+inline void SymbolicImageIndexBoxManager::addErrorToleranceBoxes(MappingContext & context, SymbolicImageIndexBox* sourceBox,
                                                                           SymbolicImageAbstractBoxVector & targetBoxes){
 
     // calculate the indices in error tolerance
     // range, find their boxes and add them to the targetBoxes vector. easy.
     NDimensionIndexVector indexVector;
-    m_pIndexValueMapper->getErrorToleranceIndices((*sourceBox->indexPosition),m_errorTolerance, indexVector);
+    m_pIndexValueMapper->getErrorToleranceIndices((*sourceBox->indexPosition),(*context.errorTolerance), indexVector);
 
     NDimensionIndexVector::iterator indIt = indexVector.begin();
     NDimensionIndexVector::iterator indEnd = indexVector.end();
@@ -895,7 +1060,7 @@ inline void SymbolicImageIndexBoxManager::addErrorToleranceBoxes(SymbolicImageIn
        if(m_infBox) targetBoxes.push_back(m_infBox);
       }
       else{
-        m_pDistanceGenerator->addNewIndexDistance( (*pindex) );
+        context.distanceGenerator->addNewIndexDistance( (*pindex) );
         targetBoxes.push_back(boxIt->second);
       }
 
@@ -910,15 +1075,20 @@ void SymbolicImageIndexBoxManager::initPrivateOrbit(){
     // length and allocate every position with a array of state space
     // dimension size.
 
-    CyclicArray<Array <real_t> > newOrbit(m_pIterData->dynSysData.getSystemMemoryLength()+1);
+    initPrivateOrbit(m_privateOrbit, m_pIterData->dynSysData);
+}
+
+void SymbolicImageIndexBoxManager::initPrivateOrbit(CyclicArray<Array <real_t> > &privateOrbit, DynSysData &dynSysData){
+
+    CyclicArray<Array <real_t> > newOrbit(dynSysData.getSystemMemoryLength()+1);
     newOrbit.alloc();
 
-    m_privateOrbit <<= newOrbit;
+    privateOrbit <<= newOrbit;
 
-    for(int k=0;k<m_privateOrbit.getFutureSize();k++){
-      Array<real_t> &scanPoint = m_privateOrbit.getNext();
-      scanPoint.alloc(m_pIterData->dynSysData.getStateSpaceDim());
-      m_privateOrbit.addNext();
+    for(int k=0;k<privateOrbit.getFutureSize();k++){
+      Array<real_t> &scanPoint = privateOrbit.getNext();
+      scanPoint.alloc(dynSysData.getStateSpaceDim());
+      privateOrbit.addNext();
     }
 }
 
@@ -926,6 +1096,125 @@ void SymbolicImageIndexBoxManager::setCurrentIterData(IterData & iterData){
 
   SymbolicImageAbstractBoxManager::setCurrentIterData(iterData);
   initPrivateOrbit();
+
+  // the workers are copies of the former iter data, so they
+  // will be created again with the next concurrent mapping
+  deleteMappingWorkers();
+}
+
+SymbolicImageIndexBoxManager::MappingContext SymbolicImageIndexBoxManager::getDefaultMappingContext(){
+
+  MappingContext context;
+
+  context.iterData = m_pIterData;
+  context.privateOrbit = &m_privateOrbit;
+  context.errorTolerance = &m_errorTolerance;
+  context.distanceGenerator = m_pDistanceGenerator;
+  context.globalMaxIndexDistance = &m_globalMaxIndexDistance;
+
+  return context;
+}
+
+void SymbolicImageIndexBoxManager::setNumberOfThreads(int numberOfThreads){
+
+  if(numberOfThreads < 1){
+    cerr << "Number of threads for the box mapping must be at least 1."
+    << endl << Error::Exit;
+  }
+
+  deleteMappingWorkers();
+
+  if(m_pThreadPool){
+    delete m_pThreadPool;
+    m_pThreadPool = NULL;
+  }
+
+  m_iNumberOfThreads = numberOfThreads;
+
+  if(m_iNumberOfThreads > 1){
+    m_pThreadPool = new LatticeThreadPool(m_iNumberOfThreads);
+  }
+}
+
+bool SymbolicImageIndexBoxManager::canMapConcurrently(){
+
+  if(!m_pThreadPool) return false;
+
+  if(m_bConnectIterBoxes[m_iCurrentSubdivisionDepth]) return false;
+
+  // random scan points are drawn by 'rand', which is not thread-safe and
+  // would make the graph depend on the scheduling of the threads.
+  if(m_pScanPointCalculator->hasRandomScanPoints()){
+    if(!m_bSerialMappingReported){
+      cout << "Concurrent box mapping is not possible for random scan "
+      << "points. The boxes will be mapped serially." << endl;
+      m_bSerialMappingReported = true;
+    }
+    return false;
+  }
+
+  Iterator* iterator = m_pIterData->dynSysData.getIterator();
+
+  if( (typeid(m_pIterData->dynSysData) == typeid(MapData)) &&
+      (dynamic_cast<MapIterator*> (iterator) != NULL) &&
+      (typeid(*(iterator->getProxy())) == typeid(MapProxy)) &&
+      (MapProxy::systemFunction != MapProxy::ParsedSystemFunction) ){
+    return true;
+  }
+
+  // the equations of motion given in the configuration file are
+  // evaluated with shared parser data, hence not concurrently.
+  if(!m_bSerialMappingReported){
+    cout << "Concurrent box mapping is only possible for maps with "
+    << "a compiled system function. "
+    << "The boxes will be mapped serially." << endl;
+    m_bSerialMappingReported = true;
+  }
+
+  return false;
+}
+
+void SymbolicImageIndexBoxManager::deleteMappingWorkers(){
+
+  for(unsigned int i=0; i<m_mappingWorkers.size(); i++){
+    delete m_mappingWorkers[i];
+  }
+  m_mappingWorkers.clear();
+}
+
+void SymbolicImageIndexBoxManager::getBoxMappings(SymbolicImageAbstractBoxVector & boxes,
+                                                  vector<SymbolicImageAbstractBoxVector> & targetBoxes){
+
+  if(!canMapConcurrently()){
+    SymbolicImageAbstractBoxManager::getBoxMappings(boxes, targetBoxes);
+    return;
+  }
+
+  targetBoxes.resize(boxes.size());
+
+  if(m_mappingWorkers.empty()){
+    for(int i=0; i<m_iNumberOfThreads; i++){
+      m_mappingWorkers.push_back(new MappingWorker(m_pIterData->dynSysData, m_iStateSpaceDimensionSize));
+    }
+  }
+
+  // the parameters may have been changed by a scan
+  for(unsigned int i=0; i<m_mappingWorkers.size(); i++){
+    m_mappingWorkers[i]->data->parameters = m_pIterData->dynSysData.parameters;
+    m_pDistanceGenerator->resetGlobalIndexDistance(m_mappingWorkers[i]->globalMaxIndexDistance);
+  }
+
+  BoxMappingJob job(*this, boxes, targetBoxes);
+  m_pThreadPool->run(job, 0, m_mappingWorkers.size());
+
+  // the maximum index distance is the maximum over all threads
+  for(unsigned int i=0; i<m_mappingWorkers.size(); i++){
+    NDimensionIndexDistance &distance = m_mappingWorkers[i]->globalMaxIndexDistance;
+
+    for(int j=0; j<m_iStateSpaceDimensionSize; j++){
+      if(distance[j] > m_globalMaxIndexDistance[j]) m_globalMaxIndexDistance[j] = distance[j];
+    }
+  }
 }
 
 SymbolicImageInfinityBox* SymbolicImageIndexBoxManager::getCurrentInfinityBox(){
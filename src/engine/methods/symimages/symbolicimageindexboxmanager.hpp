@@ -32,6 +32,7 @@
 #include "utils/dimensionhandler/ndimensionindexhandler.hpp"
 #include "utils/datareader/inputdatareader.hpp"
 #include "iterators/Iterator.hpp"
+#include "proxies/LatticeThreadPool.hpp"
 #include "symbolicimageabstractindexvaluemapper.hpp"
 #include "symbolicimageabstractscanpointcalculator.hpp"
 #include "symbolicimageoutputformat.hpp"
@@ -190,6 +191,22 @@ public:
   */
   virtual void getBoxMapping(SymbolicImageAbstractBox * box, SymbolicImageAbstractBoxVector & targetBoxes);
 
+  /**
+      Get the mappings of several boxes. If more than one thread is set
+      and the system is a map with a compiled system function, the boxes
+      are mapped concurrently, each thread with its own iteration data and
+      orbit. Otherwise the boxes are mapped one after the other.
+
+      @param boxes the boxes to map
+      @param targetBoxes vectors of target boxes, one for each box
+  */
+  virtual void getBoxMappings(SymbolicImageAbstractBoxVector & boxes, vector<SymbolicImageAbstractBoxVector> & targetBoxes);
+
+  /**
+      Sets the number of threads used by getBoxMappings.
+  */
+  void setNumberOfThreads(int numberOfThreads);
+
   virtual bool loadBoxCovering(string & filename, int startRow, int startLine, SymbolicImageAbstractBoxVector & targetBoxes, real_t errorToleranceValue);
 
   
@@ -242,6 +259,28 @@ public:
   
 protected:
 
+  /**
+    Everything a box mapping writes to. A mapping which runs
+    concurrently to other mappings needs its own context.
+  */
+  struct MappingContext{
+
+    /** The iteration data used to calculate f^n(x). */
+    IterData* iterData;
+
+    /** Orbit swapped into the iteration data during the calculation. */
+    CyclicArray<Array <real_t> >* privateOrbit;
+
+    /** The error tolerance of the current box mapping. */
+    IndexErrorToleranceField* errorTolerance;
+
+    /** The index distance of the current box mapping. */
+    NDimensionIndexDistanceGenerator* distanceGenerator;
+
+    /** The maximum index distance of all mappings of this context. */
+    NDimensionIndexDistance* globalMaxIndexDistance;
+  };
+
   /** Constructor which can only be called by derived classes.*/
   SymbolicImageIndexBoxManager();
 
@@ -257,6 +296,8 @@ protected:
   */
   void addErrorToleranceBoxes(SymbolicImageIndexBox* sourceBox,
                                                                       SymbolicImageAbstractBoxVector & targetBoxes);
+  void addErrorToleranceBoxes(MappingContext & context, SymbolicImageIndexBox* sourceBox,
+                                                                      SymbolicImageAbstractBoxVector & targetBoxes);
   /**
      Puts all boxes belonging to this point within error tolerance into the vector targetBoxes.
      Function only called internally.
@@ -267,6 +308,7 @@ protected:
      @return true if the distance has not been reset because there were no boxes created
    */
   bool getBoxesForPoint(Array<real_t> &point, SymbolicImageAbstractBoxVector &targetBoxes, bool resetDistanceSet);
+  bool getBoxesForPoint(MappingContext & context, Array<real_t> &point, SymbolicImageAbstractBoxVector &targetBoxes, bool resetDistanceSet);
 
   /**
     Calculates the point f(x) belonging to the i-th scan point in index box pointIndex. This
@@ -278,6 +320,16 @@ protected:
      @return the value f(x)
   */
   Array< real_t >* calculateFunctionPoint(Array<real_t> &point, NDimensionIndex &pointIndex, int scanPointNumber);
+  Array< real_t >* calculateFunctionPoint(MappingContext & context, Array<real_t> &point, NDimensionIndex &pointIndex, int scanPointNumber);
+
+  /**
+    Calculates the mapping of the box using the given context. Function only
+    called internally.
+  */
+  void getBoxMapping(MappingContext & context, SymbolicImageAbstractBox * box, SymbolicImageAbstractBoxVector & targetBoxes);
+
+  /** The context of the box mappings done by the calling thread. */
+  MappingContext getDefaultMappingContext();
 
   /** No descriptions */
   bool initDomainDescriptionLoader(string & filename);
@@ -340,6 +392,30 @@ private:
   /** Inintialise the privat orbit. */
   void initPrivateOrbit();
 
+  /** Allocates the given orbit for the calculation of f^n(x) in the given system. */
+  static void initPrivateOrbit(CyclicArray<Array <real_t> > &privateOrbit, DynSysData &dynSysData);
+
+  /**
+    Iteration data, orbit and mapping context of one thread. Defined in the
+    implementation file.
+  */
+  class MappingWorker;
+
+  /** Maps a part of the boxes, one part per thread. */
+  class BoxMappingJob;
+
+  /**
+    Returns true if the boxes of the current subdivision step can be mapped
+    concurrently. This is only the case for maps with a compiled system
+    function, since a private copy of the iterator is needed for each thread,
+    and if the iterated boxes are not connected, since this changes the cells
+    during the mapping.
+  */
+  bool canMapConcurrently();
+
+  /** Deletes the iteration data of all threads. */
+  void deleteMappingWorkers();
+
 protected:
 
   /** The error tolerance of the current box mapping. Contains only temporary values*/
@@ -371,6 +447,18 @@ private:
   */
   NDimensionIndexDistance m_globalMaxIndexDistance;
 
+  /** Number of threads used for box mappings. */
+  int m_iNumberOfThreads;
+
+  /** Thread pool for box mappings, NULL if the boxes are mapped serially. */
+  LatticeThreadPool* m_pThreadPool;
+
+  /** One worker for each thread, created with the first concurrent mapping. */
+  vector<MappingWorker*> m_mappingWorkers;
+
+  /** True if the warning about serial mapping has already been written. */
+  bool m_bSerialMappingReported;
+
   //SymbolicImageIndexBox* currentBox;
   
 };
@@ -46,7 +46,10 @@ VisualizationConnector (ScanData & scanData,
 			Configuration& methodsDescription,
 			MethodsData& methodsData)
 #if ANT_HAS_VIS
-  : writeData (NULL),
+  : feed (NULL),
+    headless (false),
+    feedConsumer (NULL),
+    writeData (NULL),
     waitForVisualization (NULL)
 #endif
 {
@@ -116,6 +119,33 @@ VisualizationConnector (ScanData & scanData,
 				      methodsDescription, 
 				      numberOfOrbitsToExport+1);
 
+  if ( methodsDescription.checkForKey ("FEED_POLICY_KEY")
+       && (! methodsDescription.checkForEnumValue 
+	   ("FEED_POLICY_KEY", "SYNCHRONOUS_FEED_KEY")) )
+    {
+      TFeedPolicy policy = fpDropOldest;
+      if (methodsDescription.checkForEnumValue 
+	  ("FEED_POLICY_KEY", "DECIMATE_FEED_KEY"))
+	policy = fpDecimate;
+
+      int feedSize = methodsDescription.getInteger ("FEED_SIZE_KEY");
+      feed = new TRowFeed (buffer, feedSize, policy);
+
+      headless = methodsDescription.getBool ("HEADLESS_KEY");
+      if (! headless)
+	vis->setFeed (feed);
+    }
+  else if ( methodsDescription.checkForKey ("HEADLESS_KEY")
+	    && methodsDescription.getBool ("HEADLESS_KEY") )
+    {
+      cerr << "Visualization Connector Error: '"
+	   << methodsDescription.getOriginalKey("HEADLESS_KEY")
+	   << "' requires a non-synchronous '"
+	   << methodsDescription.getOriginalKey("FEED_POLICY_KEY")
+	   << "'."
+	   << endl << Error::Exit;
+    }
+
   // VA: it should be redesigned as conditional transition!
   writeData = new WriteData (*this, plotStep, transient);
   waitForVisualization = new WaitForVisualization(*this);
@@ -154,6 +184,34 @@ WriteData::execute (IterData& iterData)
       stepCount = 0;
     }
 
+  if (owner.feed != NULL)
+    {
+      // first column is time
+      buffer_row[0] = iterData.dynSysData.timer.getCurrentTime ();
+      for (int i=0; i < owner.numberOfOrbitsToExport; i++)
+	{
+          buffer_row[i+1]=iterData.dynSysData.orbit[0][owner.exportedOrbits[i]];
+	}
+      owner.feed->put (buffer_row);
+
+      if (owner.headless) 
+	{
+	  if (owner.feedConsumer == NULL) 
+	    {
+	      gettimeofday (&(owner.feedStartTime), NULL);
+	      owner.feedConsumer = new FeedConsumer (*(owner.feed));
+	      owner.feedConsumer->start ();
+	    }
+	}
+      else if (vis == NULL) 
+	{
+	  vis = getGlobalVisualization ();
+	  vis->runThread ();
+	}
+
+      return;
+    }
+
   if (vis == NULL) {
     vis = getGlobalVisualization ();
     vis->runThread ();
@@ -173,6 +231,41 @@ WriteData::execute (IterData& iterData)
     }
 }
 
+// *********************************************************
+VisualizationConnector::
+FeedConsumer::FeedConsumer (TRowFeed& aFeed) :
+  TThread ("VisualizationConnector::FeedConsumer"),
+  feed (aFeed),
+  stopRequested (false)
+{}
+
+// virtual
+void
+VisualizationConnector::
+FeedConsumer::execute ()
+{
+  while (! __atomic_load_n (&stopRequested, __ATOMIC_ACQUIRE))
+    {
+      if (feed.drain () == 0)
+	sleep_ms (1);
+    }
+
+  feed.drain ();
+}
+
+void
+VisualizationConnector::
+FeedConsumer::stop ()
+{
+  __atomic_store_n (&stopRequested, true, __ATOMIC_RELEASE);
+
+#if (OPTION__WINDOWS_THREADS)
+  WaitForSingleObject (handle, INFINITE);
+#else
+  pthread_join (thread, NULL);
+#endif
+}
+
 // *********************************************************
 VisualizationConnector::
 WaitForVisualization::WaitForVisualization (VisualizationConnector & aOwner ) :
@@ -188,6 +281,35 @@ WaitForVisualization::execute (IterData& iterData)
   cout << "VisualizationConnector: waiting for visualization to quit..."
        << endl;
 #endif
+  if (owner.headless)
+    {
+      if (owner.feedConsumer == NULL)
+	return;
+
+      owner.feedConsumer->stop ();
+
+      struct timeval feedStopTime;
+      gettimeofday (&feedStopTime, NULL);
+
+      double seconds = 
+	(feedStopTime.tv_sec - owner.feedStartTime.tv_sec)
+	+ 1.0e-6 * (feedStopTime.tv_usec - owner.feedStartTime.tv_usec);
+
+      unsigned long offered = owner.feed->getOfferedCount ();
+      unsigned long delivered = owner.feed->getDeliveredCount ();
+
+      cout << "Visualization feed: "
+	   << offered << " states exported, "
+	   << delivered << " delivered, "
+	   << offered - delivered << " dropped in "
+	   << seconds << " s ("
+	   << (seconds > 0 ? delivered / seconds : 0)
+	   << " states/s delivered)"
+	   << endl;
+
+      return;
+    }
+
   (getGlobalVisualization ())->waitForQuit();
 }
 
@@ -221,6 +343,10 @@ VisualizationConnector::~VisualizationConnector ()
   debugMsg1("VisualizationConnector will be destructed");
   delete (writeData);
   delete (waitForVisualization);
+  delete (feedConsumer);
+  if (feed != NULL)
+    (getGlobalVisualization ())->setFeed (NULL);
+  delete (feed);
   delete[] buffer_row;
 #endif
 }
@@ -33,6 +33,12 @@
 
 #include "../MethodsData.hpp"
 
+#if ANT_HAS_VIS
+#include <sys/time.h>
+#include "../../../antvis/buffer.h"
+#include "../../../antvis/threads.h"
+#endif
+
 typedef int ini_integer;
 
 /**
@@ -64,7 +70,46 @@ public:
    */
   Array<int> exportedOrbits;
 
+  /**
+   * ring between the simulation and the visualization. NULL for the
+   * synchronous feed, where the simulation waits for the visualization
+   * at each exported step.
+   */
+  TRowFeed* feed;
+
+  /**
+   * if true, the visualization is not opened and the feed is drained
+   * by a 'FeedConsumer' thread, in order to measure its throughput.
+   */
+  bool headless;
+
 public:
+  /**
+   * drains the feed in headless mode as fast as possible.
+   */
+  class FeedConsumer : public TThread
+  {
+  private:
+    TRowFeed& feed;
+    bool stopRequested;
+
+  public:
+    FeedConsumer (TRowFeed& aFeed);
+    virtual void execute ();
+
+    /**
+     * drains the rest of the feed and waits for the thread to end.
+     */
+    void stop ();
+  };
+
+  FeedConsumer* feedConsumer;
+
+  /**
+   * wall clock time of the first exported step (headless mode)
+   */
+  struct timeval feedStartTime;
+
   /**
    * data output for external visualization. It will be performed in
    * each simulation step, i.e. in the 'iterMachine' loop sequence.
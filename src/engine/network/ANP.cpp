@@ -90,3 +90,15 @@ long ANP::getLong (iosockstream& s)
   debugANP (std::cout << "getLong: " << buf << std::endl); 
   return atol (buf);
 }
+
+double ANP::getDouble (iosockstream& s)
+{
+  s.getline (buf, 1023);
+  if (! s) {
+    std::cerr << "'ANP::getDouble': something went wrong!"
+	      << std::endl << Error::Exit;
+  }
+
+  debugANP (std::cout << "getDouble: " << buf << std::endl); 
+  return atof (buf);
+}
@@ -45,7 +45,7 @@ using std::string;
 
 #define PUT_SCANPOINTS ("PUT SCANPOINTS")
 #define GET_SCANPOINTS ("GET SCANPOINTS")
-#define ANP_VERSION    ("ANP/2.0.1")
+#define ANP_VERSION    ("ANP/2.2.0")
 #define GET_CONFIG     ("GET CONFIG")
 #define GET_GLOBALS    ("GET GLOBALS")
 #define CONNECT_FAILED ("CONNECT FAILED")
@@ -65,6 +65,9 @@ protected:
 
   // read a long from the socket ending with /n
   long getLong (iosockstream& s);
+
+  // read a double from the socket ending with /n
+  double getDouble (iosockstream& s);
 };
 
 #endif
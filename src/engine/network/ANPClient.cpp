@@ -27,6 +27,7 @@
 #include "ANPClient.hpp"
 #include "ANP.hpp"
 #include "ANPClientStatistics.hpp"
+#include "Compression.hpp"
 #include "../AnT-init.hpp"
 
 #include "methods/output/IOStreamFactory.hpp"
@@ -40,6 +41,7 @@ ANPClient::ANPClient ( const char* serverAddrOrName,
   : serverSocketAddress (NULL),
     clientSocket (NULL),
     currentSeqNumber ("-1"),
+    resultEncoding (IDENTITY_ENCODING),
     statistics (NULL),
     numScanPoints (0)
 {
@@ -157,12 +159,24 @@ void ANPClient::fetchScanPoints ()
        << " scanpoints/second" << endl;
   cout << "fetching " << numScanPoints << " scanpoints" << endl;
 
+  // the speed lets the server estimate the lease of the scanpoints
   *socketStream << GET_SCANPOINTS << endl
-		<< numScanPoints << endl;
+		<< numScanPoints << endl
+		<< statistics->getClientSpeed () << endl;
+
+  // the encodings of the results we can send
+  if (AnT::isCompressingResults && isGzipAvailable ())
+    {
+      *socketStream << GZIP_ENCODING << " ";
+    }
+  *socketStream << IDENTITY_ENCODING << endl;
 
   // fetch the number of available scanpoints
   numScanPoints = getLong (*socketStream);
   cout << "numScanPoints: " << numScanPoints << endl;
+
+  // fetch the encoding of the results chosen by the server
+  getLine (*socketStream, resultEncoding);
   
   string seqNr;
 
@@ -202,6 +216,10 @@ void ANPClient::sendScanPoints ()
   *socketStream << PUT_SCANPOINTS << endl
 		<< numScanPoints << endl;
 	  
+  // bytes of the results, sent and uncompressed
+  long numBytes = 0;
+  long numUncompressedBytes = 0;
+
   // transmit all the scanpoints in scanResults
   map<string, map<string, string>*>::iterator i;
   for (i = scanResults.begin (); i != scanResults.end (); ++i)
@@ -214,9 +232,28 @@ void ANPClient::sendScanPoints ()
       map<string, string>::iterator j;
       for (j = i->second->begin (); j != i->second->end (); ++j)
 	{
-	  *socketStream << j->first << endl
-			<< j->second.size () << endl
-			<< j->second;
+	  string gzipContents;
+	  numUncompressedBytes += j->second.size ();
+
+	  // small contents are sent as they are
+	  if ( (resultEncoding == GZIP_ENCODING)
+	       && gzipString (j->second, gzipContents)
+	       && (gzipContents.size () < j->second.size ()) )
+	    {
+	      *socketStream << j->first << endl
+			    << GZIP_ENCODING << endl
+			    << gzipContents.size () << endl
+			    << gzipContents;
+	      numBytes += gzipContents.size ();
+	    }
+	  else
+	    {
+	      *socketStream << j->first << endl
+			    << IDENTITY_ENCODING << endl
+			    << j->second.size () << endl
+			    << j->second;
+	      numBytes += j->second.size ();
+	    }
 	}
       // delete the file contents
       delete i->second;
@@ -228,6 +265,12 @@ void ANPClient::sendScanPoints ()
   scanResults.clear ();
   
   closeConnection (socketStream);
+
+  if (resultEncoding == GZIP_ENCODING)
+    {
+      cout << "results sent: " << numBytes << " bytes ("
+	   << numUncompressedBytes << " uncompressed)" << endl;
+    }
 }
 
 void ANPClient::transmitScanData (map<string, ostringstream*>& data)
@@ -342,7 +385,9 @@ void createParseTreesForAnTClient (ANPClient* aClient)
 	 << Error::Exit;
   }
 
-  AnT::specRoot = createParseTree (specStream);
+  AnT::specRoot
+    = createCachedParseTree ( AnT::getGlobalKeysCfgFullPathName (),
+			      AnT::getGlobalKeysCacheFullPathName () );
 #endif
 
   aClient->clientSocket = clientSocket1; // dirty hack again...
@@ -53,6 +53,9 @@ private:
   // sequence number of the scanpoint currently in progress
   string currentSeqNumber;
 
+  // encoding of the results, chosen by the server
+  string resultEncoding;
+
   ANPClientStatistics* statistics;
   
   long numScanPoints;
@@ -92,6 +95,11 @@ public:
    * respectively).  */
   friend void createParseTreesForAnTClient (ANPClient* aClient);
 
+  /**
+   * the relay uses the connections of a client to the central server
+   */
+  friend class ANPRelay;
+
   /**
    * Transmits all the data for one scanpoint.
    * @param data a map of filenames and file contents
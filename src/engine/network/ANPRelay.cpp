@@ -0,0 +1,437 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#include "ANPRelay.hpp"
+#include "ANPClient.hpp"
+#include "Compression.hpp"
+#include "../AnT-init.hpp"
+#include "../utils/strconv/StringConverter.hpp"
+
+#include <signal.h>
+
+#include "Time.hpp"
+
+static double getTime ()
+{
+  struct timeval now;
+  gettimeofday (&now, NULL);
+
+  return now.tv_sec + 1e-6 * now.tv_usec;
+}
+
+ANPRelay::ANPRelay ( const char* serverAddrOrName,
+		     long port,
+		     long relayPort,
+		     long numUpstreamScanPoints ) :
+  upstream (NULL),
+  relayPort (relayPort),
+  numUpstreamScanPoints (numUpstreamScanPoints),
+  upstreamEncoding (IDENTITY_ENCODING),
+  final (false),
+  startTime (0.0),
+  numResults (0),
+  numUpstreamConnections (0),
+  numLocalConnections (0)
+{
+#if ANT_HAS_WIN_ENV && (! defined __CYGWIN__)
+#else
+  // don't allow broken pipes to kill the relay
+  sigset_t vo_mask;
+  sigemptyset (&vo_mask);
+  sigaddset (&vo_mask, SIGPIPE);
+  sigaddset (&vo_mask, SIGABRT);
+  if (sigprocmask (SIG_BLOCK, &vo_mask, NULL))
+    {
+      cout << "ANPRelay: sigprocmask failed" << endl << Error::Exit;
+    }
+#endif
+
+  upstream = createANPClient (serverAddrOrName, port, 0, 0);
+}
+
+ANPRelay::~ANPRelay ()
+{
+  map<long, string*>::iterator i;
+  for (i = scanPoints.begin (); i != scanPoints.end (); ++i)
+    {
+      delete i->second;
+    }
+
+  list<string*>::iterator j;
+  for (j = results.begin (); j != results.end (); ++j)
+    {
+      delete *j;
+    }
+
+  destroyANPClient (upstream);
+}
+
+bool ANPRelay::handshake (iosockstream& s)
+{
+  string anpVersion, clientSystemName;
+
+  getLine (s, anpVersion);
+
+  if (anpVersion == ANP_VERSION)
+    {
+      getLine (s, clientSystemName);
+      if (clientSystemName == AnT::systemName ())
+	{
+	  s << ANP_VERSION << endl;
+	  return true;
+	}
+      else
+	{
+	  s << CONNECT_FAILED << endl
+	    << "wrong system.. go away" << endl;
+
+	  cout << "wrong system!" << endl;
+	  cout << "client has " << clientSystemName << endl;
+	  cout << "i have " << AnT::systemName () << endl;
+	}
+    }
+  else
+    {
+      s << CONNECT_FAILED << endl
+	<< "this is ANT... you need to connect with an ANT client and the correct version of ANP"
+	<< endl;
+    }
+  return false;
+}
+
+double ANPRelay::getNodeSpeed ()
+{
+  double runTime = getTime () - startTime;
+
+  if ((numResults == 0) || (runTime <= 0.0))
+    {
+      return 0.0;
+    }
+
+  return numResults / runTime;
+}
+
+void ANPRelay::fetchConfig ()
+{
+  debugANP (cout << "fetchConfig" << endl);
+
+  iosockstream* socketStream = upstream->openConnection ();
+  ++numUpstreamConnections;
+
+  *socketStream << GET_CONFIG << endl;
+
+  // the server closes the connection after the configuration
+  char c;
+  while (socketStream->get (c))
+    {
+      config += c;
+    }
+
+  upstream->closeConnection (socketStream);
+}
+
+void ANPRelay::fetchScanPoints ()
+{
+  debugANP (cout << "fetchScanPoints" << endl);
+
+  iosockstream* socketStream = upstream->openConnection ();
+  ++numUpstreamConnections;
+
+  // the node speed lets the server estimate the lease of the chunk
+  *socketStream << GET_SCANPOINTS << endl
+		<< numUpstreamScanPoints << endl
+		<< getNodeSpeed () << endl
+		<< GZIP_ENCODING << " " << IDENTITY_ENCODING << endl;
+
+  long numScanPoints = getLong (*socketStream);
+  cout << "fetched " << numScanPoints
+       << " scanpoints from the server" << endl;
+
+  getLine (*socketStream, upstreamEncoding);
+
+  for (long i = 0; i < numScanPoints; ++i)
+    {
+      long seqNr = getLong (*socketStream);
+      long length = getLong (*socketStream);
+
+      string* scanPoint = new string ();
+      getString (*socketStream, *scanPoint, length);
+
+      // the server may hand out a scanpoint again, which we still have
+      map<long, string*>::iterator j = scanPoints.find (seqNr);
+      if (j != scanPoints.end ())
+	{
+	  delete j->second;
+	}
+      scanPoints[seqNr] = scanPoint;
+    }
+
+  upstream->closeConnection (socketStream);
+
+  if (numScanPoints == 0)
+    {
+      // the server has all results
+      final = true;
+    }
+}
+
+void ANPRelay::sendResults ()
+{
+  if (results.empty ())
+    {
+      return;
+    }
+
+  debugANP (cout << "sendResults" << endl);
+
+  iosockstream* socketStream = upstream->openConnection ();
+  ++numUpstreamConnections;
+
+  socketStream->unsetf (std::ios::skipws); // unset flag
+
+  *socketStream << PUT_SCANPOINTS << endl
+		<< results.size () << endl;
+
+  list<string*>::iterator i;
+  for (i = results.begin (); i != results.end (); ++i)
+    {
+      *socketStream << **i;
+      delete *i;
+    }
+  results.clear ();
+
+  upstream->closeConnection (socketStream);
+}
+
+void ANPRelay::handlePutScanPoints (iosockstream& s)
+{
+  debugANP (cout << "putScanPoints" << endl);
+
+  long numScanPoints = getLong (s);
+
+  for (long i = 0; i < numScanPoints; ++i)
+    {
+      string* result = new string ();
+
+      try
+	{
+	  // keep the result in the format of PUT SCANPOINTS
+	  long clientSeqNr = getLong (s);
+	  long numFiles = getLong (s);
+	  *result += toString (clientSeqNr) + "\n"
+	    + toString (numFiles) + "\n";
+
+	  for (long j = 0; j < numFiles; ++j)
+	    {
+	      string fileName, encoding, contents;
+	      getLine (s, fileName);
+	      getLine (s, encoding);
+	      long fileLength = getLong (s);
+	      getString (s, contents, fileLength);
+
+	      *result += fileName + "\n"
+		+ encoding + "\n"
+		+ toString (fileLength) + "\n"
+		+ contents;
+	    }
+
+	  results.push_back (result);
+	  ++numResults;
+	}
+      catch (...)
+	{
+	  delete result;
+	  cerr << "'ANPRelay::handlePutScanPoints': an exception occured "
+	       << "(the client may got down during transmission)!"
+	       << endl;
+	  break;
+	}
+    }
+
+  // aggregated results of the node
+  if (results.size () >= static_cast<unsigned long> (numUpstreamScanPoints))
+    {
+      sendResults ();
+    }
+}
+
+void ANPRelay::handleGetScanPoints (iosockstream& s)
+{
+  debugANP (cout << "getScanPoints" << endl);
+
+  long numScanPoints = getLong (s);
+  getDouble (s); // the speed of the client, the node speed is used
+
+  string clientEncodings;
+  getLine (s, clientEncodings);
+
+  if ( (scanPoints.size () < static_cast<unsigned long> (numScanPoints))
+       && !final )
+    {
+      /* the server gets the results before the next chunk, so that
+	 the scanpoints done are not handed out again: */
+      sendResults ();
+      fetchScanPoints ();
+    }
+
+  if (static_cast<unsigned long> (numScanPoints) > scanPoints.size ())
+    {
+      numScanPoints = scanPoints.size ();
+    }
+
+  s << numScanPoints << endl
+    << ( isEncodingAccepted (clientEncodings, upstreamEncoding)
+	 ? upstreamEncoding : string (IDENTITY_ENCODING) )
+    << endl;
+
+  for (long i = 0; i < numScanPoints; ++i)
+    {
+      map<long, string*>::iterator j = scanPoints.begin ();
+
+      s << j->first << endl
+	<< j->second->length () << endl
+	<< *(j->second) << std::flush;
+
+      delete j->second;
+      scanPoints.erase (j);
+    }
+}
+
+void ANPRelay::handleGetConfig (iosockstream &s)
+{
+  debugANP (cout << "getConfig" << endl);
+
+  s << config << std::flush;
+}
+
+void ANPRelay::communicationLoop ()
+{
+  ServerSocket<> serverSocket
+    ( getStandardHostname ().c_str (), relayPort );
+
+  bool openStatus = serverSocket.open ();
+  if (! openStatus) {
+    cout << "'ANPRelay::communicationLoop': Could not open server socket "
+	 << "'" << getStandardHostname () << ":"
+	 << relayPort << "'"
+	 << endl << Error::Exit;
+  }
+
+  bool bindStatus = serverSocket.bind ();
+  if (! bindStatus) {
+    cout << "'ANPRelay::communicationLoop': Could not bind to address "
+	 << "'" << getStandardHostname () << ":"
+	 << relayPort << "'"
+	 << endl << Error::Exit;
+  }
+
+  serverSocket.listen ();
+
+  // the local clients wait in the queue of the socket meanwhile
+  fetchConfig ();
+
+  startTime = getTime ();
+
+  while (!final)
+    {
+      try
+	{
+	  AF<AF_INET>::Socket clientSocket;
+	  MainPtr<ReadWriteSocket>::SubPtr rwSocket
+	    = serverSocket.accept (&clientSocket);
+	  assert (rwSocket->isOpen ());
+	  ++numLocalConnections;
+
+	  iosockstream socketStream (rwSocket);
+
+	  if (handshake (socketStream))
+	    {
+	      string command;
+	      getLine (socketStream, command);
+
+	      if (command == PUT_SCANPOINTS)
+		{
+		  handlePutScanPoints (socketStream);
+		}
+	      else if (command == GET_SCANPOINTS)
+		{
+		  handleGetScanPoints (socketStream);
+		}
+	      else if (command == GET_CONFIG)
+		{
+		  handleGetConfig (socketStream);
+		}
+	      else
+		{
+		  socketStream << ANP_VERSION << endl
+			       << "sorry, you seem to be confused :)" << endl;
+		}
+	    }
+
+	  bool closeStatus = false;
+	  closeStatus = rwSocket->close ();
+	  assert (closeStatus);
+	}
+      catch (const ANPClientExit&)
+	{
+	  // the central server is down
+	  throw;
+	}
+      catch (...)
+	{
+	  cout << "AnT socket caused an exception!!!";
+	  cout << endl << Error::Exit;
+	}
+    }
+
+  double runTime = getTime () - startTime;
+
+  cout << numResults << " results of the local clients relayed, "
+       << numLocalConnections << " local connections, "
+       << numUpstreamConnections << " connections to the server, "
+       << runTime << " sec" << endl;
+}
+
+ANPRelay* /*: new allocated */
+createANPRelay ( const char* serverAddrOrName,
+		 long port,
+		 long relayPort,
+		 long numUpstreamScanPoints )
+{
+  return
+    new ANPRelay
+    ( serverAddrOrName, port, relayPort, numUpstreamScanPoints );
+}
+
+void runANPRelay (ANPRelay* aRelay)
+{
+  aRelay->communicationLoop ();
+}
+
+void destroyANPRelay (ANPRelay* aRelay /*: new allocated */)
+{
+  delete aRelay;
+}
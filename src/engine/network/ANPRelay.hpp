@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#ifndef ANP_RELAY_HPP
+#define ANP_RELAY_HPP
+
+#include <map>
+#include <list>
+using std::map;
+using std::list;
+
+#include "ANP.hpp"
+
+class ANPClient;
+
+/**
+ * ANPRelay implements the runmode 'relay': one relay per node speaks
+ * ANP to the central server like a client and to the clients of its
+ * node like a server. The relay fetches large chunks of scanpoints
+ * from the central server, hands them out in small chunks to the
+ * local clients and sends their results back in one aggregated
+ * PUT SCANPOINTS per chunk. Hence the central server has one
+ * connection per chunk and node instead of one per chunk and core.
+ *
+ * The relay neither parses the configuration nor simulates, it keeps
+ * the text of the configuration, of the scanpoints and of the results
+ * only (compressed results are passed on as they are). Scanpoints
+ * lost by a local client are handed out again by the central server,
+ * when their lease expires.
+ */
+class ANPRelay: public ANP
+{
+private:
+  /**
+   * the connection to the central server
+   */
+  ANPClient* upstream;
+
+  /**
+   * the port the local clients connect to
+   */
+  long relayPort;
+
+  /**
+   * number of scanpoints fetched from the central server at once,
+   * also the number of results sent upstream at once
+   */
+  long numUpstreamScanPoints;
+
+  /**
+   * the initialization file fetched from the central server
+   */
+  string config;
+
+  /**
+   * scanpoints fetched from the central server, not yet handed out
+   * (sequence number of the central server, scanpoint)
+   */
+  map<long, string*> scanPoints;
+
+  /**
+   * results of the local clients, not yet sent upstream, each in the
+   * format of PUT SCANPOINTS (sequence number, files)
+   */
+  list<string*> results;
+
+  /**
+   * encoding of the results chosen by the central server, the relay
+   * passes the results of the local clients on without decoding
+   */
+  string upstreamEncoding;
+
+  /**
+   * true, if the central server has no scanpoints anymore
+   */
+  bool final;
+
+  double startTime;
+  long numResults;
+  long numUpstreamConnections;
+  long numLocalConnections;
+
+  /**
+   * does the ANP handshake with a local client. returns true is
+   * successful
+   */
+  bool handshake (iosockstream& s);
+
+  /**
+   * the scanpoints per second of all local clients together,
+   * 0 if not known yet
+   */
+  double getNodeSpeed ();
+
+  void fetchConfig ();
+
+  void fetchScanPoints ();
+
+  void sendResults ();
+
+  void handlePutScanPoints (iosockstream& s);
+
+  void handleGetScanPoints (iosockstream& s);
+
+  void handleGetConfig (iosockstream& s);
+
+public:
+  /**
+   * @param serverAddrOrName the host of the central server
+   * @param port the port of the central server
+   * @param relayPort the port the local clients connect to
+   * @param numUpstreamScanPoints number of scanpoints fetched from
+   *                              the central server at once
+   */
+  ANPRelay ( const char* serverAddrOrName,
+	     long port,
+	     long relayPort,
+	     long numUpstreamScanPoints );
+
+  ~ANPRelay ();
+
+  /**
+   * Implements the whole relay communication loop. Loops until the
+   * central server has no scanpoints anymore.
+   */
+  void communicationLoop ();
+};
+
+ANPRelay* /*: new allocated */
+createANPRelay ( const char* serverAddrOrName,
+		 long port,
+		 long relayPort,
+		 long numUpstreamScanPoints );
+
+void runANPRelay (ANPRelay* aRelay);
+
+void destroyANPRelay (ANPRelay* aRelay /*: new allocated */);
+
+#endif
@@ -31,6 +31,7 @@
 #include <errno.h>
 
 #include "Time.hpp"
+#include "Compression.hpp"
 
 #include "data/ScanData.hpp" 
 
@@ -39,7 +40,8 @@ const real_t ANPServer::percentStep = 1.0;
 ANPServer::ANPServer (ScanItemSequence* scanItemSequence) :
   scanItemSequence (scanItemSequence),
   antFinal (false),
-  final (false)
+  final (false),
+  numSpeculativeScanPoints (0)
 {
 #if ANT_HAS_WIN_ENV && (! defined __CYGWIN__)
 #else
@@ -149,11 +151,11 @@ bool ANPServer::handshake (iosockstream& s)
   return false;
 }
 
-map<string*, string*>* ANPServer::getResult (iosockstream& s)
+result_t* ANPServer::getResult (iosockstream& s)
 {
   debugANP (cout << "getResult" << endl);
 
-  map<string*, string*>* result = new map<string*, string*> ();
+  result_t* result = new result_t ();
 
   // retrieve the number of files
   long numFiles = getLong (s);
@@ -164,6 +166,8 @@ map<string*, string*>* ANPServer::getResult (iosockstream& s)
     {
       string* fileName = new string;
       getLine (s, *fileName);
+      string encoding;
+      getLine (s, encoding);
       long fileLength = getLong (s);
       debugANP (cout << "getResult: fileName: " << *fileName << endl);
       debugANP (cout << "getResult: fileLength: " << fileLength << endl);
@@ -174,17 +178,29 @@ map<string*, string*>* ANPServer::getResult (iosockstream& s)
 
       debugANP (cout << "getResult: fileContents: " << *contents << endl);
 
-      // check filename for validity
-      if (checkFileName (*fileName))
+      bool isGzipped = (encoding == GZIP_ENCODING);
+
+      // check filename and encoding for validity
+      if (! checkFileName (*fileName))
 	{
-	  (*result)[fileName] = contents;
+	  cout << "ANPServer: Invalid filename '" << *fileName << "'" << endl;
+	  delete contents;
+	  delete fileName;
 	}
-      else
+      else if ( (encoding != IDENTITY_ENCODING)
+		&& ! (isGzipped && isGzipAvailable ()) )
 	{
-	  cout << "ANPServer: Invalid filename '" << *fileName << "'" << endl;
+	  cout << "ANPServer: Invalid encoding '" << encoding 
+	       << "' of the file '" << *fileName << "'" << endl;
 	  delete contents;
 	  delete fileName;
 	}
+      else
+	{
+	  ResultFile& resultFile = (*result)[fileName];
+	  resultFile.contents = contents;
+	  resultFile.isGzipped = isGzipped;
+	}
     }
   return result;
 }
@@ -208,7 +224,7 @@ void ANPServer::handlePutScanPoints (iosockstream& s)
     doWriteProgress = doWriteProgress && (clientSeqNr != -1);
 
     try {
-      map<string*, string*>* result = getResult (s);
+      result_t* result = getResult (s);
 
       // report the data to the ScanPointManagement
       spm.scanPointDone (clientSeqNr, result);
@@ -231,12 +247,31 @@ void ANPServer::handleGetScanPoints (iosockstream& s)
   long numScanPoints = getLong (s);
   debugANP (cout << "getScanPoints: numScanPoints: " << numScanPoints << endl);
 
+  // retrieve the speed of the client (scanpoints/second, 0 if unknown)
+  double clientSpeed = getDouble (s);
+
+  // retrieve the encodings of the results the client can send
+  string clientEncodings;
+  getLine (s, clientEncodings);
+
+  const char* resultEncoding = IDENTITY_ENCODING;
+  if ( AnT::isCompressingResults
+       && isGzipAvailable ()
+       && isEncodingAccepted (clientEncodings, GZIP_ENCODING) )
+    {
+      resultEncoding = GZIP_ENCODING;
+    }
+
   // store the scanpoints here
   map<long, string*> scanPoints;
 	  
   string* scanPoint;
   long seqNr;
 
+  // first hand out the scanpoints of expired leases again
+  spm.getExpiredScanPoints 
+    (scanPoints, static_cast<unsigned long> (numScanPoints));
+
   // try to produce new scanpoints
   while ( (scanPoints.size () < static_cast<unsigned long> (numScanPoints))
 	  && !antFinal )
@@ -253,7 +288,8 @@ void ANPServer::handleGetScanPoints (iosockstream& s)
     }
 
   // if we haven't enough yet, ask the scanpoint management 
-  // to reassign scanpoints.
+  // to reassign scanpoints (speculative execution of the scanpoints 
+  // still in progress on other clients).
   while ( (scanPoints.size () < static_cast<unsigned long> (numScanPoints))
 	  && !final ) 
     {
@@ -277,15 +313,24 @@ void ANPServer::handleGetScanPoints (iosockstream& s)
 	  else
 	    {
 	      scanPoints[seqNr] = scanPoint;
+	      ++numSpeculativeScanPoints;
 	    }
 	}
     }
 
-  // report the number of available scanpoints to the client
-  s << scanPoints.size () << endl;
+  // the handed out scanpoints get a new lease
+  map<long, string*>::iterator i;
+  for (i = scanPoints.begin (); i != scanPoints.end (); ++i)
+    {
+      spm.lease (i->first, scanPoints.size (), clientSpeed);
+    }
+
+  // report the number of available scanpoints and the encoding of 
+  // their results to the client
+  s << scanPoints.size () << endl
+    << resultEncoding << endl;
 
   // send all the scanpoints
-  map<long, string*>::iterator i;
   for (i = scanPoints.begin (); i != scanPoints.end (); ++i)
     {
       s << i->first << endl 
@@ -472,4 +517,9 @@ void ANPServer::communicationLoop ()
 
   if ((numScanPoints > 0) && (runTime > 0)) 
     cout << numScanPoints / runTime  << " scanpoints/sec" << endl;
+
+  cout << spm.getNumReissuedScanPoints () 
+       << " scanpoints reissued (expired leases), "
+       << numSpeculativeScanPoints
+       << " scanpoints executed speculatively" << endl;
 }
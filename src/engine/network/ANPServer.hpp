@@ -71,6 +71,12 @@ private:
    */
   bool final;
 
+  /**
+   * number of scanpoints handed out while still in progress on 
+   * another client (near the end of the scan)
+   */
+  long numSpeculativeScanPoints;
+
   static const real_t percentStep;
 
   real_t nextOutput;
@@ -90,7 +96,7 @@ private:
    * reads the result for one scanpoint from the socket 
    * returns a map of filenames to contens
    */
-  std::map<string*, string*>* getResult (iosockstream& s);
+  result_t* getResult (iosockstream& s);
 
   bool checkFileName (string& fileName);
 
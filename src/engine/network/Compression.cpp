@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#ifndef ANT_CONFIG_H
+#include "config.h"
+#endif
+
+#include "Compression.hpp"
+
+#include <sstream>
+
+#if ANT_HAS_LIBZ
+#include <zlib.h>
+
+/* window bits for the gzip format, see 'deflateInit2' */
+#define GZIP_WINDOW_BITS (15 + 16)
+
+/* output chunk of the decompression */
+#define GUNZIP_CHUNK_SIZE 16384
+#endif /* ANT_HAS_LIBZ */
+
+bool isGzipAvailable ()
+{
+#if ANT_HAS_LIBZ
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool isEncodingAccepted (const string& encodings, const string& encoding)
+{
+  std::istringstream is (encodings);
+  string anEncoding;
+
+  while (is >> anEncoding)
+    {
+      if (anEncoding == encoding)
+	{
+	  return true;
+	}
+    }
+
+  return false;
+}
+
+bool gzipString (const string& data, string& gzipData)
+{
+#if ANT_HAS_LIBZ
+  z_stream zs;
+  zs.zalloc = Z_NULL;
+  zs.zfree = Z_NULL;
+  zs.opaque = Z_NULL;
+
+  if (deflateInit2 ( &zs,
+		     Z_DEFAULT_COMPRESSION,
+		     Z_DEFLATED,
+		     GZIP_WINDOW_BITS,
+		     8,
+		     Z_DEFAULT_STRATEGY ) != Z_OK)
+    {
+      return false;
+    }
+
+  /* the bound includes the gzip header and trailer, hence one call
+     of 'deflate' suffices: */
+  gzipData.resize (deflateBound (&zs, data.size ()));
+
+  zs.next_in = (Bytef*) data.data ();
+  zs.avail_in = data.size ();
+  zs.next_out = (Bytef*) &(gzipData[0]);
+  zs.avail_out = gzipData.size ();
+
+  int status = deflate (&zs, Z_FINISH);
+  gzipData.resize (zs.total_out);
+  deflateEnd (&zs);
+
+  return (status == Z_STREAM_END);
+#else
+  return false;
+#endif
+}
+
+bool gunzipToStream (const string& gzipData, ostream& os)
+{
+#if ANT_HAS_LIBZ
+  z_stream zs;
+  zs.zalloc = Z_NULL;
+  zs.zfree = Z_NULL;
+  zs.opaque = Z_NULL;
+  zs.next_in = (Bytef*) gzipData.data ();
+  zs.avail_in = gzipData.size ();
+
+  if (inflateInit2 (&zs, GZIP_WINDOW_BITS) != Z_OK)
+    {
+      return false;
+    }
+
+  char chunk[GUNZIP_CHUNK_SIZE];
+  int status = Z_OK;
+
+  while (status != Z_STREAM_END)
+    {
+      zs.next_out = (Bytef*) chunk;
+      zs.avail_out = GUNZIP_CHUNK_SIZE;
+
+      status = inflate (&zs, Z_NO_FLUSH);
+      if ((status != Z_OK) && (status != Z_STREAM_END))
+	{
+	  inflateEnd (&zs);
+	  return false;
+	}
+
+      os.write (chunk, GUNZIP_CHUNK_SIZE - zs.avail_out);
+
+      // concatenated gzip members
+      if ((status == Z_STREAM_END) && (zs.avail_in > 0))
+	{
+	  inflateReset (&zs);
+	  status = Z_OK;
+	}
+    }
+
+  inflateEnd (&zs);
+  return true;
+#else
+  return false;
+#endif
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#ifndef COMPRESSION_HPP
+#define COMPRESSION_HPP
+
+#include <string>
+#include <iostream>
+using std::string;
+using std::ostream;
+
+/**
+ * encodings of the file contents in PUT SCANPOINTS:
+ * the text itself or a gzip member of it.
+ */
+#define IDENTITY_ENCODING ("identity")
+#define GZIP_ENCODING     ("gzip")
+
+/**
+ * @return true, if AnT was configured with zlib
+ */
+bool isGzipAvailable ();
+
+/**
+ * @param encodings the encodings accepted by a client, separated by
+ *                  blanks
+ * @return true, if the encoding is one of them
+ */
+bool isEncodingAccepted (const string& encodings, const string& encoding);
+
+/**
+ * Compress the data into one gzip member. Gzip members can be
+ * concatenated, the result is a valid gzip file ('zcat' etc.).
+ * @return false, if AnT was configured without zlib
+ */
+bool gzipString (const string& data, string& gzipData);
+
+/**
+ * Decompress the gzip member(s) and write the data to the stream,
+ * chunk by chunk (without a second copy of the whole data).
+ * @return false, if the data is corrupt or AnT was configured
+ *         without zlib
+ */
+bool gunzipToStream (const string& gzipData, ostream& os);
+
+#endif
@@ -25,19 +25,21 @@
  */
 
 #include "ScanPointManagement.hpp"
+#include "Compression.hpp"
+#include "Time.hpp"
 #define OPTION__USE_IOSTREAM_FACTORY 1
 #if OPTION__USE_IOSTREAM_FACTORY
 #include "methods/output/LocalIOStreamFactory.hpp"
 #include "AnT-init.hpp"
 #endif /* OPTION__USE_IOSTREAM_FACTORY */
 
-void eraseResult (map<string*, string*>* result)
+void eraseResult (result_t* result)
 {
-  map<string*, string*>::iterator i;
+  result_t::iterator i;
   for (i = result->begin (); i != result->end (); ++i)
     {
       delete i->first;
-      delete i->second;
+      delete i->second.contents;
     }
   delete result;
 }
@@ -74,31 +76,76 @@ ofstream* ScanPointManagement::getFile (const string& filename)
     }
 }
 
-void ScanPointManagement::saveResult (map<string*, string*>* result)
+void ScanPointManagement::saveResult (result_t* result)
 {
   // save all contents of 'result' into files
-  map<string*, string*>::iterator i;
+  result_t::iterator i;
   for (i = result->begin (); i != result->end (); ++i)
     {
       string* filename = i->first;
-      string* content = i->second;
+      string* content = i->second.contents;
+
+      if (AnT::isStoringCompressed)
+	{
+	  // append a gzip member to the compressed file
+	  ofstream* file = getFile (*filename + ".gz");
+
+	  if (i->second.isGzipped)
+	    {
+	      (*file) << *content;
+	    }
+	  else
+	    {
+	      string gzipContent;
+	      gzipString (*content, gzipContent);
+	      (*file) << gzipContent;
+	    }
+	}
+      else
+	{
+	  // get the file and write the content
+	  ofstream* file = getFile (*filename);
 
-      // get the file and write the content
-      ofstream* file = getFile (*filename);
-      (*file) << *content;
+	  if (i->second.isGzipped)
+	    {
+	      if (! gunzipToStream (*content, *file))
+		{
+		  cout << "ERROR: corrupt compressed result for the file '"
+		       << *filename << "'!" << endl;
+		}
+	    }
+	  else
+	    {
+	      (*file) << *content;
+	    }
+	}
 
       delete i->first;
-      delete i->second;
+      delete i->second.contents;
     }
   delete result;
 }
 
+const double ScanPointManagement::LEASE_FACTOR = 3.0;
+const double ScanPointManagement::MIN_LEASE_TIME = 10.0;
+
+double ScanPointManagement::getTime ()
+{
+  struct timeval now;
+  gettimeofday (&now, NULL);
+
+  return now.tv_sec + 1e-6 * now.tv_usec;
+}
+
 ScanPointManagement::ScanPointManagement ()
 {
   seqNr = 0;
   lastSavedSeqNr = -1;    
   numScanPointsDone = 0; 
   inProgressQueuePrediction = inProgressQueue.begin ();
+  sumTimePerPoint = 0.0;
+  numTimedScanPoints = 0;
+  numReissuedScanPoints = 0;
 }
 
 ScanPointManagement::~ScanPointManagement () 
@@ -127,7 +174,7 @@ long ScanPointManagement::addScanPoint (string* scanPoint)
 }
   
 void ScanPointManagement::scanPointDone (long clientSeqNr, 
-					 map<string*, string*>* result)
+					 result_t* result)
 {
   // check if we already have a result for this scanpoint
   if ((unsavedResults.find(clientSeqNr) != unsavedResults.end()) ||
@@ -140,17 +187,17 @@ void ScanPointManagement::scanPointDone (long clientSeqNr,
 
   // seek the scanpoint in scanPointsInProgress
   list<long>::iterator i = inProgressQueuePrediction;
-  if ((*i != clientSeqNr) || (i == inProgressQueue.end ()))
+  if ((i == inProgressQueue.end ()) || (*i != clientSeqNr))
     { 
       i = inProgressQueue.begin ();
-      while ((*i != clientSeqNr) && (i != inProgressQueue.end ()))
+      while ((i != inProgressQueue.end ()) && (*i != clientSeqNr))
 	{
 	  ++i;
 	}
     }
 
   // remove the scanpoint from scanPointsInProgress and inProgressQueue
-  if (*i == clientSeqNr)
+  if (i != inProgressQueue.end ())
     {
       inProgressQueuePrediction = i;
       inProgressQueuePrediction++;
@@ -160,6 +207,16 @@ void ScanPointManagement::scanPointDone (long clientSeqNr,
       delete j->second;
       scanPointsInProgress.erase (j);
       inProgressQueue.erase (i);
+
+      // measure the time per scanpoint of the chunk
+      map<long, Lease>::iterator k = leases.find (clientSeqNr);
+      if (k != leases.end ())
+	{
+	  sumTimePerPoint
+	    += (getTime () - k->second.issueTime) / k->second.chunkSize;
+	  numTimedScanPoints++;
+	  leases.erase (k);
+	}
     }
   else
     {
@@ -175,7 +232,7 @@ void ScanPointManagement::scanPointDone (long clientSeqNr,
       lastSavedSeqNr++;
       saveResult (result);
 
-      map<long, map<string*, string*>*>::iterator i;
+      map<long, result_t*>::iterator i;
 
       // save all continuous results
       while ((i = unsavedResults.find(lastSavedSeqNr + 1))
@@ -233,3 +290,67 @@ long ScanPointManagement::getNumScanPointsDone ()
 {
   return numScanPointsDone;
 }
+
+double ScanPointManagement::getLeaseDuration (const Lease& aLease) const
+{
+  double timePerPoint = aLease.timePerPoint;
+
+  if (timePerPoint <= 0.0)
+    {
+      if (numTimedScanPoints == 0)
+	{
+	  // nothing known: the lease does not expire
+	  return -1.0;
+	}
+
+      timePerPoint = sumTimePerPoint / numTimedScanPoints;
+    }
+
+  return LEASE_FACTOR * aLease.chunkSize * timePerPoint + MIN_LEASE_TIME;
+}
+
+void ScanPointManagement::lease (long seqNr, 
+				 long chunkSize, 
+				 double clientSpeed)
+{
+  Lease& aLease = leases[seqNr];
+
+  aLease.issueTime = getTime ();
+  aLease.chunkSize = chunkSize;
+  aLease.timePerPoint = (clientSpeed > 0.0) ? (1.0 / clientSpeed) : 0.0;
+}
+
+long ScanPointManagement::getExpiredScanPoints 
+(map<long, string*>& chunk, unsigned long chunkSize)
+{
+  double now = getTime ();
+  long numAdded = 0;
+
+  // the oldest scanpoints first
+  map<long, Lease>::iterator i;
+  for ( i = leases.begin (); 
+	(i != leases.end ()) && (chunk.size () < chunkSize); 
+	++i )
+    {
+      if (chunk.find (i->first) != chunk.end ())
+	{
+	  continue;
+	}
+
+      double duration = getLeaseDuration (i->second);
+      if ((duration >= 0.0) && (now > i->second.issueTime + duration))
+	{
+	  // the client is dead or stalled, hand out the scanpoint again
+	  numReissuedScanPoints++;
+	  chunk[i->first] = scanPointsInProgress[i->first];
+	  numAdded++;
+	}
+    }
+
+  return numAdded;
+}
+
+long ScanPointManagement::getNumReissuedScanPoints ()
+{
+  return numReissuedScanPoints;
+}
@@ -39,18 +39,77 @@ using std::ofstream;
 #include <iostream>
 #include "../utils/config/Configuration.hpp"
 
+/**
+ * contents of an output file of a scanpoint, as received from the
+ * client: the text itself or a gzip member of it (see
+ * 'Compression.hpp')
+ */
+struct ResultFile
+{
+  string* contents;
+  bool isGzipped;
+};
+
+/**
+ * the output files of a scanpoint: file name, contents
+ */
+typedef map<string*, ResultFile> result_t;
+
 /**
  * Manages the scanpoints on the AnT server. New scanpoints are registered 
  * using addScanPoint(). Results can be reported by scanPointDone() when a 
  * client has finished the scanpoint. 
+ *
+ * Each chunk of scanpoints handed out to a client gets a lease
+ * (see 'lease'). The lease expires after
+ * \f$ LEASE\_FACTOR \cdot n \cdot t + MIN\_LEASE\_TIME \f$ seconds, where
+ * n is the size of the chunk and t the time per scanpoint, measured
+ * by the client or, if not known yet, the mean time per scanpoint of
+ * all results returned so far. The scanpoints of expired leases
+ * (dead or stalled clients) are handed out again at once, see
+ * 'getExpiredScanPoints'.
  */
 class ScanPointManagement
 {
 private:
+  /**
+   * the newest lease of a scanpoint in progress
+   */
+  struct Lease
+  {
+    /** time of handing out the chunk (seconds) */
+    double issueTime;
+
+    /** number of scanpoints in the chunk */
+    long chunkSize;
+
+    /** time per scanpoint reported by the client, 0 if not known */
+    double timePerPoint;
+  };
+
   list<long> inProgressQueue;
   list<long>::iterator inProgressQueuePrediction;
   map<long, string*> scanPointsInProgress;
-  map<long, map<string*, string*>*> unsavedResults;
+  map<long, result_t*> unsavedResults;
+
+  map<long, Lease> leases;
+
+  /**
+   * time per scanpoint measured on the server (from handing out to
+   * the result), summed over all results
+   */
+  double sumTimePerPoint;
+  long numTimedScanPoints;
+
+  long numReissuedScanPoints;
+
+  static double getTime ();
+
+  /**
+   * @return the duration of the lease in seconds, or a negative
+   * value, if no time per scanpoint is known yet
+   */
+  double getLeaseDuration (const Lease& aLease) const;
 
   // map of all the already opened files  
   map<string, ofstream*> openFiles;
@@ -61,9 +120,27 @@ private:
 
   ofstream* getFile (const string& filename);
 
-  void saveResult (map<string*, string*>* result);
+  /**
+   * Writes the result to the output files. The gzipped contents are
+   * decompressed chunk by chunk into the files or, if the results are
+   * stored compressed (option '--store-compressed'), appended to the
+   * files '<file>.gz' without decompression.
+   */
+  void saveResult (result_t* result);
 
 public:
+  /**
+   * safety factor of the lease duration with respect to the expected
+   * calculation time of the chunk
+   */
+  static const double LEASE_FACTOR;
+
+  /**
+   * additional time of each lease (seconds), covering the
+   * communication and the initialization of a client
+   */
+  static const double MIN_LEASE_TIME;
+
   ScanPointManagement ();
 
   ~ScanPointManagement ();
@@ -87,7 +164,7 @@ public:
    *                    by addScanPoint
    * @param result the result for the scanpoint
    */
-  void scanPointDone (long clientSeqNr, map<string*, string*>* result);
+  void scanPointDone (long clientSeqNr, result_t* result);
 
   /**
    * Returns the oldest scanpoint that is still "in progress". If there 
@@ -99,6 +176,35 @@ public:
    */
   long reassignScanpoint (string** scanPoint);
 
+  /**
+   * Give the scanpoint a new lease: it was handed out (again) in a
+   * chunk of the given size to a client with the given speed.
+   *
+   * @param seqNr the sequence number of the scanpoint
+   * @param chunkSize the number of scanpoints handed out together
+   * @param clientSpeed scanpoints per second measured by the client,
+   *                    0 if not known
+   */
+  void lease (long seqNr, long chunkSize, double clientSpeed);
+
+  /**
+   * Adds the oldest scanpoints "in progress", whose leases have
+   * expired, to the given chunk, until it contains 'chunkSize'
+   * scanpoints. All leases are checked in a single pass.
+   *
+   * @param chunk the scanpoints handed out in the current chunk
+   * @param chunkSize the maximal number of scanpoints in the chunk
+   * @return the number of scanpoints added to the chunk
+   */
+  long getExpiredScanPoints (map<long, string*>& chunk, 
+			     unsigned long chunkSize);
+
+  /**
+   * Returns the number of scanpoints handed out again due to an
+   * expired lease.
+   */
+  long getNumReissuedScanPoints ();
+
   /**
    * Returns the number of scanpoints that were already calculated.
    *
@@ -28,7 +28,8 @@
 
 AbstractDDE_Proxy::AbstractDDE_Proxy () : 
     currentState (NULL),
-    delayState (NULL)
+    delayState (NULL),
+    delayHistory (NULL)
   {}
 
 // virtual 
@@ -51,3 +52,6 @@ void AbstractDDE_Proxy::setCurrentState (Array<real_t> * s)
 
 void AbstractDDE_Proxy::setDelayState (Array<real_t> * s)
   { delayState = s; }
+
+void AbstractDDE_Proxy::setDelayHistory (const DelayHistory * h)
+  { delayHistory = h; }
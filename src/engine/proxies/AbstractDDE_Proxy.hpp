@@ -29,6 +29,7 @@
 
 #include "SystemFunctionProxy.hpp"
 #include "../utils/arrays/Array.hpp"
+#include "data/DelayHistory.hpp"
 
 /**
  * Common interface for all types of DDEs (delay differential equations).
@@ -50,6 +51,13 @@ protected:
    */
   const Array<real_t> * delayState;
 
+  /**
+   * dense-output history, set only by integrators supporting it
+   * (NULL otherwise)
+   * @see DDE_DenseRK44
+   */
+  const DelayHistory * delayHistory;
+
 public:
 
     /**
@@ -88,6 +96,12 @@ public:
      */
   void setDelayState (Array<real_t> * s);
 
+    /**
+     * set the private variable 'delayHistory' for usage within
+     * 'callSystemFunction' without arguments
+     */
+  void setDelayHistory (const DelayHistory * h);
+
 }; /*: class 'AbstractODE_Proxy' */
 
 #endif
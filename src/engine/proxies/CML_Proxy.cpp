@@ -52,14 +52,105 @@ CML_Proxy::DummySymbolicFunction;
 CML_Proxy::GlobalSymbolicFunction* 
 CML_Proxy::globalSymbolicFunction = NULL;
 
+CML_Proxy::LatticeSystemFunction* 
+CML_Proxy::latticeSystemFunction = NULL;
+
+int CML_Proxy::latticeHalo = 1;
+
 CML_LinearizedProxy::SystemFunction* 
 CML_LinearizedProxy::systemFunction = 
 CML_LinearizedProxy::DummySystemFunction;
 
 
+/**
+ * cell-wise update of a range of cells of a CML.
+ * @see LatticeThreadPool
+ */
+class CML_CellJob
+  : public LatticeThreadPool::Job
+{
+private:
+  const CellularState& currentState;
+  const Array<real_t>& parameters;
+  const CellularState& rhsState;
+
+public:
+  CML_CellJob ( const CellularState& aCurrentState,
+		const Array<real_t>& aParameters,
+		const CellularState& aRHS_State )
+    : currentState (aCurrentState),
+      parameters (aParameters),
+      rhsState (aRHS_State)
+  {}
+
+  virtual bool execute (int beginCell, int endCell)
+  {
+    for (int i = beginCell; i < endCell; ++i)
+      {
+	StateCell cell = rhsState[i];
+	bool ok = (*CML_Proxy::systemFunction) (currentState, 
+						parameters,
+						i, 
+						cell);
+	if (! ok) return false;
+      }
+    return true;
+  }
+};
+
+
 CML_Proxy::CML_Proxy ()
+  : latticeState (NULL),
+    latticeRHS (NULL),
+    threadPool (NULL)
 {}
 
+// virtual
+CML_Proxy::~CML_Proxy ()
+{
+  delete latticeState;
+  delete latticeRHS;
+  delete threadPool;
+}
+
+void 
+CML_Proxy::setNumberOfThreads (int numberOfThreads)
+{
+  delete threadPool;
+  threadPool = NULL;
+
+  if (numberOfThreads > 1)
+    threadPool = new LatticeThreadPool (numberOfThreads);
+}
+
+bool 
+CML_Proxy::callLatticeSystemFunction ( const Array<real_t>& state,
+				       int cellDim,
+				       const Array<real_t>& parameters )
+{
+  if (latticeState == NULL)
+    {
+      int numberOfCells = state.getTotalSize () / cellDim;
+
+      latticeState = new LatticeState (numberOfCells, cellDim, latticeHalo);
+      latticeRHS = new LatticeState (numberOfCells, cellDim, 0);
+    }
+
+  BoundaryPolicyEnum policy = defaultBoundaryPolicy;
+  if (policy == INVALID)
+    policy = CYCLIC;
+
+  latticeState->scatter (state);
+  latticeState->fillHalo (policy, policy);
+
+  bool ok = (*latticeSystemFunction) (*latticeState,
+				      parameters,
+				      *latticeRHS);
+  latticeRHS->gather (*RHS);
+
+  return ok;
+}
+
 
 // virtual 
 bool 
@@ -84,6 +175,12 @@ CML_Proxy::callSystemFunction (DynSysData& dynSysData)
 			      data.cellDim);
   CellularState rhsState (RHS, data.cellDim);
 
+  if (latticeSystemFunction != NULL) {
+    return callLatticeSystemFunction (data.orbit[0],
+				      data.cellDim,
+				      data.parameters.getValues ());
+  }
+
   if (globalSystemFunction != NULL) {
     ok = (*globalSystemFunction) (currentState, 
 				  data.parameters.getValues (),
@@ -93,16 +190,14 @@ CML_Proxy::callSystemFunction (DynSysData& dynSysData)
   else { /*: if the system function was not set by the user, then
 	   'dummySystemFunction' will be called, yielding an error
 	   message */
-    for (int i = 0; i < rhsState.numberOfCells; ++i)
-      {
-	StateCell cell = rhsState[i];
-	ok = (*systemFunction) (currentState, 
-				data.parameters.getValues (),
-				i, 
-				cell);
-	if (! ok) return false;
-      }
-    return true;
+    CML_CellJob job (currentState,
+		     data.parameters.getValues (),
+		     rhsState);
+
+    if (threadPool != NULL)
+      return threadPool->run (job, 0, rhsState.numberOfCells);
+    else
+      return job.execute (0, rhsState.numberOfCells);
   }
 
   return false;
@@ -30,6 +30,8 @@
 #include "AbstractMapProxy.hpp"
 #include "data/CellularState.hpp"
 #include "data/DynSysData.hpp"
+#include "data/LatticeState.hpp"
+#include "LatticeThreadPool.hpp"
 #include "utils/GlobalConstants.hpp"
 
 
@@ -45,6 +47,24 @@ protected:
    */
   const Array<real_t> * currentState;
 
+  /**
+   * structure-of-arrays copies of the current state and of the
+   * right hand side, used if 'latticeSystemFunction' is set.
+   * Allocated at the first call.
+   */
+  LatticeState* latticeState;
+  LatticeState* latticeRHS;
+
+  bool callLatticeSystemFunction ( const Array<real_t>& state,
+				   int cellDim,
+				   const Array<real_t>& parameters );
+
+  /**
+   * pool for the parallel cell-wise update, NULL for the serial one.
+   * @see setNumberOfThreads
+   */
+  LatticeThreadPool* threadPool;
+
 public:
   typedef 
   bool SystemFunction (const CellularState& currentState,
@@ -77,8 +97,42 @@ public:
 
   static GlobalSymbolicFunction* globalSymbolicFunction;
 
+  /**
+   * System function working on the whole lattice at once. The
+   * components of all cells are stored contiguously (see
+   * LatticeState) and the halo cells of 'currentState' are already
+   * set according to 'defaultBoundaryPolicy' (CYCLIC, if no policy
+   * is set), so that the function can be written as simple loops
+   * over the cells, which the compiler is able to vectorize:
+   *
+   * for (int j = 0; j < N; ++j)
+   *   rhs[0][j] = ... x[0][j-1] ... x[0][j] ... x[0][j+1] ...;
+   *
+   * If set, it is used instead of 'globalSystemFunction' and
+   * 'systemFunction'.
+   */
+  typedef
+  bool LatticeSystemFunction (const LatticeState& currentState,
+			      const Array<real_t>& parameters,
+			      LatticeState& rhs);
+
+  static LatticeSystemFunction* latticeSystemFunction;
+
+  /** number of halo cells on each side, needed by the stencil of
+      'latticeSystemFunction' (default: 1) */
+  static int latticeHalo;
+
   CML_Proxy ();
 
+  virtual ~CML_Proxy ();
+
+  /**
+   * Use the given number of threads for the update of the cells
+   * with 'systemFunction' (see LatticeThreadPool). The global and
+   * lattice system functions are always called once per step.
+   */
+  void setNumberOfThreads (int numberOfThreads);
+
   /**
    * @todo
    */
@@ -49,50 +49,99 @@ CODEL_Proxy::LinearizedSystemFunction*
 CODEL_Proxy::linearizedSystemFunction = 
 CODEL_Proxy::DummyLinearizedSystemFunction;
 
+/**
+ * cell-wise update of a range of cells of a CODEL.
+ * @see LatticeThreadPool
+ */
+class CODEL_CellJob
+  : public LatticeThreadPool::Job
+{
+private:
+  const CellularState& currentState;
+  const Array<real_t>& parameters;
+  const CellularState& rhsState;
+
+public:
+  CODEL_CellJob ( const CellularState& aCurrentState,
+		  const Array<real_t>& aParameters,
+		  const CellularState& aRHS_State )
+    : currentState (aCurrentState),
+      parameters (aParameters),
+      rhsState (aRHS_State)
+  {}
+
+  virtual bool execute (int beginCell, int endCell)
+  {
+    for (int i = beginCell; i < endCell; ++i)
+      {
+	bool ok = (*CODEL_Proxy::systemFunction) (currentState, 
+						  parameters,
+						  i, 
+						  rhsState[i]);
+	if (! ok) return false;
+      }
+    return true;
+  }
+};
+
+
 CODEL_Proxy::CODEL_Proxy (int aCellDim, int aNumberOfCells) :
   numberOfCells (aNumberOfCells),
-  cellDim (aCellDim)
+  cellDim (aCellDim),
+  threadPool (NULL)
 {}
 
+// virtual
+CODEL_Proxy::~CODEL_Proxy ()
+{
+  delete threadPool;
+}
+
+void 
+CODEL_Proxy::setNumberOfThreads (int numberOfThreads)
+{
+  delete threadPool;
+  threadPool = NULL;
+
+  if (numberOfThreads > 1)
+    threadPool = new LatticeThreadPool (numberOfThreads);
+}
+
+bool 
+CODEL_Proxy::callCellwise ( const CellularState& currentState,
+			    const Array<real_t>& parameters,
+			    const CellularState& rhsState )
+{
+  CODEL_CellJob job (currentState, parameters, rhsState);
+
+  if (threadPool != NULL)
+    return threadPool->run (job, 0, rhsState.numberOfCells);
+  else
+    return job.execute (0, rhsState.numberOfCells);
+}
+
 // virtual 
 bool CODEL_Proxy::callSystemFunction ()
 {
-  bool ok;
   CellularState currentCellularState ((Array<double>*) currentState, 
 				      cellDim);
   CellularState rhsState (RHS, cellDim);
 
-  for (int i = 0; i < rhsState.numberOfCells; ++i)
-    {
-      ok = (*systemFunction) (currentCellularState, 
-			      *parameters,
-			      i, 
-			      rhsState[i]);
-      if (! ok) return false;
-    }
-  return true;
+  return callCellwise (currentCellularState, *parameters, rhsState);
 }
 
 // virtual
 bool CODEL_Proxy::callSystemFunction (DynSysData& d)
 {
-  bool ok;
   CODEL_Data& data = DOWN_CAST <CODEL_Data&> (d);
 	    
   CellularState currentState (&(data.orbit[0]), 
 			      data.cellDim);
   CellularState rhsState (RHS, data.cellDim);
 
-  for (int i = 0; i < rhsState.numberOfCells; ++i)
-    {
-      ok = (*systemFunction) (currentState, 
-			      data.parameters.getValues (),
-			      i, 
-			      rhsState[i]);
-      if (! ok) return false;
-    }
-  return true;
-
+  return callCellwise (currentState,
+		       data.parameters.getValues (),
+		       rhsState);
 }
 
 // virtual
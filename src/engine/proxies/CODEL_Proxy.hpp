@@ -30,6 +30,7 @@
 #include "AbstractODE_Proxy.hpp"
 #include "data/DynSysData.hpp"
 #include "utils/GlobalConstants.hpp"
+#include "LatticeThreadPool.hpp"
 
 /* *********************************************************
 * CODEL_Proxy
@@ -41,6 +42,16 @@ protected:
   int numberOfCells;
   int cellDim;
 
+  /**
+   * pool for the parallel cell-wise update, NULL for the serial one.
+   * @see setNumberOfThreads
+   */
+  LatticeThreadPool* threadPool;
+
+  bool callCellwise ( const CellularState& currentState,
+		      const Array<real_t>& parameters,
+		      const CellularState& rhsState );
+
 public:
   typedef bool SystemFunction 
   ( const CellularState& currentState,
@@ -74,6 +85,14 @@ public:
    */
   CODEL_Proxy (int aCellDim, int aNumberOfCells);
 
+  virtual ~CODEL_Proxy ();
+
+  /**
+   * Use the given number of threads for the update of the cells
+   * (see LatticeThreadPool).
+   */
+  void setNumberOfThreads (int numberOfThreads);
+
   /**
    * will be called by ODE integrators for calculation of the
    * next state.
@@ -41,10 +41,26 @@ DDE_Proxy::systemFunction = DDE_Proxy::DummySystemFunction;
 DDE_Proxy::SymbolicFunction* 
 DDE_Proxy::symbolicFunction = DDE_Proxy::DummySymbolicFunction;
 
+DDE_Proxy::HistorySystemFunction* 
+DDE_Proxy::historySystemFunction = NULL;
+
 
 // virtual 
 bool DDE_Proxy::callSystemFunction ()
 {
+  if (historySystemFunction != NULL)
+    {
+      if (delayHistory == NULL)
+	cerr << "DDE_Proxy: the system function with history access "
+	     << "needs an integration method with dense output."
+	     << endl << Error::Exit;
+
+      return (*historySystemFunction) ( *currentState,
+					*delayHistory,
+					*parameters,
+					*RHS );
+    }
+
   return (*systemFunction) ( *currentState,
 			     *delayState,
 			     *parameters,
@@ -57,6 +73,20 @@ bool DDE_Proxy::callSystemFunction (DynSysData& d)
   // we need 'tauIndex', hence we must cast to 'DDE_Data'. 
   DDE_Data& data = DOWN_CAST <DDE_Data&> (d);
 
+  if (historySystemFunction != NULL)
+    {
+      if (delayHistory == NULL)
+	cerr << "DDE_Proxy: the system function with history access "
+	     << "needs an integration method with dense output."
+	     << endl << Error::Exit;
+
+      // the history is evaluated relative to the last step:
+      return (*historySystemFunction) ( data.orbit[0],
+					*delayHistory,
+					data.parameters.getValues (), 
+					*RHS );
+    }
+
   return (*systemFunction) ( data.orbit[0],
 			     data.orbit[data.tauIndex],
 			     data.parameters.getValues (), 
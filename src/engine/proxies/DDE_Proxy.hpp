@@ -50,8 +50,23 @@ class DDE_Proxy
      const Array<real_t>& parameters,
      string& symbolicRHS);
 
+  /**
+   * System function with access to the whole (dense-output) history,
+   * needed for multiple or state-dependent delays:
+   * 'history.getState (tau, y)' yields \f$\vec y(t-\tau)\f$ for
+   * \f$0 \le \tau \le\f$ 'maximal_delay'. If set, it is used
+   * instead of 'systemFunction'. Requires an integrator with dense
+   * output.
+   */
+  typedef bool HistorySystemFunction 
+    (const Array<real_t>& currentState,
+     const DelayHistory& history,
+     const Array<real_t>& parameters,
+     Array<real_t>& RHS);
+
   static SystemFunction* systemFunction;
   static SymbolicFunction* symbolicFunction;
+  static HistorySystemFunction* historySystemFunction;
 
  public:
   virtual bool callSystemFunction ();
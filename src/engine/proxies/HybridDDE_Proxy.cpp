@@ -50,6 +50,11 @@ HybridDDE_Proxy::symbolicFunction = HybridDDE_Proxy::DummySymbolicFunction;
 HybridDDE_Proxy::HybridFunction* 
 HybridDDE_Proxy::hybridFunction = HybridDDE_Proxy::DummyHybridFunction;
 
+HybridDDE_Proxy::EventFunction* 
+HybridDDE_Proxy::eventFunction = NULL;
+
+int HybridDDE_Proxy::numberOfEventFunctions = 0;
+
 
 // virtual 
 bool HybridDDE_Proxy::callSystemFunction ()
@@ -103,6 +108,23 @@ bool HybridDDE_Proxy::callHybridFunction (DynSysData& data)
 			    *(AbstractHybridFunctionProxy::RHS));
 }
 
+// static
+bool HybridDDE_Proxy::hasEventFunction ()
+{
+  return (eventFunction != NULL) && (numberOfEventFunctions > 0);
+}
+
+bool HybridDDE_Proxy::callEventFunction (const Array<real_t>& continuousState,
+					 const Array<real_t>& delayState,
+					 Array<real_t>& eventValues)
+{
+  return (*eventFunction) (continuousState,
+			   *discreteState,
+			   delayState,
+			   *parameters, 
+			   eventValues);
+}
+
 // static
 bool HybridDDE_Proxy::DummySystemFunction 
 ( const Array<real_t>& currentContinuousState,
@@ -61,10 +61,23 @@ class HybridDDE_Proxy : public AbstractDDE_Proxy,
       const Array<real_t>& delayState, 
       const Array<real_t>& parameters,
       Array<integer_t>& hybridRHS);
+
+  /**
+   * optional switching surfaces of the system, see
+   * 'HybridODE_Proxy::EventFunction'.
+   */
+  typedef bool EventFunction 
+    ( const Array<real_t>& currentContinuousState,
+      const Array<integer_t>& currentDiscreteState,
+      const Array<real_t>& delayState, 
+      const Array<real_t>& parameters,
+      Array<real_t>& eventValues);
   
   static SystemFunction* systemFunction;
   static SymbolicFunction* symbolicFunction;
   static HybridFunction* hybridFunction;
+  static EventFunction* eventFunction;
+  static int numberOfEventFunctions;
 
   HybridDDE_Proxy ();
 
@@ -77,6 +90,17 @@ class HybridDDE_Proxy : public AbstractDDE_Proxy,
 
   virtual bool callHybridFunction (DynSysData& data);
 
+  static bool hasEventFunction ();
+
+  /**
+   * evaluates the event functions at the given continuous and delay
+   * states, using the current discrete state and parameters of the
+   * proxy.
+   */
+  bool callEventFunction (const Array<real_t>& continuousState,
+			  const Array<real_t>& delayState,
+			  Array<real_t>& eventValues);
+
   static bool DummySystemFunction 
     ( const Array<real_t>& currentContinuousState,
       const Array<integer_t>& currentDiscreteState,
@@ -59,6 +59,11 @@ HybridODE_Proxy::HybridFunction*
 HybridODE_Proxy::hybridFunction = 
 HybridODE_Proxy::DummyHybridFunction;
 
+HybridODE_Proxy::EventFunction* 
+HybridODE_Proxy::eventFunction = NULL;
+
+int HybridODE_Proxy::numberOfEventFunctions = 0;
+
 
 // virtual 
 bool HybridODE_Proxy::callSystemFunction ()
@@ -110,6 +115,21 @@ bool HybridODE_Proxy::callHybridFunction (DynSysData& data)
 			    *(AbstractHybridFunctionProxy::RHS));
 }
 
+// static
+bool HybridODE_Proxy::hasEventFunction ()
+{
+  return (eventFunction != NULL) && (numberOfEventFunctions > 0);
+}
+
+bool HybridODE_Proxy::callEventFunction (const Array<real_t>& continuousState,
+					 Array<real_t>& eventValues)
+{
+  return (*eventFunction) (continuousState, 
+			   *discreteState,
+			   *parameters, 
+			   eventValues);
+}
+
 // static
 bool 
 HybridODE_Proxy::
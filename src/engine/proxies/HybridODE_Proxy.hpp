@@ -57,10 +57,27 @@ class HybridODE_Proxy : public AbstractODE_Proxy,
 		  const Array<integer_t>& currentDiscreteState, 
 		  const Array<real_t>& parameters,
 		  Array<integer_t>& hybridRHS);
+
+  /**
+   * optional switching surfaces of the system: a sign change of any
+   * of the 'numberOfEventFunctions' event values within an
+   * integration step is located inside the step and the hybrid
+   * function is applied at the located point (and only there). If no
+   * event function is set (default), the discrete state is updated
+   * at the step boundaries only.
+   */
+  typedef 
+  bool 
+  EventFunction (const Array<real_t>& currentContinuousState,
+		 const Array<integer_t>& currentDiscreteState, 
+		 const Array<real_t>& parameters,
+		 Array<real_t>& eventValues);
   
   static SystemFunction* systemFunction;
   static SymbolicFunction* symbolicFunction;
   static HybridFunction* hybridFunction;
+  static EventFunction* eventFunction;
+  static int numberOfEventFunctions;
 
   HybridODE_Proxy ();
 
@@ -73,6 +90,15 @@ class HybridODE_Proxy : public AbstractODE_Proxy,
 
   virtual bool callHybridFunction (DynSysData& data);
 
+  static bool hasEventFunction ();
+
+  /**
+   * evaluates the event functions at the given continuous state,
+   * using the current discrete state and parameters of the proxy.
+   */
+  bool callEventFunction (const Array<real_t>& continuousState,
+			  Array<real_t>& eventValues);
+
 private:
   static bool 
   DummySystemFunction (const Array<real_t>& currentContinuousState,
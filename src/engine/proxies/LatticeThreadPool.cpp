@@ -0,0 +1,212 @@
+/* 
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ * 
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ * 
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#include "LatticeThreadPool.hpp"
+#include "../utils/debug/Error.hpp"
+
+LatticeThreadPool::
+LatticeThreadPool (int aNumberOfThreads)
+  : numberOfThreads (aNumberOfThreads)
+{
+  if (numberOfThreads < 1)
+    cerr << "LatticeThreadPool: the number of threads ("
+	 << numberOfThreads << ") must be positive."
+	 << endl << Error::Exit;
+
+#if ANT_HAS_LATTICE_THREADS
+  generation = 0;
+  pendingWorkers = 0;
+  shutdown = false;
+  job = NULL;
+  beginCell = 0;
+  endCell = 0;
+  jobResult = true;
+
+  pthread_mutex_init (&mutex, NULL);
+  pthread_cond_init (&startCondition, NULL);
+  pthread_cond_init (&doneCondition, NULL);
+
+  // worker 0 is the calling thread:
+  workers.alloc (numberOfThreads);
+
+  for (int i = 1; i < numberOfThreads; ++i)
+    {
+      workers[i].pool = this;
+      workers[i].index = i;
+
+      if (pthread_create (&(workers[i].thread),
+			  NULL,
+			  workerMain,
+			  &(workers[i])) != 0)
+	cerr << "LatticeThreadPool: creation of the thread "
+	     << i << " failed."
+	     << endl << Error::Exit;
+    }
+#else
+  if (numberOfThreads > 1)
+    {
+      cerr << "LatticeThreadPool: threads are not supported on this "
+	   << "platform, the lattice will be updated serially."
+	   << endl;
+      numberOfThreads = 1;
+    }
+#endif
+}
+
+LatticeThreadPool::
+~LatticeThreadPool ()
+{
+#if ANT_HAS_LATTICE_THREADS
+  pthread_mutex_lock (&mutex);
+  shutdown = true;
+  pthread_cond_broadcast (&startCondition);
+  pthread_mutex_unlock (&mutex);
+
+  for (int i = 1; i < numberOfThreads; ++i)
+    pthread_join (workers[i].thread, NULL);
+
+  pthread_cond_destroy (&doneCondition);
+  pthread_cond_destroy (&startCondition);
+  pthread_mutex_destroy (&mutex);
+#endif
+}
+
+int
+LatticeThreadPool::
+getNumberOfThreads () const
+{
+  return numberOfThreads;
+}
+
+void
+LatticeThreadPool::
+getBlock (int index, int& blockBegin, int& blockEnd) const
+{
+  int n = endCell - beginCell;
+
+  blockBegin = beginCell + (index * n) / numberOfThreads;
+  blockEnd = beginCell + ((index + 1) * n) / numberOfThreads;
+}
+
+#if ANT_HAS_LATTICE_THREADS
+// static
+void*
+LatticeThreadPool::
+workerMain (void* arg)
+{
+  Worker* worker = static_cast<Worker*> (arg);
+
+  worker->pool->workerLoop (worker->index);
+
+  return NULL;
+}
+
+void
+LatticeThreadPool::
+workerLoop (int index)
+{
+  long lastGeneration = 0;
+
+  while (true)
+    {
+      pthread_mutex_lock (&mutex);
+
+      while ((generation == lastGeneration) && (! shutdown))
+	pthread_cond_wait (&startCondition, &mutex);
+
+      if (shutdown)
+	{
+	  pthread_mutex_unlock (&mutex);
+	  return;
+	}
+
+      lastGeneration = generation;
+      int blockBegin, blockEnd;
+      getBlock (index, blockBegin, blockEnd);
+      Job* currentJob = job;
+
+      pthread_mutex_unlock (&mutex);
+
+      bool ok = true;
+      if (blockBegin < blockEnd)
+	ok = currentJob->execute (blockBegin, blockEnd);
+
+      pthread_mutex_lock (&mutex);
+
+      if (! ok)
+	jobResult = false;
+
+      --pendingWorkers;
+      if (pendingWorkers == 0)
+	pthread_cond_signal (&doneCondition);
+
+      pthread_mutex_unlock (&mutex);
+    }
+}
+#endif
+
+bool
+LatticeThreadPool::
+run (Job& aJob, int aBeginCell, int anEndCell)
+{
+  if (numberOfThreads == 1)
+    return aJob.execute (aBeginCell, anEndCell);
+
+#if ANT_HAS_LATTICE_THREADS
+  pthread_mutex_lock (&mutex);
+
+  job = &aJob;
+  beginCell = aBeginCell;
+  endCell = anEndCell;
+  jobResult = true;
+  pendingWorkers = numberOfThreads - 1;
+  ++generation;
+
+  int blockBegin, blockEnd;
+  getBlock (0, blockBegin, blockEnd);
+
+  pthread_cond_broadcast (&startCondition);
+  pthread_mutex_unlock (&mutex);
+
+  bool ok = true;
+  if (blockBegin < blockEnd)
+    ok = aJob.execute (blockBegin, blockEnd);
+
+  pthread_mutex_lock (&mutex);
+
+  while (pendingWorkers > 0)
+    pthread_cond_wait (&doneCondition, &mutex);
+
+  ok = ok && jobResult;
+  job = NULL;
+
+  pthread_mutex_unlock (&mutex);
+
+  return ok;
+#else
+  return false; // not reached
+#endif
+}
@@ -0,0 +1,138 @@
+/* 
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ * 
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ * 
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#ifndef LATTICE_THREAD_POOL_HPP
+#define LATTICE_THREAD_POOL_HPP
+
+#include "config.h"
+
+#if ! (ANT_HAS_WIN_ENV && (! defined __CYGWIN__))
+#define ANT_HAS_LATTICE_THREADS 1
+#include <pthread.h>
+#endif
+
+#include "utils/GlobalConstants.hpp"
+#include "../utils/arrays/Array.hpp"
+
+/**
+ * Persistent pool of worker threads for the intra-step parallel
+ * update of spatially extended systems (CML, CODEL, PDE).
+ *
+ * The lattice is decomposed into contiguous blocks of cells, one
+ * block per thread; the calling thread handles the first block
+ * itself. Since the partition depends only on the number of cells
+ * and threads, and each cell is computed by the same code from the
+ * same (read-only) current state, the result is bit-identical to
+ * the serial update. The neighbouring cells needed by the coupling
+ * are read directly from the shared current state, hence no explicit
+ * halo exchange is necessary.
+ *
+ * The threads are created once and wait between the steps, so that
+ * the overhead of a step is one wake-up and one barrier.
+ *
+ * The pool is also used for the box mapping of symbolic images, where
+ * each "cell" of the pool stands for the private data of one thread.
+ *
+ * @note the system functions are called concurrently for different
+ * cells, hence they must not modify any global data.
+ */
+class LatticeThreadPool
+{
+public:
+  /**
+   * Work to be done for a contiguous range of cells.
+   */
+  class Job
+  {
+  public:
+    /**
+     * process the cells 'beginCell' <= i < 'endCell'.
+     * @return false, if the system function failed.
+     */
+    virtual bool execute (int beginCell, int endCell) = 0;
+
+    virtual ~Job () {}
+  };
+
+private:
+  int numberOfThreads;
+
+#if ANT_HAS_LATTICE_THREADS
+  struct Worker
+  {
+    LatticeThreadPool* pool;
+    int index;
+    pthread_t thread;
+  };
+
+  Array<Worker> workers;
+
+  pthread_mutex_t mutex;
+  pthread_cond_t startCondition;
+  pthread_cond_t doneCondition;
+
+  /** incremented by each call of 'run' */
+  long generation;
+  int pendingWorkers;
+  bool shutdown;
+
+  /* the current job: */
+  Job* job;
+  int beginCell;
+  int endCell;
+  bool jobResult;
+
+  static void* workerMain (void* arg);
+
+  void workerLoop (int index);
+#endif
+
+  void getBlock (int index, int& blockBegin, int& blockEnd) const;
+
+  /** Not implemented (don't copy such objects). */
+  LatticeThreadPool (const LatticeThreadPool&);
+  LatticeThreadPool& operator= (const LatticeThreadPool&);
+
+public:
+  /**
+   * @param aNumberOfThreads number of threads inclusive the calling
+   * one. On systems without POSIX threads, the pool works serially.
+   */
+  LatticeThreadPool (int aNumberOfThreads);
+
+  ~LatticeThreadPool ();
+
+  int getNumberOfThreads () const;
+
+  /**
+   * execute the given job for the cells 'aBeginCell' <= i <
+   * 'anEndCell' and wait until all blocks are done.
+   * @return false, if the job failed for any block.
+   */
+  bool run (Job& aJob, int aBeginCell, int anEndCell);
+};
+
+#endif
@@ -25,6 +25,7 @@
  */
 
 #include "MapProxy.hpp"
+#include "ParsedLinearization.hpp"
 #include "AnT-init.hpp"
 
 
@@ -168,7 +169,17 @@ MapProxy::ParsedSystemFunction ( const Array<real_t>& currentState,
 #endif
 
     }
+  } /* for */
+
+  /* the optimized equations share the temporaries, hence all state
+     variables are bound before evaluating any equation: */
+  (AnT::equationsOfMotionOptimizer ()).prepare ();
 
+  i = 0;
+  for ( vector<MathEvalParser*>::iterator iter
+	  = (AnT::parsedEquationsOfMotion ()).begin ();
+	iter != (AnT::parsedEquationsOfMotion ()).end ();
+	++iter, ++i ) {
     RHS[i] = (*iter)->evaluate ();
 
 #if VA_DEBUG
@@ -182,8 +193,7 @@ MapProxy::ParsedSystemFunction ( const Array<real_t>& currentState,
 	 << RHS[i]
 	 << endl;
 #endif
-
-  } /* for */
+  }
 
 
 #if VA_DEBUG
@@ -230,8 +240,19 @@ ParsedSystemFunction ( const Array<real_t>& currentState,
 		       const Array<real_t>& parameters,
 		       Array<real_t>& RHS )
 {
-  cerr << MAP_LinF_NOT_DEFINED << Error::Exit;
-  return false;	    
+  /* plugin systems without linearized system function: */
+  if ((AnT::parsedEquationsOfMotion ()).empty ())
+    {
+      cerr << MAP_LinF_NOT_DEFINED << Error::Exit;
+      return false;
+    }
+
+  static ParsedLinearization linearization;
+
+  return linearization.apply (currentState,
+			      referenceState,
+			      parameters,
+			      RHS);
 }
 
 MapLinearizedProxy::SystemFunction* 
@@ -25,6 +25,7 @@
  */
 
 #include "ODE_Proxy.hpp"
+#include "ParsedLinearization.hpp"
 #include "AnT-init.hpp"
 
 /* *********************************************************
@@ -159,9 +160,19 @@ ParsedSystemFunction ( const Array<real_t>& currentState,
       (iStateIter->first)
 	->rebind ( currentState[iStateIter->second] );
     }
+  } /* for */
+
+  /* the optimized equations share the temporaries, hence all state
+     variables are bound before evaluating any equation: */
+  (AnT::equationsOfMotionOptimizer ()).prepare ();
 
+  i = 0;
+  for ( vector<MathEvalParser*>::iterator iter
+	  = (AnT::parsedEquationsOfMotion ()).begin ();
+	iter != (AnT::parsedEquationsOfMotion ()).end ();
+	++iter, ++i ) {
     RHS[i] = (*iter)->evaluate ();
-  } /* for */
+  }
 
   firstCall = false;
   return true;
@@ -189,8 +200,19 @@ ParsedSystemFunction (const Array<real_t>& currentState,
 		      const Array<real_t>& parameters,
 		      Array<real_t>& RHS)
 {
-  cerr << ODE_LinF_NOT_DEFINED << Error::Exit;
-  return false;	    
+  /* plugin systems without linearized system function: */
+  if ((AnT::parsedEquationsOfMotion ()).empty ())
+    {
+      cerr << ODE_LinF_NOT_DEFINED << Error::Exit;
+      return false;
+    }
+
+  static ParsedLinearization linearization;
+
+  return linearization.apply (currentState,
+			      referenceState,
+			      parameters,
+			      RHS);
 }
 
 // virtual 
@@ -46,25 +46,158 @@ PDE_1d_Proxy::SymbolicFunction*
 PDE_1d_Proxy::symbolicFunction = 
 PDE_1d_Proxy::DummySymbolicFunction;
 
+PDE_1d_Proxy::LatticeSystemFunction* 
+PDE_1d_Proxy::latticeSystemFunction = NULL;
+
+int PDE_1d_Proxy::latticeHalo = 1;
+
 PDE_1d_LinearizedProxy::SystemFunction* 
 PDE_1d_LinearizedProxy::systemFunction = 
 PDE_1d_LinearizedProxy::DummySystemFunction;
 
 
+/**
+ * cell-wise update of a range of cells of a PDE.
+ * @see LatticeThreadPool
+ */
+class PDE_1d_CellJob
+  : public LatticeThreadPool::Job
+{
+private:
+  const CellularState& currentState;
+  const Array<real_t>& parameters;
+  real_t deltaX;
+  const CellularState& rhsState;
+
+public:
+  PDE_1d_CellJob ( const CellularState& aCurrentState,
+		   const Array<real_t>& aParameters,
+		   real_t aDeltaX,
+		   const CellularState& aRHS_State )
+    : currentState (aCurrentState),
+      parameters (aParameters),
+      deltaX (aDeltaX),
+      rhsState (aRHS_State)
+  {}
+
+  virtual bool execute (int beginCell, int endCell)
+  {
+    for (int i = beginCell; i < endCell; ++i)
+      {
+	StateCell cell = rhsState[i];
+	bool ok = (*PDE_1d_Proxy::systemFunction) (currentState,
+						   parameters,
+						   i,
+						   deltaX,
+						   cell);
+	if (! ok) return false;
+      }
+    return true;
+  }
+};
+
+
 PDE_1d_Proxy::
 PDE_1d_Proxy (int aNumberOfCells, 
 	      int aCellDim,
 	      const Array<Array<real_t> >* aBoundary) :
   numberOfCells (aNumberOfCells),
   cellDim (aCellDim),
+  latticeState (NULL),
+  latticeRHS (NULL),
+  threadPool (NULL),
   boundaryPtr (aBoundary)
 {}
 
+// virtual
+PDE_1d_Proxy::
+~PDE_1d_Proxy ()
+{
+  delete latticeState;
+  delete latticeRHS;
+  delete threadPool;
+}
+
+void 
+PDE_1d_Proxy::
+setNumberOfThreads (int numberOfThreads)
+{
+  delete threadPool;
+  threadPool = NULL;
+
+  if (numberOfThreads > 1)
+    threadPool = new LatticeThreadPool (numberOfThreads);
+}
+
+bool 
+PDE_1d_Proxy::
+callCellwise ( const CellularState& currentCellularState,
+	       real_t deltaX,
+	       const CellularState& rhsState,
+	       int beginCell,
+	       int endCell )
+{
+  PDE_1d_CellJob job (currentCellularState, *parameters, deltaX, rhsState);
+
+  if (threadPool != NULL)
+    return threadPool->run (job, beginCell, endCell);
+  else
+    return job.execute (beginCell, endCell);
+}
+
+bool 
+PDE_1d_Proxy::
+callLatticeSystemFunction (const Array<real_t>& state,
+			   real_t deltaX)
+{
+  if (latticeState == NULL)
+    {
+      latticeState = new LatticeState (numberOfCells, cellDim, latticeHalo);
+      latticeRHS = new LatticeState (numberOfCells, cellDim, 0);
+    }
+
+  // the boundary policies are set after the construction of the
+  // proxy (see PDE_1d_Simulator::initDifferentialOperators), hence
+  // they are looked up here:
+  BoundaryPolicyEnum policy = defaultBoundaryPolicy;
+  real_t minValue = 0.0;
+  real_t maxValue = 0.0;
+
+  map<string, BoundaryPolicyEnum>::iterator i
+    = boundaryPolicyMap ().find ("lattice");
+
+  if (i != boundaryPolicyMap ().end ())
+    {
+      policy = i->second;
+
+      if (policy == CONSTANT)
+	{
+	  minValue = constantBoundaryPolicyMin () ["lattice"];
+	  maxValue = constantBoundaryPolicyMax () ["lattice"];
+	}
+    }
+
+  if (policy == INVALID)
+    cerr << "PDE_1d_Proxy: no boundary policy is given for the "
+	 << "lattice system function." 
+	 << endl << Error::Exit;
+
+  latticeState->scatter (state);
+  latticeState->fillHalo (policy, policy, minValue, maxValue);
+
+  bool ok = (*latticeSystemFunction) (*latticeState,
+				      *parameters,
+				      deltaX,
+				      *latticeRHS);
+  latticeRHS->gather (*RHS);
+
+  return ok;
+}
+
 // virtual 
 bool 
 PDE_1d_Proxy::callSystemFunction ()
 {
-  bool ok;
   const CellularState currentCellularState
     ( const_cast<Array<real_t>*> (currentState), cellDim );
 
@@ -76,17 +209,14 @@ PDE_1d_Proxy::callSystemFunction ()
   real_t deltaX = (boundary[0][1] - boundary[0][0]) / 
     (currentCellularState.numberOfCells - 1);
 
-  for (int i = 0; i < rhsState.numberOfCells; ++i)
-    {
-      StateCell cell = rhsState[i];
-      ok = (*systemFunction) (currentCellularState,
-			      *parameters,
-			      i,
-			      deltaX,
-			      cell);
-      if (! ok) return false;
-    }
-  return true;
+  if (latticeSystemFunction != NULL)
+    return callLatticeSystemFunction (*currentState, deltaX);
+
+  return callCellwise (currentCellularState,
+		       deltaX,
+		       rhsState,
+		       0,
+		       rhsState.numberOfCells);
 }
 
 // virtual
@@ -105,16 +235,15 @@ PDE_1d_Proxy::callSystemFunction (DynSysData& dynSysData)
   real_t deltaX = (boundary[0][1] - boundary[0][0]) / 
     (currentCellularState.numberOfCells - 1);
 
-  for (int i = 0; i < rhsState.numberOfCells; ++i)
-    {
-      StateCell cell = rhsState[i];
-      ok = (*systemFunction) (currentCellularState,
-			      *parameters,
-			      i,
-			      deltaX,
-			      cell);
-      if (! ok) return false;
-    }
+  if (latticeSystemFunction != NULL)
+    return callLatticeSystemFunction (dynSysData.orbit[0], deltaX);
+
+  ok = callCellwise (currentCellularState,
+		     deltaX,
+		     rhsState,
+		     0,
+		     rhsState.numberOfCells);
+  if (! ok) return false;
  // It is strange: why we use here '*parameters'
   // and not 'dynSysData.parameters.getValues ()'?
   // In other proxies there it is not the case. 
@@ -187,14 +316,18 @@ callSystemFunction ()
   real_t deltaX = (boundary[0][1] - boundary[0][0]) / 
     (currentCellularState.numberOfCells - 1);
 
-  for (int i = 1; i < rhsState.numberOfCells-1; ++i)
+  if (latticeSystemFunction != NULL)
     {
-      StateCell cell = rhsState[i];
-      ok = (*systemFunction) (currentCellularState,
-			      *parameters,
-			      i,
-			      deltaX,
-			      cell);
+      ok = callLatticeSystemFunction (*currentState, deltaX);
+      if (! ok) return false;
+    }
+  else
+    {
+      ok = callCellwise (currentCellularState,
+			 deltaX,
+			 rhsState,
+			 1,
+			 rhsState.numberOfCells - 1);
       if (! ok) return false;
     }
   
@@ -29,6 +29,8 @@
 
 #include "AbstractODE_Proxy.hpp"
 #include "data/DynSysData.hpp"
+#include "data/LatticeState.hpp"
+#include "LatticeThreadPool.hpp"
 #include "utils/GlobalConstants.hpp"
 
 
@@ -46,6 +48,29 @@ class PDE_1d_Proxy
   int numberOfCells;
   int cellDim;
 
+  /**
+   * structure-of-arrays copies of the current state and of the
+   * right hand side, used if 'latticeSystemFunction' is set.
+   * Allocated at the first call.
+   */
+  LatticeState* latticeState;
+  LatticeState* latticeRHS;
+
+  bool callLatticeSystemFunction (const Array<real_t>& state,
+				  real_t deltaX);
+
+  /**
+   * pool for the parallel cell-wise update, NULL for the serial one.
+   * @see setNumberOfThreads
+   */
+  LatticeThreadPool* threadPool;
+
+  bool callCellwise ( const CellularState& currentState,
+		      real_t deltaX,
+		      const CellularState& rhsState,
+		      int beginCell,
+		      int endCell );
+
  public:
   const Array<Array<real_t> >* boundaryPtr;
 
@@ -67,6 +92,30 @@ class PDE_1d_Proxy
   static SystemFunction* systemFunction;
   static SymbolicFunction* symbolicFunction;
 
+  /**
+   * System function working on the whole lattice at once (see
+   * LatticeState). The halo cells of 'currentState' are set
+   * according to the boundary policy of the operator named "lattice"
+   * (see 'boundaryPolicyMap'), or, if not given, according to
+   * 'defaultBoundaryPolicy'. Spatial derivatives can be computed
+   * with the kernels 'latticeD0_1d', 'latticeD00_1d', etc.; called
+   * with the LatticeState they give the same results at the
+   * boundary cells as the per-cell operators.
+   *
+   * If set, it is used instead of 'systemFunction'.
+   */
+  typedef
+  bool LatticeSystemFunction (const LatticeState& currentState,
+			      const Array<real_t>& parameters,
+			      real_t deltaX,
+			      LatticeState& rhs);
+
+  static LatticeSystemFunction* latticeSystemFunction;
+
+  /** number of halo cells on each side, needed by the stencil of
+      'latticeSystemFunction' (default: 1) */
+  static int latticeHalo;
+
   /**
    * sole constructor of the class. Because a PDE_1d proxy can be used
    * in ODE integrators, and these use the routine
@@ -76,6 +125,14 @@ class PDE_1d_Proxy
 		int aCellDim, 
 		const Array<Array<real_t> >* aBoundary);
 
+  virtual ~PDE_1d_Proxy ();
+
+  /**
+   * Use the given number of threads for the update of the cells
+   * with 'systemFunction' (see LatticeThreadPool).
+   */
+  void setNumberOfThreads (int numberOfThreads);
+
   /**
    */
   virtual bool callSystemFunction ();
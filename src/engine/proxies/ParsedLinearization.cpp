@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#include "ParsedLinearization.hpp"
+#include "AnT-init.hpp"
+
+ParsedLinearization::ParsedLinearization () :
+  isBound (false),
+  isSymbolic (false),
+  isValid (false)
+{}
+
+void
+ParsedLinearization::bind ()
+{
+  unsigned int n = (AnT::parsedEquationsOfMotion ()).size ();
+
+  seeds.alloc (n * n, 0.0);
+  for (unsigned int j = 0; j < n; ++j)
+    seeds[j * n + j] = 1.0;
+
+  jacobian.alloc (n * n);
+  lastReferenceState.alloc (n);
+
+  stateVariables.resize (n);
+
+  unsigned int i = 0;
+  for ( vector<MathEvalParser*>::iterator iter
+	  = (AnT::parsedEquationsOfMotion ()).begin ();
+	iter != (AnT::parsedEquationsOfMotion ()).end ();
+	++iter, ++i ) {
+    map<string, MathEval::Node*>& allVariables
+      = (*iter)->getVariables ();
+
+    /* the state variables get the unit vectors as seed: */
+    for ( map<string, unsigned int>::iterator stateIter
+	    = (AnT::stateVariableNames ()).begin ();
+	  stateIter != (AnT::stateVariableNames ()).end ();
+	  ++stateIter ) {
+      map<string, MathEval::Node*>::iterator parsedStateVar
+	= allVariables.find (stateIter->first);
+      if (parsedStateVar != allVariables.end ()) {
+	stateVariables[i][parsedStateVar->second]
+	  = stateIter->second;
+	(parsedStateVar->second)
+	  ->rebindTangent (&(seeds[stateIter->second * n]));
+
+	allVariables.erase (parsedStateVar);
+      }
+    }
+
+    /* the parameters are constant (no seed): */
+    while (! allVariables.empty ()) {
+      map<string, MathEval::Node*>::iterator allVariablesBegin
+	= allVariables.begin ();
+
+      double* paramRef
+	= scannableObjects.find<double>
+	( allVariablesBegin->first );
+      if (paramRef == NULL) {
+	cerr << "Parsed parameter '"
+	     << allVariablesBegin->first
+	     << "' not found in the list of existing parameters!"
+	     << endl
+	     << Error::Exit;
+      } else {
+	(allVariablesBegin->second)
+	  ->rebind (*paramRef);
+      }
+
+      allVariables.erase (allVariablesBegin);
+    }
+  }
+
+  /* symbolic jacobian, J_ij is the derivative of the equation i with
+     respect to all names of the state variable j: */
+  vector<MathEval::Node*> derivatives;
+  isSymbolic = true;
+  for (i = 0; isSymbolic && (i < n); ++i) {
+    MathEval::Node* f
+      = (AnT::parsedEquationsOfMotion ())[i]->getRootNode ();
+
+    for (unsigned int j = 0; j < n; ++j) {
+      set<MathEval::Node*> variables;
+      for ( map<MathEval::Node*, unsigned int>::iterator iStateIter
+	      = stateVariables[i].begin ();
+	    iStateIter != stateVariables[i].end ();
+	    ++iStateIter ) {
+	if (iStateIter->second == j)
+	  variables.insert (iStateIter->first);
+      }
+
+      MathEval::Node* d = MathEval::differentiate (f, variables);
+      if (d == NULL) {
+	isSymbolic = false;
+	break;
+      }
+      derivatives.push_back (d);
+    }
+  }
+
+  if (isSymbolic) {
+    set<string> stateNames;
+    for ( map<string, unsigned int>::iterator stateIter
+	    = (AnT::stateVariableNames ()).begin ();
+	  stateIter != (AnT::stateVariableNames ()).end ();
+	  ++stateIter ) {
+      stateNames.insert (stateIter->first);
+    }
+
+    jacobianOptimizer.optimize (derivatives, stateNames);
+  }
+
+  isBound = true;
+}
+
+void
+ParsedLinearization::calculateJacobian (const Array<real_t>& referenceState)
+{
+  unsigned int n = stateVariables.size ();
+
+  /* the equations share their state variables (and the optimized
+     derivatives their temporaries), hence all of them are bound
+     first: */
+  for (unsigned int i = 0; i < n; ++i) {
+    for ( map<MathEval::Node*, unsigned int>::iterator iStateIter
+	    = stateVariables[i].begin ();
+	  iStateIter != stateVariables[i].end ();
+	  ++iStateIter ) {
+      (iStateIter->first)
+	->rebind ( referenceState[iStateIter->second] );
+    }
+  }
+
+  if (isSymbolic) {
+    jacobianOptimizer.prepare ();
+
+    for (unsigned int k = 0; k < n * n; ++k)
+      jacobian[k] = jacobianOptimizer.getExpression (k)->evaluate ();
+
+    return;
+  }
+
+  unsigned int i = 0;
+  for ( vector<MathEvalParser*>::iterator iter
+	  = (AnT::parsedEquationsOfMotion ()).begin ();
+	iter != (AnT::parsedEquationsOfMotion ()).end ();
+	++iter, ++i ) {
+    double value;
+    const double* tangent = (*iter)->evaluateTangent (n, value);
+
+    for (unsigned int j = 0; j < n; ++j)
+      jacobian[i * n + j] = (tangent == NULL) ? 0.0 : tangent[j];
+  }
+}
+
+bool
+ParsedLinearization::apply (const Array<real_t>& currentState,
+			    const Array<real_t>& referenceState,
+			    const Array<real_t>& parameters,
+			    Array<real_t>& RHS)
+{
+  assert (! (AnT::parsedEquationsOfMotion ()).empty ());
+
+  if (! isBound)
+    bind ();
+
+  int n = stateVariables.size ();
+
+  if (isValid)
+    {
+      for (int j = 0; j < n; ++j)
+	if (lastReferenceState[j] != referenceState[j])
+	  {
+	    isValid = false;
+	    break;
+	  }
+
+      for (int k = 0; isValid && (k < parameters.getTotalSize ()); ++k)
+	if (lastParameters[k] != parameters[k])
+	  isValid = false;
+    }
+
+  if (! isValid)
+    {
+      calculateJacobian (referenceState);
+
+      lastReferenceState = referenceState;
+      lastParameters = parameters; // allocates at the first call
+      isValid = true;
+    }
+
+  for (int i = 0; i < n; ++i)
+    {
+      real_t sum = 0.0;
+
+      for (int j = 0; j < n; ++j)
+	sum += jacobian[i * n + j] * currentState[j];
+
+      RHS[i] = sum;
+    }
+
+  return true;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#ifndef PARSED_LINEARIZATION_HPP
+#define PARSED_LINEARIZATION_HPP
+
+#include <map>
+#include <vector>
+using std::map;
+using std::vector;
+
+#include "utils/GlobalConstants.hpp"
+#include "../utils/arrays/Array.hpp"
+#include "../utils/matheval/MathEvalOptimizer.hpp"
+
+/**
+ * Linearized system function for parsed equations of motion, used by
+ * 'ODE_LinearizedProxy' and 'MapLinearizedProxy' as default, i.e.
+ * if no linearized system function is given by the user.
+ *
+ * The jacobian at the reference state is evaluated from its symbolic
+ * derivatives, which are optimized like the equations of motion (see
+ * 'MathEvalOptimizer'). If a function without derivative rule occurs,
+ * it is calculated by forward mode automatic differentiation of the
+ * evaluation trees instead, whereby the state variables are seeded
+ * with the unit vectors, so that all columns are obtained in one
+ * pass. The jacobian is reused as long as
+ * the reference state and the parameters do not change, hence the
+ * deviation vectors of the lyapunov exponents calculator (all with
+ * the same reference state) cost one matrix-vector product each.
+ */
+class ParsedLinearization
+{
+private:
+  bool isBound;
+
+  /** state variable nodes of each equation and their indices */
+  vector<map<MathEval::Node*, unsigned int> > stateVariables;
+
+  /** unit vectors, the seed of the state variable i is the row i */
+  Array<real_t> seeds;
+
+  /** the symbolic jacobian (row-major), if known */
+  bool isSymbolic;
+  MathEvalOptimizer jacobianOptimizer;
+
+  /** row-major, \f$J_{ij} = \partial f_i / \partial x_j\f$ */
+  Array<real_t> jacobian;
+
+  /** reference state and parameters of the current jacobian */
+  Array<real_t> lastReferenceState;
+  Array<real_t> lastParameters;
+  bool isValid;
+
+  void bind ();
+
+  void calculateJacobian (const Array<real_t>& referenceState);
+
+public:
+  ParsedLinearization ();
+
+  /**
+   * RHS = J (referenceState) * currentState
+   */
+  bool apply (const Array<real_t>& currentState,
+	      const Array<real_t>& referenceState,
+	      const Array<real_t>& parameters,
+	      Array<real_t>& RHS);
+};
+
+#endif
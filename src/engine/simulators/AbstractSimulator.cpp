@@ -40,6 +40,7 @@ AbstractSimulator::AbstractSimulator () :
   iterPost ("iterPostSequence"),
   iterMachine (NULL),
   orbitResetter (NULL),
+  convergenceMonitor (NULL),
   progressWriter (NULL),
   scanData (NULL),
   scanPre ("scanPreSequence"),
@@ -126,6 +127,8 @@ AbstractSimulator::~AbstractSimulator ()
     delete iterMachine;
   if (orbitResetter != NULL)
     delete orbitResetter;
+  if (convergenceMonitor != NULL)
+    delete convergenceMonitor;
   if (progressWriter != NULL)
     delete progressWriter;
   if (scanData != NULL) 
@@ -437,6 +440,8 @@ AbstractSimulator::initIterMachine (Configuration& dynSysDescription)
   iterLoop.iteratorAndTimerPair.second
     = &timerUpdater;
 
+  initConvergenceMonitor (dynSysDescription);
+
   iterMain.second = &iterLoop;
 
   iterMachine
@@ -451,6 +456,63 @@ AbstractSimulator::initIterMachine (Configuration& dynSysDescription)
 
 }
 
+void 
+AbstractSimulator::initConvergenceMonitor (Configuration& dynSysDescription)
+{
+  if (! dynSysDescription.checkForKey ("CONVERGENCE_MONITOR_KEY"))
+    return;
+
+  Configuration monitorDescription
+    = dynSysDescription.getSubConfiguration ("CONVERGENCE_MONITOR_KEY");
+
+  if (! monitorDescription.getBool ("IS_ACTIVE_KEY"))
+    return;
+
+  if (dynamic_cast <HybridPart*> (dynSysData) != NULL)
+  {
+    cerr << "Warning: the convergence monitor is not supported "
+	 << "for hybrid systems and will be ignored."
+	 << endl;
+    return;
+  }
+
+  DiscreteTimeType transient 
+    = monitorDescription.getLong ("TRANSIENT_KEY");
+  long maxPeriod = monitorDescription.getLong ("MAX_PERIOD_KEY");
+  real_t precision 
+    = monitorDescription.getReal ("COMPARE_PRECISION_KEY");
+
+  ConvergenceMonitor::action_t action = ConvergenceMonitor::STOP;
+
+  if (monitorDescription.checkForEnumValue 
+      ("CONVERGENCE_ACTION_KEY", "CONVERGENCE_REPLAY_KEY"))
+  {
+    action = ConvergenceMonitor::REPLAY;
+  }
+
+  if ( (maxPeriod < 1) || (precision <= 0) )
+  {
+    cerr << "AbstractSimulator::initConvergenceMonitor error: "
+	 << "the maximal period and the compare precision "
+	 << "have to be positive."
+	 << endl << Error::Exit;
+  }
+
+  convergenceMonitor 
+    = new ConvergenceMonitor (*dynSysIterator,
+			      transient,
+			      maxPeriod,
+			      precision,
+			      action);
+
+  (dynSysData->orbit).leastSize (convergenceMonitor->leastOrbitSize ());
+
+  iterLoop.iteratorAndTimerPair.first = convergenceMonitor;
+
+  resettables.push_back 
+    (new Resettable<ConvergenceMonitor> (*convergenceMonitor, 
+					 "a convergence monitor resetter"));
+}
 
 void 
 AbstractSimulator::initOrbitResetter ()
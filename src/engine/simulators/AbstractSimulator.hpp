@@ -32,6 +32,7 @@
 #include "data/ScannableObjects.hpp"
 #include "data/InitialStatesResetter.hpp"
 #include "iterators/Iterator.hpp"
+#include "iterators/ConvergenceMonitor.hpp"
 #include "methods/MethodsData.hpp"
 #include "proxies/AveragedMapProxy.hpp"
 #include "proxies/PoincareMapProxy.hpp"
@@ -74,6 +75,9 @@ private:
 
   AbstractOrbitResetter* orbitResetter;
 
+  /** optional, NULL if not configured */
+  ConvergenceMonitor* convergenceMonitor;
+
   list<IterTransition*> resettables;
 
   ProgressWriter* progressWriter;
@@ -123,6 +127,13 @@ public:
     return scanData;
   }
 
+  /** Needed by the adaptive scan, which reads the results of the
+      investigation methods. */
+  MethodsData* getMethodsData ()
+  {
+    return methodsData;
+  }
+
   /**
    * Get the dynamical system data.
    */
@@ -161,6 +172,14 @@ private:
    */
   void initOrbitResetter ();
 
+  /**
+   * If configured, the convergence monitor will be created and
+   * put into the iter loop instead of the iterator.
+   * Assumption: 'dynSysData' and 'dynSysIterator' are already created.
+   * @param dynSysDescription description of the dynamical system
+   */
+  void initConvergenceMonitor (Configuration& dynSysDescription);
+
   /**     
    * initial values resetters (for continuus and, if necessary discrete) 
    * are managed here.
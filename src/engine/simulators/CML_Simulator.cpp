@@ -50,6 +50,10 @@ initDynamicalSystem (Configuration& dynSysDescription)
 
   proxy = new CML_Proxy ();
 
+  if (dynSysDescription.checkForKey ("NUMBER_OF_THREADS_KEY"))
+    static_cast<CML_Proxy*> (proxy)->setNumberOfThreads
+      ( dynSysDescription.getInteger ("NUMBER_OF_THREADS_KEY") );
+
   // Initialization of the CML data.
   string name = dynSysDescription.getString ("SYSTEM_NAME_KEY");
 
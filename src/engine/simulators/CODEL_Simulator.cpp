@@ -55,6 +55,10 @@ initDynamicalSystem (Configuration& dynSysDescription)
   */
   proxy = new CODEL_Proxy (cellDim, numberOfCells);
 
+  if (dynSysDescription.checkForKey ("NUMBER_OF_THREADS_KEY"))
+    static_cast<CODEL_Proxy*> (proxy)->setNumberOfThreads
+      ( dynSysDescription.getInteger ("NUMBER_OF_THREADS_KEY") );
+
   Configuration methodDescription 
     = dynSysDescription.getSubConfiguration ("INTEGRATION_METHOD_KEY");
 
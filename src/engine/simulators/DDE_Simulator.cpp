@@ -43,9 +43,34 @@ initDynamicalSystem (Configuration& dynSysDescription)
 
   real_t deltaT = methodDescription.getReal ("STEP_KEY");
 
+  // With dense output the delays need not be multiples of the step
+  // size and may vary up to the maximal delay.
+  bool denseOutput = 
+    methodDescription.checkForKey ("DENSE_OUTPUT_KEY")
+    && methodDescription.getBool ("DENSE_OUTPUT_KEY");
+
+  real_t maxDelay = delay;
+
+  if ( denseOutput 
+       && dynSysDescription.checkForKey ("MAX_DELAY_KEY") )
+    {
+      maxDelay = dynSysDescription.getReal ("MAX_DELAY_KEY");
+
+      if (maxDelay < delay)
+	cerr << "The maximal delay (given value: "
+	     << maxDelay
+	     << ") should not be smaller than the delay (given value: "
+	     << delay
+	     << ")."
+	     << endl << Error::Exit;
+    }
+
   // Initialization of initial values.
   int systemMemoryLength = (int)floor (delay / deltaT) + 1;
 
+  if (denseOutput)
+    systemMemoryLength = (int)ceil (maxDelay / deltaT - 1.0e-9) + 1;
+
   initialValuesResetter = 
     new InitialStates::TimeDependent::CompositeResetter (dynSysDescription, 
 							 deltaT);
@@ -67,6 +92,13 @@ initDynamicalSystem (Configuration& dynSysDescription)
       dynSysDescription.getLong ("NUMBER_OF_ITERATIONS_KEY"), 
       deltaT,
       delay );
+
+  ((DDE_Data*) dynSysData)->maxDelay = maxDelay;
+
+  // With dense output the system memory reaches back to the maximal
+  // delay, but the delay state on the grid is still the one at t-tau.
+  if (denseOutput)
+    ((DDE_Data*) dynSysData)->tauIndex = - (long) floor (delay / deltaT);
   
      
   // Initialization of the integrator for the current integration 
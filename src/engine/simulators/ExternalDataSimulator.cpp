@@ -45,8 +45,10 @@ ExternalDataSimulator::initDynamicalSystem (Configuration& dynSysDescription)
 
   int columns = dynSysDescription.getLong ("NUMBER_OF_COLUMNS_KEY");
 
-  TExternalDataFile externalfile = 
-    (dynSysDescription.getString ("EXTERNAL_DATA_FILENAME_KEY")).c_str ();
+  // keep the string alive as long as its c_str () is used
+  string externalFileName =
+    dynSysDescription.getString ("EXTERNAL_DATA_FILENAME_KEY");
+  TExternalDataFile externalfile = externalFileName.c_str ();
 
   bool acceptEmptyLines = true;
   if (dynSysDescription.checkForKey ("ACCEPT_EMPTY_LINES_KEY"))
@@ -83,10 +85,25 @@ ExternalDataSimulator::initDynamicalSystem (Configuration& dynSysDescription)
 	     << Error::Exit;
     }
 
+  TInputFormat inputFormat = ifAscii;
+  if (dynSysDescription.checkForKey ("INPUT_FORMAT_KEY"))
+    {
+      if (dynSysDescription.checkForEnumValue
+	  ("INPUT_FORMAT_KEY", "MAPPED_ASCII_INPUT_KEY"))
+      {
+	inputFormat = ifMappedAscii;
+      }
+      else if (dynSysDescription.checkForEnumValue
+	       ("INPUT_FORMAT_KEY", "BINARY_INPUT_KEY"))
+      {
+	inputFormat = ifBinary;
+      }
+    }
+
   edr.throwExceptionOnBadRow = !ignoreWrongLines;
   edr.errorOnEmptyRow = !acceptEmptyLines;
 
-  edr.init (externalfile, columns);
+  edr.init (externalfile, columns, inputFormat);
 
   Configuration inputDataDescription 
     = dynSysDescription.getSubConfiguration ("DATA_INPUT_DESCRIPTION_KEY");
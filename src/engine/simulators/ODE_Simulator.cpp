@@ -27,6 +27,8 @@
 #include "ODE_Simulator.hpp"
 #include "data/InitialStatesResetter.hpp"
 #include "iterators/ODE_Integrator.hpp"
+#include "iterators/CompiledODE_Integrator.hpp"
+#include "AnT-init.hpp"
 #include "proxies/ODE_Proxy.hpp"
 
 void 
@@ -56,11 +58,21 @@ initDynamicalSystem (Configuration& dynSysDescription)
 
   /*
      Initialization of the integrator for the current integration 
-     method.
+     method. A system plugin is integrated by a compiled integrator,
+     if there is one for the method.
   */
-  dynSysIterator = ODE_Integrator::get ( methodDescription, 
-					 *((ODE_Proxy*) proxy),
-					 *((ODE_Data*) dynSysData) );
+  dynSysIterator = NULL;
+
+  if (AnT::getSystemFunctionTreatment () == COMPILED)
+    dynSysIterator = CompiledODE_Integrator::get 
+      ( methodDescription, 
+	*((ODE_Proxy*) proxy),
+	*((ODE_Data*) dynSysData) );
+
+  if (dynSysIterator == NULL)
+    dynSysIterator = ODE_Integrator::get ( methodDescription, 
+					   *((ODE_Proxy*) proxy),
+					   *((ODE_Data*) dynSysData) );
 }
 
 
@@ -26,6 +26,7 @@
 
 #include "PDE_1d_Simulator.hpp"
 #include "iterators/ODE_Integrator.hpp"
+#include "iterators/PDE_1d_IMEX_Integrator.hpp"
 #include "SpatialDiffOperators.hpp"
 #include "../utils/strconv/StringConverter.hpp"
 #include "proxies/PDE_1d_Proxy.hpp"
@@ -97,12 +98,53 @@ initDynamicalSystem (Configuration& dynSysDescription)
 	(numberOfCells, cellDim, &(newPDE_Data->boundary));
     }
 
-  dynSysIterator = ODE_Integrator::get
-    ( methodDescription, 
-      *(static_cast<AbstractODE_Proxy*>(proxy)),
-      *newPDE_Data );
+  if (dynSysDescription.checkForKey ("NUMBER_OF_THREADS_KEY"))
+    static_cast<PDE_1d_Proxy*> (proxy)->setNumberOfThreads
+      ( dynSysDescription.getInteger ("NUMBER_OF_THREADS_KEY") );
 
+  // the boundary policies are needed by the IMEX integrators
   initDifferentialOperators (dynSysDescription);
+
+  if ( methodDescription.checkForEnumValue ("METHOD_KEY", 
+					    "IMEX_EULER_KEY")
+       || methodDescription.checkForEnumValue ("METHOD_KEY", 
+					       "IMEX_SBDF2_KEY") )
+    {
+      if (! dynSysDescription.checkForKey ("DIFFUSION_COEFFICIENTS_KEY"))
+	{
+	  cerr << "The integration method '"
+	       << methodDescription.getEnum ("METHOD_KEY")
+	       << "' needs the diffusion coefficients at the key '"
+	       << dynSysDescription.getOriginalKey 
+	          ("DIFFUSION_COEFFICIENTS_KEY")
+	       << "'."
+	       << endl << Error::Exit;
+	}
+
+      Array<real_t> diffusion (cellDim);
+      dynSysDescription.getArray ("DIFFUSION_COEFFICIENTS_KEY", diffusion);
+
+      PDE_1d_IMEX_Integrator::scheme_t scheme 
+	= PDE_1d_IMEX_Integrator::IMEX_EULER;
+
+      if (methodDescription.checkForEnumValue ("METHOD_KEY", 
+					       "IMEX_SBDF2_KEY"))
+	scheme = PDE_1d_IMEX_Integrator::SBDF2;
+
+      dynSysIterator = new PDE_1d_IMEX_Integrator
+	( *(static_cast<AbstractODE_Proxy*>(proxy)),
+	  *newPDE_Data,
+	  diffusion,
+	  scheme,
+	  dynSysDescription.getBool ("DIRICHLET_BOUNDARY_CONDITIONS_KEY") );
+    }
+  else
+    {
+      dynSysIterator = ODE_Integrator::get
+	( methodDescription, 
+	  *(static_cast<AbstractODE_Proxy*>(proxy)),
+	  *newPDE_Data );
+    }
 }
 
 
@@ -52,6 +52,20 @@ initIntegrationMethod ( Configuration& dynSysDescription,
       dynSysIterator = new StochasticalDDE_EulerForward 
 	(*proxy, *dynSysDataPtr, dynSysDescription);
     }
+  else if (methodDescription.checkForEnumValue ("METHOD_KEY",
+						"SRA1_KEY"))
+    {
+      dynSysIterator = new StochasticalDDE_SRA 
+	(*proxy, *dynSysDataPtr, dynSysDescription,
+	 SRA_Coefficients::SRA1);
+    }
+  else if (methodDescription.checkForEnumValue ("METHOD_KEY",
+						"SRA3_KEY"))
+    {
+      dynSysIterator = new StochasticalDDE_SRA 
+	(*proxy, *dynSysDataPtr, dynSysDescription,
+	 SRA_Coefficients::SRA3);
+    }
   else
     cerr << "An unrecognized setting '"
 	 << methodDescription.getEnum ("METHOD_KEY")
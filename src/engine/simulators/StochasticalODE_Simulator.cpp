@@ -55,6 +55,20 @@ void StochasticalODE_Simulator::initIntegrationMethod
       dynSysIterator = new StochasticalODE_EulerForward 
 	(*proxy, *dynSysDataPtr, dynSysDescription);
     }
+  else if (methodDescription.checkForEnumValue ("METHOD_KEY",
+						"SRA1_KEY"))
+    {
+      dynSysIterator = new StochasticalODE_SRA 
+	(*proxy, *dynSysDataPtr, dynSysDescription,
+	 SRA_Coefficients::SRA1);
+    }
+  else if (methodDescription.checkForEnumValue ("METHOD_KEY",
+						"SRA3_KEY"))
+    {
+      dynSysIterator = new StochasticalODE_SRA 
+	(*proxy, *dynSysDataPtr, dynSysDescription,
+	 SRA_Coefficients::SRA3);
+    }
   else
     cerr << "An unrecognized setting '"
 	 << methodDescription.getEnum ("METHOD_KEY")
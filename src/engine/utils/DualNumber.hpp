@@ -0,0 +1,426 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#ifndef DUAL_NUMBER_HPP
+#define DUAL_NUMBER_HPP
+
+#include <cmath>
+
+#include "utils/GlobalConstants.hpp" // real_t
+#include "../utils/arrays/Array.hpp"
+
+
+/**
+ * Dual number with N tangent directions for forward mode automatic
+ * differentiation: a value together with its derivatives in N
+ * directions. All arithmetical operations and the usual mathematical
+ * functions propagate the tangent by the chain rule, comparisons
+ * use the value only.
+ *
+ * @note the mathematical functions are found by argument dependent
+ * lookup, hence they have to be called unqualified in templated
+ * system functions, i.e. 'sin (x[0])' and not 'std::sin (x[0])'.
+ */
+template <const unsigned int N>
+class Dual
+{
+public:
+  real_t value;
+  real_t tangent[N];
+
+  Dual () :
+    value (0.0)
+  {
+    for (unsigned int k = 0; k < N; ++k)
+      tangent[k] = 0.0;
+  }
+
+  Dual (real_t aValue) :
+    value (aValue)
+  {
+    for (unsigned int k = 0; k < N; ++k)
+      tangent[k] = 0.0;
+  }
+
+  Dual& operator+= (const Dual& d)
+  {
+    value += d.value;
+    for (unsigned int k = 0; k < N; ++k)
+      tangent[k] += d.tangent[k];
+    return *this;
+  }
+
+  Dual& operator-= (const Dual& d)
+  {
+    value -= d.value;
+    for (unsigned int k = 0; k < N; ++k)
+      tangent[k] -= d.tangent[k];
+    return *this;
+  }
+
+  Dual& operator*= (const Dual& d)
+  {
+    for (unsigned int k = 0; k < N; ++k)
+      tangent[k] = tangent[k] * d.value + value * d.tangent[k];
+    value *= d.value;
+    return *this;
+  }
+
+  Dual& operator/= (const Dual& d)
+  {
+    value /= d.value;
+    for (unsigned int k = 0; k < N; ++k)
+      tangent[k] = (tangent[k] - value * d.tangent[k]) / d.value;
+    return *this;
+  }
+
+  Dual& operator+= (real_t c)
+  {
+    value += c;
+    return *this;
+  }
+
+  Dual& operator-= (real_t c)
+  {
+    value -= c;
+    return *this;
+  }
+
+  Dual& operator*= (real_t c)
+  {
+    value *= c;
+    for (unsigned int k = 0; k < N; ++k)
+      tangent[k] *= c;
+    return *this;
+  }
+
+  Dual& operator/= (real_t c)
+  {
+    value /= c;
+    for (unsigned int k = 0; k < N; ++k)
+      tangent[k] /= c;
+    return *this;
+  }
+};
+
+
+/**
+ * the chain rule: f (d) with f' (d.value) = df, f (d.value) = fValue
+ */
+template <const unsigned int N>
+inline Dual<N> chainRule (const Dual<N>& d, real_t fValue, real_t df)
+{
+  Dual<N> result (fValue);
+  for (unsigned int k = 0; k < N; ++k)
+    result.tangent[k] = df * d.tangent[k];
+  return result;
+}
+
+
+template <const unsigned int N>
+inline Dual<N> operator- (const Dual<N>& d)
+{
+  return chainRule (d, -d.value, -1.0);
+}
+
+template <const unsigned int N>
+inline Dual<N> operator+ (const Dual<N>& d)
+{
+  return d;
+}
+
+#define DUAL_NUMBER_BINARY_OPERATOR(op)                               \
+template <const unsigned int N>                                       \
+inline Dual<N> operator op (const Dual<N>& a, const Dual<N>& b)       \
+{                                                                     \
+  Dual<N> result (a);                                                 \
+  return result op##= b;                                              \
+}                                                                     \
+template <const unsigned int N>                                       \
+inline Dual<N> operator op (const Dual<N>& a, real_t b)               \
+{                                                                     \
+  Dual<N> result (a);                                                 \
+  return result op##= b;                                              \
+}                                                                     \
+template <const unsigned int N>                                       \
+inline Dual<N> operator op (real_t a, const Dual<N>& b)               \
+{                                                                     \
+  Dual<N> result (a);                                                 \
+  return result op##= b;                                              \
+}
+
+DUAL_NUMBER_BINARY_OPERATOR(+)
+DUAL_NUMBER_BINARY_OPERATOR(-)
+DUAL_NUMBER_BINARY_OPERATOR(*)
+DUAL_NUMBER_BINARY_OPERATOR(/)
+
+#undef DUAL_NUMBER_BINARY_OPERATOR
+
+#define DUAL_NUMBER_COMPARISON(op)                                    \
+template <const unsigned int N>                                       \
+inline bool operator op (const Dual<N>& a, const Dual<N>& b)          \
+{                                                                     \
+  return a.value op b.value;                                          \
+}                                                                     \
+template <const unsigned int N>                                       \
+inline bool operator op (const Dual<N>& a, real_t b)                  \
+{                                                                     \
+  return a.value op b;                                                \
+}                                                                     \
+template <const unsigned int N>                                       \
+inline bool operator op (real_t a, const Dual<N>& b)                  \
+{                                                                     \
+  return a op b.value;                                                \
+}
+
+DUAL_NUMBER_COMPARISON(<)
+DUAL_NUMBER_COMPARISON(>)
+DUAL_NUMBER_COMPARISON(<=)
+DUAL_NUMBER_COMPARISON(>=)
+DUAL_NUMBER_COMPARISON(==)
+DUAL_NUMBER_COMPARISON(!=)
+
+#undef DUAL_NUMBER_COMPARISON
+
+
+template <const unsigned int N>
+inline Dual<N> sin (const Dual<N>& d)
+{
+  return chainRule (d, std::sin (d.value), std::cos (d.value));
+}
+
+template <const unsigned int N>
+inline Dual<N> cos (const Dual<N>& d)
+{
+  return chainRule (d, std::cos (d.value), -std::sin (d.value));
+}
+
+template <const unsigned int N>
+inline Dual<N> tan (const Dual<N>& d)
+{
+  real_t t = std::tan (d.value);
+  return chainRule (d, t, 1.0 + t * t);
+}
+
+template <const unsigned int N>
+inline Dual<N> asin (const Dual<N>& d)
+{
+  return chainRule (d, std::asin (d.value),
+		    1.0 / std::sqrt (1.0 - d.value * d.value));
+}
+
+template <const unsigned int N>
+inline Dual<N> acos (const Dual<N>& d)
+{
+  return chainRule (d, std::acos (d.value),
+		    -1.0 / std::sqrt (1.0 - d.value * d.value));
+}
+
+template <const unsigned int N>
+inline Dual<N> atan (const Dual<N>& d)
+{
+  return chainRule (d, std::atan (d.value),
+		    1.0 / (1.0 + d.value * d.value));
+}
+
+template <const unsigned int N>
+inline Dual<N> atan2 (const Dual<N>& y, const Dual<N>& x)
+{
+  real_t r = x.value * x.value + y.value * y.value;
+  Dual<N> result (std::atan2 (y.value, x.value));
+  for (unsigned int k = 0; k < N; ++k)
+    result.tangent[k]
+      = (x.value * y.tangent[k] - y.value * x.tangent[k]) / r;
+  return result;
+}
+
+template <const unsigned int N>
+inline Dual<N> sinh (const Dual<N>& d)
+{
+  return chainRule (d, std::sinh (d.value), std::cosh (d.value));
+}
+
+template <const unsigned int N>
+inline Dual<N> cosh (const Dual<N>& d)
+{
+  return chainRule (d, std::cosh (d.value), std::sinh (d.value));
+}
+
+template <const unsigned int N>
+inline Dual<N> tanh (const Dual<N>& d)
+{
+  real_t t = std::tanh (d.value);
+  return chainRule (d, t, 1.0 - t * t);
+}
+
+template <const unsigned int N>
+inline Dual<N> exp (const Dual<N>& d)
+{
+  real_t e = std::exp (d.value);
+  return chainRule (d, e, e);
+}
+
+template <const unsigned int N>
+inline Dual<N> log (const Dual<N>& d)
+{
+  return chainRule (d, std::log (d.value), 1.0 / d.value);
+}
+
+template <const unsigned int N>
+inline Dual<N> log10 (const Dual<N>& d)
+{
+  return chainRule (d, std::log10 (d.value),
+		    1.0 / (d.value * std::log (10.0)));
+}
+
+template <const unsigned int N>
+inline Dual<N> sqrt (const Dual<N>& d)
+{
+  real_t s = std::sqrt (d.value);
+  return chainRule (d, s, 0.5 / s);
+}
+
+template <const unsigned int N>
+inline Dual<N> fabs (const Dual<N>& d)
+{
+  return chainRule (d, std::fabs (d.value), (d.value < 0.0) ? -1.0 : 1.0);
+}
+
+template <const unsigned int N>
+inline Dual<N> pow (const Dual<N>& d, real_t e)
+{
+  return chainRule (d, std::pow (d.value, e),
+		    e * std::pow (d.value, e - 1.0));
+}
+
+template <const unsigned int N>
+inline Dual<N> pow (real_t b, const Dual<N>& e)
+{
+  real_t p = std::pow (b, e.value);
+  return chainRule (e, p, p * std::log (b));
+}
+
+template <const unsigned int N>
+inline Dual<N> pow (const Dual<N>& d, const Dual<N>& e)
+{
+  return exp (e * log (d));
+}
+
+
+/**
+ * Linearized system function for ODEs and maps, obtained from a
+ * system function templated on the scalar type of the state: the
+ * jacobian at the reference state is calculated in one pass with
+ * 'Dual<N>', whereby N is the state space dimension, and reused as
+ * long as the reference state and the parameters do not change.
+ * Example (Lorenz system):
+ * \code
+ * template <class T>
+ * bool lorenz (const Array<T>& x, const Array<real_t>& p, Array<T>& f)
+ * {
+ *   f[0] = p[0] * (x[1] - x[0]);
+ *   ...
+ *   return true;
+ * }
+ *
+ * void connectSystem ()
+ * {
+ *   ODE_Proxy::systemFunction = lorenz<real_t>;
+ *   ODE_LinearizedProxy::systemFunction
+ *     = TangentLinearization<3, lorenz<Dual<3> > >::systemFunction;
+ * }
+ * \endcode
+ */
+template <const unsigned int N,
+	  bool (*f) (const Array<Dual<N> >&,
+		     const Array<real_t>&,
+		     Array<Dual<N> >&)>
+class TangentLinearization
+{
+public:
+  static bool systemFunction (const Array<real_t>& currentState,
+			      const Array<real_t>& referenceState,
+			      const Array<real_t>& parameters,
+			      Array<real_t>& RHS)
+  {
+    static Array<Dual<N> > x;
+    static Array<Dual<N> > y;
+    static Array<real_t> lastReferenceState;
+    static Array<real_t> lastParameters;
+    static bool ok = true;
+
+    if (x.getTotalSize () == 0)
+      {
+	if (referenceState.getTotalSize () != (int) N)
+	  cerr << "TangentLinearization: the state space dimension "
+	       << referenceState.getTotalSize ()
+	       << " differs from the number of tangent directions "
+	       << N << "."
+	       << endl << Error::Exit;
+
+	x.alloc (N);
+	y.alloc (N);
+      }
+
+    bool isValid = (lastReferenceState.getTotalSize () == (int) N);
+
+    for (unsigned int j = 0; isValid && (j < N); ++j)
+      if (lastReferenceState[j] != referenceState[j])
+	isValid = false;
+
+    for (int k = 0; isValid && (k < parameters.getTotalSize ()); ++k)
+      if (lastParameters[k] != parameters[k])
+	isValid = false;
+
+    if (! isValid)
+      {
+	for (unsigned int j = 0; j < N; ++j)
+	  {
+	    x[j] = Dual<N> (referenceState[j]);
+	    x[j].tangent[j] = 1.0;
+	  }
+
+	ok = (*f) (x, parameters, y);
+
+	lastReferenceState = referenceState;
+	lastParameters = parameters;
+      }
+
+    for (unsigned int i = 0; i < N; ++i)
+      {
+	real_t sum = 0.0;
+
+	for (unsigned int j = 0; j < N; ++j)
+	  sum += y[i].tangent[j] * currentState[j];
+
+	RHS[i] = sum;
+      }
+
+    return ok;
+  }
+};
+
+#endif
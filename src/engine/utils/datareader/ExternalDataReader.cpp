@@ -39,6 +39,14 @@
 
 #include "ExternalDataReader.hpp"
 
+#if ANT_HAS_MAPPED_INPUT
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 using std::endl;
 using std::cout;
 using std::cerr;
@@ -72,7 +80,7 @@ shiftleft(char* buf)
 /*
 *  returns true if the first char of buf is a quoter
 */
-bool static isQuoter(ExternalDataTypes::TDataRow buf)
+bool static isQuoter(const char* buf)
 {
    using namespace ExternalDataTypes;
    for(unsigned int i=0; i<sizeof(QUOTER_CHARS); i++)
@@ -161,7 +169,7 @@ int ExternalDataReader::split (ExternalDataTypes::TColumnList columnlist,
 /*
 *  returs true if the first char of buf is a delimiter
 */
-bool ExternalDataReader::isDelimiter(ExternalDataTypes::TDataRow buf)
+bool ExternalDataReader::isDelimiter(const char* buf)
 {
    for(unsigned int i=0; i<sizeof(DELIMITER_CHARS); i++)
    {
@@ -301,6 +309,193 @@ bool ExternalDataReader::readData()
 }
 
 
+/*
+   maps the whole file into memory. Where mmap is not available,
+   the file is read into an allocated block instead.
+*/
+bool ExternalDataReader::mapFile(ExternalDataTypes::TExternalDataFile efile)
+{
+#if ANT_HAS_MAPPED_INPUT
+   int fd = open(efile, O_RDONLY);
+   if (fd < 0) return false;
+
+   struct stat st;
+   if (fstat(fd, &st) != 0)
+   {
+      close(fd);
+      return false;
+   }
+
+   size_t size = st.st_size;
+   void* addr = NULL;
+   if (size > 0)
+   {
+      addr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr == MAP_FAILED)
+      {
+         close(fd);
+         return false;
+      }
+      // the rows are read once from the start to the end
+      madvise(addr, size, MADV_SEQUENTIAL);
+   }
+   // the mapping stays valid after closing the file
+   close(fd);
+
+   mapAllocated = false;
+   mapBegin = (const char*) addr;
+   mapEnd = mapBegin + size;
+#else
+   FILE* f = fopen(efile, "rb");
+   if (f == NULL) return false;
+
+   fseek(f, 0, SEEK_END);
+   long size = ftell(f);
+   fseek(f, 0, SEEK_SET);
+
+   char* data = new char[size > 0 ? size : 1];
+   size_t got = fread(data, 1, size, f);
+   fclose(f);
+
+   mapAllocated = true;
+   mapBegin = data;
+   mapEnd = mapBegin + got;
+#endif
+   mapPos = mapBegin;
+   return true;
+}
+
+/*
+   releases the mapped file
+*/
+void ExternalDataReader::unmapFile()
+{
+   if (mapBegin != NULL)
+   {
+      if (mapAllocated)
+      {
+         delete[] mapBegin;
+      }
+#if ANT_HAS_MAPPED_INPUT
+      else
+      {
+         munmap((void*) mapBegin, mapEnd - mapBegin);
+      }
+#endif
+   }
+   mapBegin = mapEnd = mapPos = NULL;
+   mapAllocated = false;
+}
+
+/*
+   parses the row [row, eol) in place. The row has to be
+   followed by the terminating '\n' inside of the mapped file.
+*/
+bool ExternalDataReader::parseMappedRow(const char* row, const char* eol)
+{
+   const char* begins[ExternalDataTypes::MAXIMUM_COLUMNS];
+   const char* ends[ExternalDataTypes::MAXIMUM_COLUMNS];
+   int columns = 0;
+
+   const char* p = row;
+   while (p < eol)
+   {
+      while ((p < eol) && isDelimiter(p)) p++;
+      if (p == eol) break;
+
+      // too many columns
+      if (columns == fColumnCount) return false;
+
+      begins[columns] = p;
+      while ((p < eol) && !isDelimiter(p))
+      {
+         // quoted fields need the usual parser
+         if (isQuoter(p)) return false;
+         p++;
+      }
+      ends[columns] = p;
+      columns++;
+   }
+
+   if (columns != fColumnCount) return false;
+
+   return paramParser->loadParametersFromFields(begins, ends);
+}
+
+/*
+*   reads next row of the mapped file, returns true if we have data row
+*/
+bool ExternalDataReader::readMappedData()
+{
+   using namespace ExternalDataTypes;
+
+   line++;
+   const char* row = mapPos;
+   const char* eol = (const char*) memchr(row, '\n', mapEnd - row);
+   if (eol == NULL)
+   {
+      // last row without '\n'
+      eol = mapEnd;
+      mapPos = mapEnd;
+   }
+   else
+   {
+      mapPos = eol + 1;
+   }
+
+   const char* p = row;
+   while ((p < eol) && (*p == ' ')) p++;
+   if ((p < eol) && (*p == COMMENT_CHAR))
+   {
+      // comment, as in isComment
+      return false;
+   }
+
+   // the number parsers may read up to the terminating '\n',
+   // which is not there for an unterminated last row
+   if ((eol < mapEnd) && parseMappedRow(row, eol)) return true;
+
+   // let the usual parser handle (and report) this row
+   size_t length = (mapPos - row);
+   if (length >= buffSize)
+   {
+      length = buffSize - 1;
+      onRowExceedsSize(line, buffer);
+   }
+   memcpy(buffer, row, length);
+   buffer[length] = '\0';
+
+   if (parseRow(buffer)) return true;
+
+   if (throwExceptionOnBadRow) raiseException();
+   return false;
+}
+
+/*
+*   reads next row of the binary file
+*/
+bool ExternalDataReader::readBinaryData()
+{
+   size_t rowSize = fColumnCount * sizeof(double);
+
+   if ((size_t) (mapEnd - mapPos) < rowSize)
+   {
+      if (mapPos != mapEnd)
+      {
+         errorOut << (mapEnd - mapPos) << " bytes after the last row "
+                  << line << " are ignored" << endl;
+         mapPos = mapEnd;
+      }
+      return false;
+   }
+
+   line++;
+   paramParser->loadParametersFromValues((const double*) mapPos);
+   mapPos += rowSize;
+   return true;
+}
+
+
 /* ------------- PROTECTED ----------------*/
 
 /*
@@ -359,7 +554,12 @@ void ExternalDataReader::onRowExceedsSize(int line,ExternalDataTypes::TDataRow r
 */
 ExternalDataReader::ExternalDataReader (unsigned int aBuffSize)
   : buffSize (aBuffSize),
-    stream (NULL) //: Bug fixed
+    stream (NULL), //: Bug fixed
+    format (ExternalDataTypes::ifAscii),
+    mapBegin (NULL),
+    mapEnd (NULL),
+    mapPos (NULL),
+    mapAllocated (false)
 {
   using namespace ExternalDataTypes;
   for(unsigned int i=0; i<sizeof(DELIMITER_CHARS); ++i) { 
@@ -382,6 +582,7 @@ ExternalDataReader::~ExternalDataReader()
      fclose(stream);
      stream = NULL;
    }
+   unmapFile();
    // free resources
    delete[] buffer;
    delete paramParser;
@@ -392,9 +593,11 @@ ExternalDataReader::~ExternalDataReader()
 *   Init ExternalDataReader with Filename and Params
 */
 bool ExternalDataReader::init (ExternalDataTypes::TExternalDataFile efile,
-			       int columnsInFile)
+			       int columnsInFile,
+			       ExternalDataTypes::TInputFormat inputFormat)
 {
    fColumnCount = columnsInFile;
+   format = inputFormat;
    // init the paramParser
 
    paramParser->init(fColumnCount);
@@ -405,6 +608,21 @@ bool ExternalDataReader::init (ExternalDataTypes::TExternalDataFile efile,
    if (stream != NULL)
    {
       fclose(stream);
+      stream = NULL;
+   }
+   unmapFile();
+
+   if (format != ExternalDataTypes::ifAscii)
+   {
+      if (!mapFile(efile))
+      {
+         errorOut << "Couldn't map file : " << efile << endl;
+         fexistData = false;
+         raiseException();
+         return false;
+      }
+      shoudReadFirstRow = true;
+      return true;
    }
 
    // open new stream
@@ -435,11 +653,25 @@ bool ExternalDataReader::next()
 {
 
   bool read = false;
-  // read row by row, until we have a right row,
-  // skip comments, empty rows etc.
-  while (!feof(stream) & (!read))
+  if (format == ExternalDataTypes::ifBinary)
+  {
+     read = readBinaryData();
+  }
+  else if (format == ExternalDataTypes::ifMappedAscii)
   {
-     read = readData();
+     while ((mapPos < mapEnd) && (!read))
+     {
+        read = readMappedData();
+     }
+  }
+  else
+  {
+     // read row by row, until we have a right row,
+     // skip comments, empty rows etc.
+     while (!feof(stream) & (!read))
+     {
+        read = readData();
+     }
   }
   // now we have data or eof
   fexistData = read;
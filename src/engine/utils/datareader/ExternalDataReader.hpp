@@ -32,6 +32,12 @@
 #include <cstdio>
 #include <cstring>
 
+#include "config.h"
+
+#if ! (ANT_HAS_WIN_ENV && (! defined __CYGWIN__))
+#define ANT_HAS_MAPPED_INPUT 1
+#endif
+
 #include "ParameterParser.hpp"
 #include "ExternalDataTypes.hpp"
 
@@ -74,6 +80,17 @@
      To use custom delimiter (e.g. Pipe character) call setCustomDelimiter('|');
      By default space, tab and semicolon are accepted.
 
+     Large files can be read with the input format ifMappedAscii
+     (third argument of init). The file is mapped into memory and the
+     rows are parsed in place, without copying and splitting them.
+     Rows the in-place parser can not handle (quoted fields, wrong
+     number of columns, bad numbers, the last row if not terminated)
+     are handed over to the usual parser, hence the results and the
+     error handling are the same as for ifAscii.
+     The input format ifBinary expects rows of native doubles, one per
+     column in file, without any header. Such files need no parsing at
+     all and can be shared by several runs through the page cache.
+
      Example of usage :
 
      \code
@@ -118,7 +135,7 @@ private:
  char DELIMITER_CHARS[5];
 
  //! returs true if the first char of buf is a delimiter
- bool isDelimiter(ExternalDataTypes::TDataRow buf);
+ bool isDelimiter(const char* buf);
 
 /** split -- split the string in buf into
  *          array of strings(=columnlist).
@@ -173,6 +190,34 @@ private:
  //! Reference to ParameterParser object
  ParameterParser *paramParser;
 
+ //! format of the current file
+ ExternalDataTypes::TInputFormat format;
+
+ //! mapped file (ifMappedAscii and ifBinary only)
+ const char* mapBegin;
+ const char* mapEnd;
+
+ //! start of the next row in the mapped file
+ const char* mapPos;
+
+ //! true, if mapBegin was allocated instead of mapped
+ bool mapAllocated;
+
+ //! maps the file, returns false on failure
+ bool mapFile(ExternalDataTypes::TExternalDataFile efile);
+
+ //! releases the mapped file
+ void unmapFile();
+
+ //! parses the row [row, eol) in place, false if it can not be done
+ bool parseMappedRow(const char* row, const char* eol);
+
+ //! reads and parses next row of the mapped ascii file
+ bool readMappedData();
+
+ //! reads next row of the binary file
+ bool readBinaryData();
+
 protected:
  //! is called, if a row couldn't have been parsed
  void onBadRow(int line, int columnsFound, ExternalDataTypes::TDataRow row);
@@ -206,7 +251,9 @@ public:
 
  //! init with filename and some parameters
  bool init(ExternalDataTypes::TExternalDataFile efile,
-           int columnsInFile);
+           int columnsInFile,
+           ExternalDataTypes::TInputFormat inputFormat
+           = ExternalDataTypes::ifAscii);
 
  //! returns count of columns
  int  getColumnCount();
@@ -80,6 +80,14 @@ namespace ExternalDataTypes
 //! parameter type can be integer or float
    typedef enum {ptInteger, ptFloat } TParameterType;
 
+/**
+*  format of the data file:
+*  ifAscii - ascii rows read through a stream (default),
+*  ifMappedAscii - ascii rows parsed directly in the mapped file,
+*  ifBinary - rows of native doubles, one per column, no header
+*/
+   typedef enum {ifAscii, ifMappedAscii, ifBinary } TInputFormat;
+
  //! the structure where the parameters will be stored in
   typedef struct {
          int column;
@@ -37,6 +37,8 @@
 
 #include <iostream>
 #include <cstdio>
+#include <cstdlib>
+#include <cctype>
 #include "ParameterParser.hpp"
 using std::endl;
 using std::cout;
@@ -296,3 +298,72 @@ loadParametersFromStrings (ExternalDataTypes::TColumnList columns,
 
     return true;
 }
+
+// parses not terminated fields, used by the mapped ascii input
+bool 
+ParameterParser::
+loadParametersFromFields (const char* const* begins,
+			  const char* const* ends)
+{
+    using namespace  ExternalDataTypes;
+
+    for(int i=1; i <= fParamCount; i++)
+    {
+	TParamArray entry = getPEntry(i);
+	int col = entry->column - 1;
+	const char* begin = begins[col];
+	char* end = NULL;
+
+	// leading white space would be skipped by strtod/strtol even
+	// beyond the end of the row
+	if (isspace((unsigned char) *begin))
+	{
+	    return false;
+	}
+
+	if (entry->type == ptInteger)
+	{
+	    // same as sscanf "%li"
+	    TIntParam d = strtol(begin, &end, 0);
+	    if ((end == begin) || (end > ends[col]))
+	    {
+		return false;
+	    }
+	    entry->intValue = d;
+	}
+	else
+	{
+	    // same as sscanf "%lf"
+	    TFloatParam f = strtod(begin, &end);
+	    if ((end == begin) || (end > ends[col]))
+	    {
+		return false;
+	    }
+	    entry->floatValue = f;
+	}
+    }
+
+    return true;
+}
+
+// stores the values of one binary row
+void 
+ParameterParser::loadParametersFromValues (const double* values)
+{
+    using namespace  ExternalDataTypes;
+
+    for(int i=1; i <= fParamCount; i++)
+    {
+	TParamArray entry = getPEntry(i);
+	const double v = values[entry->column - 1];
+
+	if (entry->type == ptInteger)
+	{
+	    entry->intValue = (TIntValue) v;
+	}
+	else
+	{
+	    entry->floatValue = v;
+	}
+    }
+}
@@ -146,6 +146,16 @@
       //! parses strings and stores values  in corresponding fields of array
       bool   loadParametersFromStrings(ExternalDataTypes::TColumnList columns,
               int row);
+
+      //! parses the fields [begins[i], ends[i]) in place, the fields need
+      //! not be terminated, but must be followed by a non-numeric char.
+      //! Returns false without any message if a field can not be parsed,
+      //! the caller has to fall back to loadParametersFromStrings then.
+      bool   loadParametersFromFields(const char* const* begins,
+                                      const char* const* ends);
+
+      //! stores the values of one binary row, values[column-1]
+      void   loadParametersFromValues(const double* values);
    
       //! returns number of parameters
       int getParamCount();
@@ -25,6 +25,7 @@
  */
 
 #include "ProgressWriter.hpp"
+#include "data/AdaptiveScan.hpp"
 
 // static 
 const real_t ProgressWriter::percentStep = 1.0;
@@ -115,6 +116,11 @@ ProgressWriter::isPossible (ScanData& scanData)
       return false;
     }
 
+  /* the adaptive scan visits the scan points in no fixed order and
+     writes its own summary: */
+  if (dynamic_cast<AdaptiveScanItemSequence*> (&scanData) != NULL)
+    return false;
+
   IndexableScanItem* item;
 
   for (ScanItemSequence::seq_t::const_iterator i = s->sequence.begin ();
@@ -28,6 +28,11 @@
 #include "Parsing.hpp"
 #include <cctype> /*: 'isalpha (.)', etc. */
 #include <cassert>
+#include <cstdio> /*: 'rename', 'remove' */
+#include <sstream>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h> /*: 'getpid' */
 
 #define DEBUG__PARSING_CPP 0
 
@@ -490,6 +495,285 @@ NEW_ALLOCATED(KeyIndexedTree::Node*)
 }
 
 
+/* Binary parse trees: each node starts with a tag character. Strings
+   are written as their length followed by the characters, counts as
+   plain unsigned integers, both in the native byte order (recorded
+   in the cache header). */
+namespace {
+  const char PARSE_TREE_MAGIC[] = "AnT parse tree 1";
+
+  const char RECORD_TAG = 'R';
+  const char TOKEN_TAG = 'T';
+  const char STRING_TAG = 'S';
+  const char LIST_TAG = 'L';
+
+  void writeCount (std::ostream& out, unsigned long n)
+  {
+    out.write (reinterpret_cast<const char*> (&n), sizeof (n));
+  }
+
+  bool readCount (istream& in, unsigned long& n)
+  {
+    return in.read (reinterpret_cast<char*> (&n), sizeof (n)).good ();
+  }
+
+  /* the order of the bytes of an unsigned long in memory, e.g.
+     "01234567" on little endian 64 bit machines: */
+  string byteOrderTag ()
+  {
+    unsigned long n = 0;
+    for (unsigned int i = 0; i < sizeof (n); ++i) {
+      n |= ((unsigned long) i) << (8 * i);
+    }
+
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*> (&n);
+    string result;
+    for (unsigned int i = 0; i < sizeof (n); ++i) {
+      result += (char) ('0' + bytes[i] % 10);
+    }
+    return result;
+  }
+
+  void writeString (std::ostream& out, const string& s)
+  {
+    writeCount (out, s.size ());
+    out.write (s.data (), s.size ());
+  }
+
+  bool readString (istream& in, string& s)
+  {
+    unsigned long n;
+    if (! readCount (in, n)) {
+      return false;
+    }
+
+    /* the count of a corrupt cache may be arbitrary, hence the string
+       is read in chunks: it never gets longer than the rest of the
+       cache and the read fails at its end (i.e. the cache is not
+       used) instead of allocating the count: */
+    char chunk[4096];
+    s.clear ();
+    while (n > 0) {
+      unsigned long k = (n < sizeof (chunk)) ? n : sizeof (chunk);
+      if (! in.read (chunk, k)) {
+	return false;
+      }
+      s.append (chunk, k);
+      n -= k;
+    }
+    return true;
+  }
+
+  void writeEntity (std::ostream& out, const AbstractEntity& e)
+  {
+    const Entity* entity = dynamic_cast<const Entity*> (&e);
+    if (entity != NULL) {
+      out.put (TOKEN_TAG);
+      writeString (out, entity->token);
+      return;
+    }
+
+    const EntityList* entityList = dynamic_cast<const EntityList*> (&e);
+    assert (entityList != NULL);
+
+    out.put (LIST_TAG);
+    writeCount (out, (entityList->entities).size ());
+    for ( EntityList::const_iterator i = (entityList->entities).begin ();
+	  i != (entityList->entities).end ();
+	  ++i ) {
+      writeEntity (out, **i);
+    }
+  }
+
+  NEW_ALLOCATED(AbstractEntity*) readEntity (istream& in)
+  {
+    char tag;
+    if (! in.get (tag)) {
+      return NULL;
+    }
+
+    if (tag == TOKEN_TAG) {
+      Entity* entity = new Entity ();
+      if (! readString (in, entity->token)) {
+	delete entity;
+	return NULL;
+      }
+      return entity;
+    }
+
+    if (tag != LIST_TAG) {
+      return NULL;
+    }
+
+    unsigned long n;
+    if (! readCount (in, n)) {
+      return NULL;
+    }
+
+    EntityList* entityList = new EntityList ();
+    for (unsigned long i = 0; i < n; ++i) {
+      AbstractEntity* e = readEntity (in);
+      if (e == NULL) {
+	delete entityList;
+	return NULL;
+      }
+      entityList->add (e);
+    }
+    return entityList;
+  }
+
+  NEW_ALLOCATED(KeyIndexedTree::Node*) readNode (istream& in)
+  {
+    char tag;
+    string key;
+    if ((! in.get (tag)) || (! readString (in, key))) {
+      return NULL;
+    }
+
+    if (tag == RECORD_TAG) {
+      unsigned long n;
+      if (! readCount (in, n)) {
+	return NULL;
+      }
+
+      KeyIndexedTree::LinkNode* result
+	= new KeyIndexedTree::LinkNode
+	( new KeyIndexedTree::LeafNode<void> (key) );
+      for (unsigned long i = 0; i < n; ++i) {
+	KeyIndexedTree::Node* child = readNode (in);
+	if (child == NULL) {
+	  delete result;
+	  return NULL;
+	}
+	result->add (child);
+      }
+      return result;
+    }
+
+    if ((tag != TOKEN_TAG) && (tag != STRING_TAG)) {
+      return NULL;
+    }
+
+    AbstractEntity* e = readEntity (in);
+    if (e == NULL) {
+      return NULL;
+    }
+
+    ParsedEntityNode* result = new ParsedEntityNode (key);
+    (result->data).reset (e);
+    if (tag == STRING_TAG) {
+      result->printPolicy = &stringAssignmentPrintPolicy;
+    }
+    return result;
+  }
+} /* namespace */
+
+
+void writeParseTree (std::ostream& out, const KeyIndexedTree::Node* aSubTree)
+{
+  assert (aSubTree != NULL);
+
+  const vector<KeyIndexedTree::Node*>* children
+    = aSubTree->getChildren ();
+  if (children != NULL) {
+    out.put (RECORD_TAG);
+    writeString (out, aSubTree->getKey ());
+    writeCount (out, children->size ());
+    for ( vector<KeyIndexedTree::Node*>::const_iterator i
+	    = children->begin ();
+	  i != children->end ();
+	  ++i ) {
+      /* recursive call here: */
+      writeParseTree (out, *i);
+    }
+    return;
+  }
+
+  const ParsedEntityNode* leafNode
+    = dynamic_cast<const ParsedEntityNode*> (aSubTree);
+  assert (leafNode != NULL);
+  assert ((leafNode->data).get () != NULL);
+
+  out.put ( (leafNode->printPolicy == &stringAssignmentPrintPolicy)
+	    ? STRING_TAG : TOKEN_TAG );
+  writeString (out, aSubTree->getKey ());
+  writeEntity (out, *(leafNode->data));
+}
+
+
+NEW_ALLOCATED(KeyIndexedTree::LinkNode*)
+  readParseTree (istream& in)
+{
+  KeyIndexedTree::Node* root = readNode (in);
+
+  KeyIndexedTree::LinkNode* result
+    = dynamic_cast<KeyIndexedTree::LinkNode*> (root);
+  if ((result == NULL) || (result->getKey () != KeyIndexedTree::ROOT_NODE_KEY)) {
+    delete root;
+    return NULL;
+  }
+  return result;
+}
+
+
+NEW_ALLOCATED(KeyIndexedTree::LinkNode*)
+  createCachedParseTree ( const string& fileName,
+			  const string& cacheFileName )
+{
+  struct stat fileStat;
+  if ( cacheFileName.empty ()
+       || (stat (fileName.c_str (), &fileStat) != 0) ) {
+    std::ifstream f (fileName.c_str ());
+    return createParseTree (f); /*: reports the error */
+  }
+
+  /* the cache header identifies the parsed file, so that a changed
+     file or a cache of another file is never used, and the binary
+     format of the counts, so that a cache written on another
+     architecture is never used: */
+  std::ostringstream header;
+  header << PARSE_TREE_MAGIC << '\n'
+	 << sizeof (unsigned long) << ' ' << byteOrderTag () << '\n'
+	 << fileName << '\n'
+	 << fileStat.st_size << ' '
+	 << fileStat.st_mtime << '\n';
+
+  std::ifstream cache (cacheFileName.c_str (), std::ios::binary);
+  if (cache) {
+    string cachedHeader (header.str ().size (), '\0');
+    if ( cache.read (&(cachedHeader[0]), cachedHeader.size ())
+	 && (cachedHeader == header.str ()) ) {
+      KeyIndexedTree::LinkNode* result = readParseTree (cache);
+      if (result != NULL) {
+	return result;
+      }
+    }
+  }
+
+  std::ifstream f (fileName.c_str ());
+  KeyIndexedTree::LinkNode* result = createParseTree (f);
+
+  /* write to a temporary file first and rename it, so that processes
+     started concurrently never read a partially written cache: */
+  std::ostringstream tmpFileName;
+  tmpFileName << cacheFileName << '.' << getpid ();
+
+  std::ofstream out (tmpFileName.str ().c_str (), std::ios::binary);
+  if (out) {
+    out << header.str ();
+    writeParseTree (out, result);
+    out.close ();
+
+    if ( (! out)
+	 || (rename (tmpFileName.str ().c_str (), cacheFileName.c_str ()) != 0) ) {
+      remove (tmpFileName.str ().c_str ());
+    }
+  }
+
+  return result;
+}
+
+
 Entity::Entity () : token ("") {}
 
 Entity::Entity (char* s) : token (s) {}
@@ -321,6 +321,31 @@ NEW_ALLOCATED(KeyIndexedTree::Node*)
 NEW_ALLOCATED(KeyIndexedTree::LinkNode*)
   createParseTree ( istream& f, bool throwOnParseError = true );
 
+/**
+ * Writes a parse tree in a compact binary form, which can be read
+ * back by 'readParseTree' without parsing.
+ * */
+void writeParseTree (std::ostream& out, const KeyIndexedTree::Node* aSubTree);
+
+/**
+ * Reads a parse tree written by 'writeParseTree'.
+ *
+ * @return the root node, or NULL if the stream is malformed. */
+NEW_ALLOCATED(KeyIndexedTree::LinkNode*)
+  readParseTree (istream& in);
+
+/**
+ * Same as 'createParseTree' for the given file, but the parse tree
+ * is cached in binary form in 'cacheFileName'. The cache is used
+ * as long as the size and modification time of the file agree with
+ * the ones stored in the cache, otherwise the file is parsed and the
+ * cache is rewritten (if possible). An empty 'cacheFileName'
+ * disables the cache.
+ * */
+NEW_ALLOCATED(KeyIndexedTree::LinkNode*)
+  createCachedParseTree ( const string& fileName,
+			  const string& cacheFileName );
+
 
 template <class T>
 void leafNodeTo (const KeyIndexedTree::Node* n, T& out)
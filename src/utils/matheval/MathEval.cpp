@@ -70,7 +70,11 @@ namespace MathEval {
     : FunctionData (*funcData_),
       value (NULL),
       deallocateValue (false),
-      children (NULL)
+      children (NULL),
+      seed (NULL),
+      tangent (NULL),
+      tangentSize (0),
+      derivativeRule (-1)
   {
     if (numberOfArguments > 0) {
       deallocateValue = true;
@@ -117,6 +121,7 @@ namespace MathEval {
 #else
     delete[] children;
 #endif
+    delete[] tangent;
   }
 
 
@@ -156,6 +161,13 @@ namespace MathEval {
   }
 
 
+  void Node::rebindTangent (const double* aSeed)
+  {
+    assert (numberOfArguments == 0);
+    seed = aSeed;
+  }
+
+
   string Node::generateCode ()
   {
     /* 
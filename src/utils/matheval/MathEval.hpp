@@ -21,6 +21,20 @@ namespace MathEval {
 
 
   enum FuncAssoc {NONE, LEFT, RIGHT};
+
+  /* derivative rules of the registered functions, see
+     MathEvalTangent.cpp: */
+  enum DerivativeRule {
+    /* unknown function, only constant arguments possible: */
+    NO_RULE,
+    /* derivative zero almost everywhere (ceil, step, etc.): */
+    PIECEWISE_CONSTANT,
+    PLUS, MINUS, TIMES, DIVIDE, POW, SQRT, EXP,
+    LN, LD, LG, LOG_BX,
+    SIN, COS, TAN, ASIN, ACOS, ATAN, ATAN2,
+    SINH, COSH, TANH,
+    FABS, FMOD, SINC
+  };
   enum NodeType {PREFIX_OP, INFIX_OP, POSTFIX_OP, 
 		 FUNCTION, BOUNDED, CONSTANT, UNDEFINED};
 
@@ -87,6 +101,15 @@ namespace MathEval {
   public:
     Node** children;
 
+  public:
+    /* forward mode automatic differentiation (see MathEvalTangent.cpp):
+       'seed' is the tangent of a bounded node (NULL: constant),
+       'tangent' the buffer of an inner node. */
+    const double* seed;
+    double* tangent;
+    unsigned int tangentSize;
+    int derivativeRule;
+
   public:
     static
     Node* newNode (const FunctionData* funcData_);
@@ -108,6 +131,16 @@ namespace MathEval {
 
     double evaluate ();
 
+    DerivativeRule getDerivativeRule ();
+
+    void rebindTangent (const double* aSeed);
+
+    /** evaluates the node and its tangent in 'n' directions at once.
+	@param result the value of the node
+	@return the tangent (length n), NULL if the node is constant
+	with respect to all seeded variables */
+    const double* evaluateTangent (unsigned int n, double& result);
+
     // inline
     template <const unsigned int i>
     double evaluateChild ()
@@ -0,0 +1,650 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+#include <iostream>
+using std::cerr;
+using std::endl;
+
+#include "../debug/Error.hpp" /* Error::Exit */
+#include "MathEvalOptimizer.hpp"
+
+namespace MathEval {
+  namespace {
+    /* see 'setUnsafeSimplification': */
+    bool isUnsafeSimplification = false;
+
+    bool isConstant (Node* aNode)
+    {
+      return aNode->parsedFuncType == CONSTANT;
+    }
+
+    bool isConstant (Node* aNode, double aConst)
+    {
+      return (aNode->parsedFuncType == CONSTANT)
+	&& (*(aNode->value) == aConst);
+    }
+
+    Node* simplifyNode (Node* aNode);
+
+    template<const NodeType theFuncType>
+    Node* newNode (const string& aFuncName, Node* a, Node* b = NULL)
+    {
+      Node* result = newFunctionNode<theFuncType> (aFuncName);
+      assert (result != NULL);
+
+      result->children[0] = a;
+      if (b != NULL) {
+	assert (result->numberOfArguments == 2);
+	result->children[1] = b;
+      }
+
+      return simplifyNode (result);
+    }
+
+    Node* plus (Node* a, Node* b)
+    {
+      return newNode<INFIX_OP> ("+(double,double)", a, b);
+    }
+
+    Node* minus (Node* a, Node* b)
+    {
+      return newNode<INFIX_OP> ("-(double,double)", a, b);
+    }
+
+    Node* times (Node* a, Node* b)
+    {
+      return newNode<INFIX_OP> ("*(double,double)", a, b);
+    }
+
+    Node* divide (Node* a, Node* b)
+    {
+      return newNode<INFIX_OP> ("/(double,double)", a, b);
+    }
+
+    Node* power (Node* a, Node* b)
+    {
+      return newNode<INFIX_OP> ("^(double,double)", a, b);
+    }
+
+    Node* negate (Node* a)
+    {
+      return newNode<PREFIX_OP> ("-(double)", a);
+    }
+
+    Node* function (const string& aFuncName, Node* a)
+    {
+      return newNode<FUNCTION> (aFuncName + "(double)", a);
+    }
+
+    Node* constant (double aConst)
+    {
+      return newConstantNode (aConst);
+    }
+
+
+    /* algebraic simplification of a single node, whose children are
+       simplified already: */
+    Node* simplifyNode (Node* aNode)
+    {
+      if (aNode->numberOfArguments == 0) {
+	return aNode;
+      }
+
+      bool allConstant = true;
+      for (unsigned int i = 0; i < aNode->numberOfArguments; ++i) {
+	if (! isConstant (aNode->children[i])) {
+	  allConstant = false;
+	}
+      }
+
+      if (allConstant) {
+	return newConstantNode (aNode->evaluate ());
+      }
+
+      Node* a = aNode->children[0];
+      Node* b = (aNode->numberOfArguments > 1) ? aNode->children[1] : NULL;
+
+      switch (aNode->getDerivativeRule ()) {
+      case PLUS:
+	if (b == NULL) {
+	  return a;
+	}
+	/* -0 + 0 = +0: */
+	if (isUnsafeSimplification && isConstant (a, 0.0)) {
+	  return b;
+	}
+	if (isUnsafeSimplification && isConstant (b, 0.0)) {
+	  return a;
+	}
+	break;
+      case MINUS:
+	if (b == NULL) {
+	  /* - - x = x */
+	  if ( (a->getDerivativeRule () == MINUS)
+	       && (a->numberOfArguments == 1) ) {
+	    return a->children[0];
+	  }
+	  break;
+	}
+	if (isUnsafeSimplification && isConstant (b, 0.0)) {
+	  return a;
+	}
+	/* 0 - 0 = +0: */
+	if (isUnsafeSimplification && isConstant (a, 0.0)) {
+	  return negate (b);
+	}
+	break;
+      case TIMES:
+	/* inf * 0 = nan, -1 * 0 = -0: */
+	if ( isUnsafeSimplification
+	     && (isConstant (a, 0.0) || isConstant (b, 0.0)) ) {
+	  return constant (0.0);
+	}
+	if (isConstant (a, 1.0)) {
+	  return b;
+	}
+	if (isConstant (b, 1.0)) {
+	  return a;
+	}
+	if (isConstant (a, -1.0)) {
+	  return negate (b);
+	}
+	if (isConstant (b, -1.0)) {
+	  return negate (a);
+	}
+	break;
+      case DIVIDE:
+	if (isConstant (b, 1.0)) {
+	  return a;
+	}
+	/* 0 / 0 = nan, 0 / -1 = -0: */
+	if (isUnsafeSimplification && isConstant (a, 0.0)) {
+	  return constant (0.0);
+	}
+	break;
+      case POW:
+	if (isConstant (b, 1.0)) {
+	  return a;
+	}
+	if (isConstant (b, 0.0)) {
+	  return constant (1.0);
+	}
+	break;
+      default:
+	break;
+      }
+
+      return aNode;
+    }
+
+
+    Node* simplifyTree (Node* aNode, map<Node*, Node*>& simplified)
+    {
+      if (aNode->numberOfArguments == 0) {
+	return aNode;
+      }
+
+      map<Node*, Node*>::iterator i = simplified.find (aNode);
+      if (i != simplified.end ()) {
+	return i->second;
+      }
+
+      Node* result = Node::newNode (aNode);
+      for (unsigned int k = 0; k < aNode->numberOfArguments; ++k) {
+	result->children[k]
+	  = simplifyTree (aNode->children[k], simplified);
+      }
+      result = simplifyNode (result);
+
+      simplified[aNode] = result;
+      return result;
+    }
+
+
+    /* derivative of 'aNode', whose derivatives of the children are
+       'da' and 'db' (NULL: unknown, i.e. no rule). 'aNode' itself is
+       used as its value, e.g. (exp (a))' = exp (a) * a'. */
+    Node* differentiateNode (Node* aNode, Node* da, Node* db)
+    {
+      Node* a = aNode->children[0];
+      Node* b = (aNode->numberOfArguments > 1) ? aNode->children[1] : NULL;
+
+      switch (aNode->getDerivativeRule ()) {
+      case PLUS:
+	return (b == NULL) ? da : plus (da, db);
+      case MINUS:
+	return (b == NULL) ? negate (da) : minus (da, db);
+      case TIMES:
+	return plus (times (da, b), times (a, db));
+      case DIVIDE:
+	/* (a/b)' = (a' - (a/b) b') / b */
+	return divide (minus (da, times (aNode, db)), b);
+      case POW:
+	if (isConstant (db, 0.0)) {
+	  return times (times (b, power (a, minus (b, constant (1.0)))),
+			da);
+	}
+	/* (a^b)' = a^b (b' ln (a) + b a' / a) */
+	return times ( aNode,
+		       plus ( times (db, function ("ln", a)),
+			      divide (times (b, da), a) ) );
+      case SQRT:
+	return divide (da, times (constant (2.0), aNode));
+      case EXP:
+	return times (aNode, da);
+      case LN:
+	return divide (da, a);
+      case LD:
+	return divide (da, times (a, constant (std::log (2.0))));
+      case LG:
+	return divide (da, times (a, constant (std::log (10.0))));
+      case LOG_BX:
+	/* log (a, b) = ln (b) / ln (a) */
+	return divide ( minus ( divide (db, b),
+				times (aNode, divide (da, a)) ),
+			function ("ln", a) );
+      case SIN:
+	return times (function ("cos", a), da);
+      case COS:
+	return negate (times (function ("sin", a), da));
+      case TAN:
+	return times (plus (constant (1.0), times (aNode, aNode)), da);
+      case ASIN:
+	return divide ( da,
+			function ("sqrt",
+				  minus (constant (1.0), times (a, a))) );
+      case ACOS:
+	return negate (divide ( da,
+				function ("sqrt",
+					  minus (constant (1.0),
+						 times (a, a))) ));
+      case ATAN:
+	return divide (da, plus (constant (1.0), times (a, a)));
+      case ATAN2:
+	return divide ( minus (times (b, da), times (a, db)),
+			plus (times (a, a), times (b, b)) );
+      case SINH:
+	return times (function ("cosh", a), da);
+      case COSH:
+	return times (function ("sinh", a), da);
+      case TANH:
+	return times (minus (constant (1.0), times (aNode, aNode)), da);
+      case FABS:
+	/* 2 step (a) - 1, i.e. the derivative 1 at a = 0 as in the
+	   tangent evaluation (not 'sign (a)', which is 0 there) */
+	return times ( minus (times (constant (2.0), function ("step", a)),
+			      constant (1.0)),
+		       da );
+      case FMOD:
+	/* fmod (a, b) = a - trunc (a/b) b */
+	return minus (da, times (divide (minus (a, aNode), b), db));
+      default:
+	/* SINC and unknown functions: */
+	return NULL;
+      }
+    }
+
+
+    Node* differentiateTree ( Node* aNode,
+			      const set<Node*>& variables,
+			      map<Node*, Node*>& derivatives )
+    {
+      if (aNode->numberOfArguments == 0) {
+	return constant (variables.count (aNode) > 0 ? 1.0 : 0.0);
+      }
+
+      map<Node*, Node*>::iterator i = derivatives.find (aNode);
+      if (i != derivatives.end ()) {
+	return i->second;
+      }
+
+      Node* result = NULL;
+      bool isKnown = true;
+      bool isZero = true;
+      Node* d[2] = {NULL, NULL};
+      for (unsigned int k = 0; k < aNode->numberOfArguments; ++k) {
+	Node* dk = differentiateTree (aNode->children[k],
+				      variables,
+				      derivatives);
+	if (k < 2) {
+	  d[k] = dk;
+	}
+	if (dk == NULL) {
+	  isKnown = false;
+	} else if (! isConstant (dk, 0.0)) {
+	  isZero = false;
+	}
+      }
+
+      if (aNode->getDerivativeRule () == PIECEWISE_CONSTANT) {
+	result = constant (0.0);
+      } else if (isKnown && isZero) {
+	result = constant (0.0);
+      } else if (isKnown && (aNode->numberOfArguments <= 2)) {
+	result = differentiateNode (aNode, d[0], d[1]);
+      }
+
+      derivatives[aNode] = result;
+      return result;
+    }
+  } /* namespace */
+
+
+  void setUnsafeSimplification (bool isOn)
+  {
+    isUnsafeSimplification = isOn;
+  }
+
+
+  Node* simplify (Node* aNode)
+  {
+    map<Node*, Node*> simplified;
+
+    return simplifyTree (aNode, simplified);
+  }
+
+
+  Node* differentiate (Node* aNode, const set<Node*>& variables)
+  {
+    map<Node*, Node*> derivatives;
+
+    return differentiateTree (aNode, variables, derivatives);
+  }
+} /* namespace MathEval */
+
+
+namespace {
+  using MathEval::Node;
+
+  enum Dependency {CONSTANT_DEPENDENCY,
+		   PARAMETER_DEPENDENCY,
+		   STATE_DEPENDENCY};
+
+  unsigned int countOperations (Node* aNode)
+  {
+    unsigned int result = 0;
+
+    if (aNode->numberOfArguments > 0) {
+      result = 1;
+      for (unsigned int k = 0; k < aNode->numberOfArguments; ++k) {
+	result += countOperations (aNode->children[k]);
+      }
+    }
+
+    return result;
+  }
+
+  /* merges equal subtrees (hash consing), the children of the inner
+     nodes are replaced by the representatives. Inner nodes have to be
+     owned by the caller, i.e. created by 'simplify'. */
+  Node* unify ( Node* aNode,
+		map<string, Node*>& representatives,
+		map<Node*, Node*>& unified )
+  {
+    map<Node*, Node*>::iterator i = unified.find (aNode);
+    if (i != unified.end ()) {
+      return i->second;
+    }
+
+    string key;
+    if (aNode->parsedFuncType == MathEval::CONSTANT) {
+      char buffer[32];
+      sprintf (buffer, "%.17g", *(aNode->value));
+      key = string ("#") + buffer;
+    } else if (aNode->numberOfArguments == 0) {
+      key = string ("$") + aNode->parsedFunc;
+    } else {
+      vector<Node*> children;
+      for (unsigned int k = 0; k < aNode->numberOfArguments; ++k) {
+	aNode->children[k]
+	  = unify (aNode->children[k], representatives, unified);
+	children.push_back (aNode->children[k]);
+      }
+
+      /* commutative operators: */
+      if ( (aNode->numberOfArguments == 2)
+	   && ( (aNode->getDerivativeRule () == MathEval::PLUS)
+		|| (aNode->getDerivativeRule () == MathEval::TIMES) ) ) {
+	std::sort (children.begin (), children.end ());
+      }
+
+      key = aNode->parsedFunc + aNode->argListDef
+	+ toString (static_cast<int> (aNode->parsedFuncType));
+      for (unsigned int k = 0; k < children.size (); ++k) {
+	char buffer[32];
+	sprintf (buffer, " %p", static_cast<void*> (children[k]));
+	key += buffer;
+      }
+    }
+
+    map<string, Node*>::iterator r = representatives.find (key);
+    Node* result = aNode;
+    if (r == representatives.end ()) {
+      representatives[key] = aNode;
+    } else {
+      result = r->second;
+    }
+
+    unified[aNode] = result;
+    return result;
+  }
+} /* namespace */
+
+
+MathEvalOptimizer::MathEvalOptimizer () :
+  isPrepared (false),
+  operationsBefore (0),
+  operationsAfter (0)
+{}
+
+void
+MathEvalOptimizer::optimize (const vector<Node*>& someExpressions,
+			     const set<string>& stateVariableNames)
+{
+  expressions.clear ();
+  parameterTemporaries.clear ();
+  stateTemporaries.clear ();
+  parameters.clear ();
+  parameterValues.clear ();
+  isPrepared = false;
+
+  operationsBefore = 0;
+  for (unsigned int i = 0; i < someExpressions.size (); ++i) {
+    operationsBefore += countOperations (someExpressions[i]);
+  }
+
+  /* constant folding and common subexpressions: */
+  map<Node*, Node*> simplified;
+  map<string, Node*> representatives;
+  map<Node*, Node*> unified;
+  for (unsigned int i = 0; i < someExpressions.size (); ++i) {
+    Node* e = MathEval::simplifyTree (someExpressions[i], simplified);
+    expressions.push_back (unify (e, representatives, unified));
+  }
+
+  /* post order of all nodes, number of references and dependencies: */
+  vector<Node*> nodes;
+  map<Node*, unsigned int> references;
+  map<Node*, bool> isReferencedByState;
+  map<Node*, Dependency> dependencies;
+
+  vector<std::pair<Node*, unsigned int> > stack;
+  for (unsigned int i = 0; i < expressions.size (); ++i) {
+    ++references[expressions[i]];
+    isReferencedByState[expressions[i]] = true;
+
+    if (dependencies.find (expressions[i]) != dependencies.end ()) {
+      continue;
+    }
+
+    dependencies[expressions[i]] = CONSTANT_DEPENDENCY; /* visited */
+    stack.push_back (std::make_pair (expressions[i], 0u));
+    while (! stack.empty ()) {
+      Node* n = stack.back ().first;
+      unsigned int k = stack.back ().second;
+
+      if (k < n->numberOfArguments) {
+	++(stack.back ().second);
+	Node* child = n->children[k];
+	++references[child];
+	if (dependencies.find (child) == dependencies.end ()) {
+	  dependencies[child] = CONSTANT_DEPENDENCY; /* visited */
+	  stack.push_back (std::make_pair (child, 0u));
+	}
+	continue;
+      }
+
+      Dependency d = CONSTANT_DEPENDENCY;
+      if (n->parsedFuncType == MathEval::BOUNDED) {
+	if (stateVariableNames.count (n->parsedFunc) > 0) {
+	  d = STATE_DEPENDENCY;
+	} else {
+	  d = PARAMETER_DEPENDENCY;
+	  parameters.push_back (n);
+	}
+      }
+      for (unsigned int j = 0; j < n->numberOfArguments; ++j) {
+	d = std::max (d, dependencies[n->children[j]]);
+      }
+      dependencies[n] = d;
+
+      if (d == STATE_DEPENDENCY) {
+	for (unsigned int j = 0; j < n->numberOfArguments; ++j) {
+	  isReferencedByState[n->children[j]] = true;
+	}
+      }
+
+      nodes.push_back (n);
+      stack.pop_back ();
+    }
+  }
+
+  /* temporaries: maximal subtrees depending on parameters only, and
+     shared subtrees depending on the state: */
+  map<Node*, Node*> temporaries;
+  for (unsigned int i = 0; i < nodes.size (); ++i) {
+    Node* n = nodes[i];
+    if (n->numberOfArguments == 0) {
+      continue;
+    }
+
+    if (dependencies[n] == PARAMETER_DEPENDENCY) {
+      if (isReferencedByState[n] || (references[n] > 1)) {
+	parameterTemporaries.push_back (n);
+      } else {
+	continue;
+      }
+    } else if ( (dependencies[n] == STATE_DEPENDENCY)
+		&& (references[n] > 1) ) {
+      stateTemporaries.push_back (n);
+    } else {
+      continue;
+    }
+
+    temporaries[n] = MathEval::newBoundedNode
+      ( *(n->value), string ("@") + toString (temporaries.size ()) );
+  }
+
+  for (unsigned int i = 0; i < nodes.size (); ++i) {
+    Node* n = nodes[i];
+    for (unsigned int k = 0; k < n->numberOfArguments; ++k) {
+      map<Node*, Node*>::iterator t = temporaries.find (n->children[k]);
+      if (t != temporaries.end ()) {
+	n->children[k] = t->second;
+      }
+    }
+  }
+
+  for (unsigned int i = 0; i < expressions.size (); ++i) {
+    map<Node*, Node*>::iterator t = temporaries.find (expressions[i]);
+    if (t != temporaries.end ()) {
+      expressions[i] = t->second;
+    }
+  }
+
+  parameterValues.resize (parameters.size ());
+
+  operationsAfter = 0;
+  for (unsigned int i = 0; i < stateTemporaries.size (); ++i) {
+    operationsAfter += countOperations (stateTemporaries[i]);
+  }
+  for (unsigned int i = 0; i < expressions.size (); ++i) {
+    operationsAfter += countOperations (expressions[i]);
+  }
+}
+
+bool
+MathEvalOptimizer::isEmpty () const
+{
+  return expressions.empty ();
+}
+
+Node*
+MathEvalOptimizer::getExpression (unsigned int i)
+{
+  assert (i < expressions.size ());
+  return expressions[i];
+}
+
+void
+MathEvalOptimizer::prepare ()
+{
+  bool isChanged = ! isPrepared;
+
+  for (unsigned int i = 0; i < parameters.size (); ++i) {
+    if (*(parameters[i]->value) != parameterValues[i]) {
+      parameterValues[i] = *(parameters[i]->value);
+      isChanged = true;
+    }
+  }
+
+  if (isChanged) {
+    for (unsigned int i = 0; i < parameterTemporaries.size (); ++i) {
+      *(parameterTemporaries[i]->value)
+	= parameterTemporaries[i]->evaluate ();
+    }
+    isPrepared = true;
+  }
+
+  for (unsigned int i = 0; i < stateTemporaries.size (); ++i) {
+    *(stateTemporaries[i]->value) = stateTemporaries[i]->evaluate ();
+  }
+}
+
+unsigned int
+MathEvalOptimizer::getOperationsBefore () const
+{
+  return operationsBefore;
+}
+
+unsigned int
+MathEvalOptimizer::getOperationsAfter () const
+{
+  return operationsAfter;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+#ifndef MATH_EVAL_OPTIMIZER_HPP
+#define MATH_EVAL_OPTIMIZER_HPP
+
+#include <set>
+using std::set;
+
+#include <vector>
+using std::vector;
+
+#include "MathEval.hpp"
+
+namespace MathEval {
+  /** if on, 'simplify' and 'differentiate' use also the rules
+      x+0 = x, 0-x = -x, x*0 = 0 and 0/x = 0, which do not hold for
+      non-finite x and signed zeros. Off by default. */
+  void setUnsafeSimplification (bool isOn);
+
+  /** constant folding and algebraic simplification (x*1, x^1, --x,
+      etc.) of the tree 'aNode'. The given tree is not changed, the
+      result shares its leaves only. */
+  Node* simplify (Node* aNode);
+
+  /** symbolic derivative of 'aNode' with respect to the variable
+      given by its bounded nodes (more than one, if the variable has
+      more than one name, e.g. 'x' and 's[0]').
+      @return the simplified derivative (sharing subtrees with
+      'aNode'), NULL if a function without derivative rule depends on
+      the variable */
+  Node* differentiate (Node* aNode, const set<Node*>& variables);
+} /* namespace MathEval */
+
+
+/**
+ * Optimization of a set of expressions, which are evaluated together
+ * (e.g. the equations of motion of a dynamical system):
+ * <UL>
+ * <LI> constant folding and algebraic simplification, </LI>
+ * <LI> common subexpression elimination over all expressions: equal
+ *      subtrees are merged and evaluated once, </LI>
+ * <LI> hoisting of subtrees, which depend on the parameters only:
+ *      they are evaluated again only if a parameter has changed,
+ *      i.e. once per scan point. </LI>
+ * </UL>
+ * The shared and the hoisted subtrees are evaluated into temporaries
+ * by 'prepare', their parents read them via bounded nodes.
+ * Hence, 'prepare' must be called after binding the state variables
+ * and before evaluating the optimized expressions.
+ */
+class MathEvalOptimizer
+{
+private:
+  vector<MathEval::Node*> expressions;
+
+  /* temporaries in the order of evaluation */
+  vector<MathEval::Node*> parameterTemporaries;
+  vector<MathEval::Node*> stateTemporaries;
+
+  /* the bounded nodes, on which parameterTemporaries depend, and
+     their values at the last evaluation */
+  vector<MathEval::Node*> parameters;
+  vector<double> parameterValues;
+  bool isPrepared;
+
+  unsigned int operationsBefore;
+  unsigned int operationsAfter;
+
+public:
+  MathEvalOptimizer ();
+
+  /** optimize the given expressions, bounded nodes with names not
+      contained in 'stateVariableNames' are assumed to be
+      parameters. The given trees are not changed. */
+  void optimize (const vector<MathEval::Node*>& someExpressions,
+		 const set<string>& stateVariableNames);
+
+  bool isEmpty () const;
+
+  /** @return the optimized expression i */
+  MathEval::Node* getExpression (unsigned int i);
+
+  /** evaluate the temporaries, the hoisted ones only if a parameter
+      has changed since the last call. */
+  void prepare ();
+
+  /** number of operations per evaluation of all expressions, as
+      given and after the optimization */
+  unsigned int getOperationsBefore () const;
+  unsigned int getOperationsAfter () const;
+};
+
+#endif
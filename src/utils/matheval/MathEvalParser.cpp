@@ -75,6 +75,7 @@ MathEvalParser::MathEvalParser (const string& aStr)
   /* set default values */
   hasEvaluationTree = false;
   rootNode = createEvaluationTree (aStr);
+  evaluationRoot = rootNode;
     
   /* creates the Instance of the Parser */
   //theParser = new MathEvalParser();    
@@ -986,9 +987,49 @@ void MathEvalParser::bindVariables ()
    Output       ---
 **/
 double MathEvalParser::evaluate ()
+{
+  assert(evaluationRoot != NULL);
+  return evaluationRoot->evaluate();
+}
+
+
+/**
+   Name         evaluateTangent
+   Description  evaluates the function and its tangent in 'n'
+                directions (forward mode automatic differentiation)
+   Input        n, the number of directions
+   Output       the tangent, NULL if constant; the value in 'result'
+**/
+const double* MathEvalParser::evaluateTangent (unsigned int n,
+					       double& result)
 {
   assert(rootNode != NULL);
-  return rootNode->evaluate();
+  return rootNode->evaluateTangent(n, result);
+}
+
+
+/**
+   Name         getRootNode
+   Description  the evaluation tree as parsed
+   Input        ---
+   Output       the root Node
+**/
+MathEval::Node* MathEvalParser::getRootNode ()
+{
+  return rootNode;
+}
+
+
+/**
+   Name         setEvaluationRoot
+   Description  replaces the evaluation tree used by 'evaluate'
+   Input        the root Node of an equivalent tree
+   Output       ---
+**/
+void MathEvalParser::setEvaluationRoot (MathEval::Node* aNode)
+{
+  assert(aNode != NULL);
+  evaluationRoot = aNode;
 }
 
 
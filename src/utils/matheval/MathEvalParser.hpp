@@ -74,6 +74,10 @@ class MathEvalParser {
 private:
   /* the root Node from the resulting evaluation tree*/
   MathEval::Node* rootNode;
+
+  /* the root Node to be evaluated: the rootNode itself or an optimized
+     tree, see MathEvalOptimizer */
+  MathEval::Node* evaluationRoot;
   /* the Instance of the Parser*/
   MathEvalParser* theParser;
   /* a Evaluation Tree is already generated*/
@@ -250,6 +254,34 @@ public:
   **/
   double evaluate ();
 
+  /**
+     Name         evaluateTangent
+     Description  evaluates the function and its derivative in 'n'
+                  directions, which are given by the seeds of the
+                  bounded nodes (see MathEval::Node::rebindTangent)
+     Input        n, the number of directions
+     Output       the tangent, NULL if the function does not depend
+                  on any seeded variable; the value in 'result'
+  **/
+  const double* evaluateTangent (unsigned int n, double& result);
+
+  /**
+     Name         getRootNode
+     Description  the evaluation tree as parsed
+     Input        ---
+     Output       the root Node
+  **/
+  MathEval::Node* getRootNode ();
+
+  /**
+     Name         setEvaluationRoot
+     Description  replaces the evaluation tree used by 'evaluate', for
+                  instance by an optimized one (see MathEvalOptimizer)
+     Input        the root Node of an equivalent tree
+     Output       ---
+  **/
+  void setEvaluationRoot (MathEval::Node* aNode);
+
 
 
   /**
@@ -0,0 +1,296 @@
+/*
+ * Copyright (C) 1999-2004 the AnT project,
+ * Department of Image Understanding,
+ * University of Stuttgart, Germany.
+ *
+ * This file is part of AnT,
+ * a simulation and analysis tool for dynamical systems.
+ *
+ * AnT is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * AnT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA
+ *
+ * $Id$
+ *
+ */
+
+/* Forward mode automatic differentiation of evaluation trees: each
+   node is evaluated together with its tangent, i.e. its derivatives
+   in 'n' directions at once. The directions are given by the seeds
+   of the bounded nodes (usually the state variables, seeded with the
+   unit vectors), nodes without seed are constant. */
+
+#include <cmath>
+#include <iostream>
+using std::cerr;
+using std::endl;
+
+#include "../debug/Error.hpp" /* Error::Exit */
+#include "MathEval.hpp"
+#include "ParserFunctions.hpp"
+
+namespace MathEval {
+  namespace {
+    map<string, DerivativeRule>& derivativeRules ()
+    {
+      static map<string, DerivativeRule> result;
+
+      if (result.empty ()) {
+	/* keys are the called functions (see MathEvalRegistry.m4): */
+	result["+"] = PLUS;
+	result["-"] = MINUS;
+	result["*"] = TIMES;
+	result["/"] = DIVIDE;
+	result["std::pow"] = POW;
+	result["std::sqrt"] = SQRT;
+	result["std::exp"] = EXP;
+	result["std::log"] = LN;
+	result["ld"] = LD;
+	result["std::log10"] = LG;
+	result["log_bx"] = LOG_BX;
+	result["std::sin"] = SIN;
+	result["std::cos"] = COS;
+	result["std::tan"] = TAN;
+	result["std::asin"] = ASIN;
+	result["std::acos"] = ACOS;
+	result["std::atan"] = ATAN;
+	result["std::atan2"] = ATAN2;
+	result["std::sinh"] = SINH;
+	result["std::cosh"] = COSH;
+	result["std::tanh"] = TANH;
+	result["std::fabs"] = FABS;
+	result["std::fmod"] = FMOD;
+	result["sinc"] = SINC;
+
+	result["std::ceil"] = PIECEWISE_CONSTANT;
+	result["std::floor"] = PIECEWISE_CONSTANT;
+	result["step"] = PIECEWISE_CONSTANT;
+	result["sign"] = PIECEWISE_CONSTANT;
+	result["interval"] = PIECEWISE_CONSTANT;
+	result["int_mod"] = PIECEWISE_CONSTANT;
+	result["int_div"] = PIECEWISE_CONSTANT;
+	result["factorial"] = PIECEWISE_CONSTANT;
+      }
+
+      return result;
+    }
+  } /* namespace */
+
+
+  DerivativeRule Node::getDerivativeRule ()
+  {
+    if (derivativeRule < 0) {
+      map<string, DerivativeRule>::const_iterator i
+	= derivativeRules ().find (calledFunc);
+
+      if ( (numberOfArguments == 0) || (i == derivativeRules ().end ()) ) {
+	derivativeRule = NO_RULE;
+      } else {
+	derivativeRule = i->second;
+      }
+    }
+
+    return static_cast<DerivativeRule> (derivativeRule);
+  }
+
+
+  const double* Node::evaluateTangent (unsigned int n, double& result)
+  {
+    if (numberOfArguments == 0) {
+      result = *value;
+      return seed;
+    }
+
+    if (getDerivativeRule () == PIECEWISE_CONSTANT) {
+      result = evaluate ();
+      return NULL;
+    }
+
+    if (derivativeRule == NO_RULE) {
+      double dummy;
+      for (unsigned int i = 0; i < numberOfArguments; ++i) {
+	if (children[i]->evaluateTangent (n, dummy) != NULL) {
+	  cerr << "MathEval: the derivative of the function '"
+	       << parsedFunc
+	       << "' is not known."
+	       << endl << Error::Exit;
+	}
+      }
+
+      result = evaluate ();
+      return NULL;
+    }
+
+    assert (numberOfArguments <= 2);
+
+    double a = 0.0;
+    double b = 0.0;
+    const double* da = children[0]->evaluateTangent (n, a);
+    const double* db = NULL;
+    if (numberOfArguments > 1) {
+      db = children[1]->evaluateTangent (n, b);
+    }
+
+    /* partial derivatives with respect to both arguments: */
+    double fa = 0.0;
+    double fb = 0.0;
+
+    switch (derivativeRule) {
+    case PLUS:
+      if (numberOfArguments == 1) {
+	result = a;
+      } else {
+	result = a + b;
+      }
+      fa = 1.0;
+      fb = 1.0;
+      break;
+    case MINUS:
+      if (numberOfArguments == 1) {
+	result = -a;
+	fa = -1.0;
+      } else {
+	result = a - b;
+	fa = 1.0;
+	fb = -1.0;
+      }
+      break;
+    case TIMES:
+      result = a * b;
+      fa = b;
+      fb = a;
+      break;
+    case DIVIDE:
+      result = a / b;
+      fa = 1.0 / b;
+      fb = -result / b;
+      break;
+    case POW:
+      result = std::pow (a, b);
+      fa = b * std::pow (a, b - 1.0);
+      /* avoid NaNs for negative bases with constant exponents: */
+      if (db != NULL) {
+	fb = result * std::log (a);
+      }
+      break;
+    case SQRT:
+      result = std::sqrt (a);
+      fa = 0.5 / result;
+      break;
+    case EXP:
+      result = std::exp (a);
+      fa = result;
+      break;
+    case LN:
+      result = std::log (a);
+      fa = 1.0 / a;
+      break;
+    case LD:
+      result = ld (a);
+      fa = 1.0 / (a * std::log (2.0));
+      break;
+    case LG:
+      result = std::log10 (a);
+      fa = 1.0 / (a * std::log (10.0));
+      break;
+    case LOG_BX:
+      /* log_bx (b, x) = ln (x) / ln (b) */
+      result = log_bx (a, b);
+      fa = -result / (a * std::log (a));
+      fb = 1.0 / (b * std::log (a));
+      break;
+    case SIN:
+      result = std::sin (a);
+      fa = std::cos (a);
+      break;
+    case COS:
+      result = std::cos (a);
+      fa = -std::sin (a);
+      break;
+    case TAN:
+      result = std::tan (a);
+      fa = 1.0 + result * result;
+      break;
+    case ASIN:
+      result = std::asin (a);
+      fa = 1.0 / std::sqrt (1.0 - a * a);
+      break;
+    case ACOS:
+      result = std::acos (a);
+      fa = -1.0 / std::sqrt (1.0 - a * a);
+      break;
+    case ATAN:
+      result = std::atan (a);
+      fa = 1.0 / (1.0 + a * a);
+      break;
+    case ATAN2:
+      result = std::atan2 (a, b);
+      fa = b / (a * a + b * b);
+      fb = -a / (a * a + b * b);
+      break;
+    case SINH:
+      result = std::sinh (a);
+      fa = std::cosh (a);
+      break;
+    case COSH:
+      result = std::cosh (a);
+      fa = std::sinh (a);
+      break;
+    case TANH:
+      result = std::tanh (a);
+      fa = 1.0 - result * result;
+      break;
+    case FABS:
+      result = std::fabs (a);
+      fa = (a < 0.0) ? -1.0 : 1.0;
+      break;
+    case FMOD:
+      result = std::fmod (a, b);
+      fa = 1.0;
+      fb = -(a - result) / b;
+      break;
+    case SINC:
+      result = sinc (a);
+      fa = (a == 0.0) ? 0.0 : (std::cos (a) - result) / a;
+      break;
+    default:
+      assert (false);
+    }
+
+    if ((da == NULL) && (db == NULL)) {
+      return NULL;
+    }
+
+    if (tangentSize != n) {
+      delete[] tangent;
+      tangent = new double[n];
+      tangentSize = n;
+    }
+
+    if (db == NULL) {
+      for (unsigned int k = 0; k < n; ++k) {
+	tangent[k] = fa * da[k];
+      }
+    } else if (da == NULL) {
+      for (unsigned int k = 0; k < n; ++k) {
+	tangent[k] = fb * db[k];
+      }
+    } else {
+      for (unsigned int k = 0; k < n; ++k) {
+	tangent[k] = fa * da[k] + fb * db[k];
+      }
+    }
+
+    return tangent;
+  }
+} /* namespace MathEval */
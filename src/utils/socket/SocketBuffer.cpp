@@ -41,7 +41,7 @@
 #include <string>
 
 #include <cstring>
-using std::strncpy;
+using std::memcpy;
 
 using std::cout;
 using std::cerr;
@@ -279,12 +279,12 @@ streamsize SocketBuffer::xsputn
 
   streamsize availPSeq = epptr() - pptr();
   if (n <= availPSeq) {
-    strncpy (pptr(), s, n);
+    memcpy (pptr(), s, n);
     pbump (n);
     return n;
   }
 
-  strncpy (pptr(), s, availPSeq); // fill the put buffer
+  memcpy (pptr(), s, availPSeq); // fill the put buffer
   pbump (availPSeq);
   assert (pptr() == epptr());
 
@@ -343,13 +343,13 @@ streamsize SocketBuffer::xsgetn
   streamsize availGSeq = egptr() - gptr();
   assert (availGSeq >= 0);
   if (availGSeq >= n) {
-    strncpy (s, gptr(), n);
+    memcpy (s, gptr(), n);
     gbump (n);
     return n;
   }
 
   if (availGSeq > 0) {
-    strncpy (s, gptr(), availGSeq);
+    memcpy (s, gptr(), availGSeq);
 
     sPtr += availGSeq;
     rest -= availGSeq;